@@ -8,29 +8,55 @@
 #ifndef ALGORITHM_AABBTREE_H_
 #define ALGORITHM_AABBTREE_H_
 
-#include <list>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include <gkaabb.h>
 
 namespace gk {
 
+/**
+ * @brief Bounding volume hierarchy of axis-aligned bounding boxes.
+ *
+ * The nodes are stored in one array; the children of an internal node are
+ * adjacent, and a leaf refers to a range of the elements which are
+ * reordered to the leaf order. The root is the node @c 0. The tree does not
+ * traverse itself; algorithms walk the nodes with their own stack, so that
+ * each query can prune with its own bound.
+ *
+ * @tparam T Type of an element.
+ * @tparam Vector Type of a vector of the boxes.
+ *
+ * @date 2026/10/18
+ */
 template<typename T, typename Vector = typename geometry_traits<T>::vector_type>
 class aabbtree {
 public:
 	static const std::size_t ChildrenSize = 2;
+	static const std::size_t LeafSize = 4; ///< The maximum number of elements in a leaf.
 
 	typedef T value_type;
 	typedef Vector vector_type;
+	typedef aabb<Vector> box_type;
 
-	typedef std::list<T> data_container_type;
+	typedef std::vector<T> data_container_type;
+	typedef typename data_container_type::const_iterator const_iterator;
 
+	/**
+	 * @brief Node of the tree.
+	 */
 	struct node {
-		typedef typename data_container_type::iterator iterator;
-		iterator position;
-		aabb<vector_type> aabb;
+		box_type box; ///< The box enclosing all the elements under the node.
+		std::size_t first; ///< The first child in an internal node, the first element in a leaf.
+		std::size_t size; ///< The number of the elements in a leaf, zero in an internal node.
 
 		node() :
-				aabb() {
+				box(), first(), size() {
+		}
+
+		bool is_leaf() const {
+			return this->size != 0;
 		}
 	};
 
@@ -38,45 +64,253 @@ public:
 
 public:
 	aabbtree() :
-			X_() {
-	}
-
-	aabbtree(const aabbtree& other) {
+			X_(), B_(), Y_() {
 	}
 
-	aabbtree(const T& x) :
-			X_() {
+	aabbtree(const aabbtree& other) :
+			X_(other.X_), B_(other.B_), Y_(other.Y_) {
 	}
 
+	/**
+	 * @brief Constructs the tree of elements whose boxes are computed by
+	 * @c boundary(x).
+	 * @param first
+	 * @param last
+	 */
 	template<typename InputIterator>
 	aabbtree(InputIterator first, InputIterator last) :
-			X_(first, last) {
+			X_(first, last), B_(), Y_() {
+		this->B_.reserve(this->X_.size());
+		for (const_iterator p = this->X_.begin(); p != this->X_.end(); ++p) {
+			this->B_.push_back(boundary(*p));
+		}
+		this->build_();
+	}
 
+	/**
+	 * @brief Constructs the tree of elements with their boxes.
+	 * @param first The beginning of the elements.
+	 * @param last The end of the elements.
+	 * @param box_first The beginning of the boxes of the elements.
+	 */
+	template<typename InputIterator, typename BoxInputIterator>
+	aabbtree(InputIterator first, InputIterator last,
+			BoxInputIterator box_first) :
+			X_(first, last), B_(), Y_() {
+		this->B_.reserve(this->X_.size());
+		for (std::size_t i = 0; i < this->X_.size(); ++i, ++box_first) {
+			this->B_.push_back(*box_first);
+		}
+		this->build_();
 	}
 
 	~aabbtree() {
 	}
 
-	void insert(const value_type& x);
+	bool empty() const {
+		return this->X_.empty();
+	}
+
+	/**
+	 * @brief Returns the number of the elements.
+	 */
+	std::size_t size() const {
+		return this->X_.size();
+	}
+
+	/**
+	 * @brief Returns the beginning of the elements in the leaf order.
+	 */
+	const_iterator begin() const {
+		return this->X_.begin();
+	}
+
+	const_iterator end() const {
+		return this->X_.end();
+	}
+
+	/**
+	 * @brief Returns the @a n th element in the leaf order.
+	 */
+	const value_type& operator[](std::size_t n) const {
+		return this->X_[n];
+	}
+
+	/**
+	 * @brief Returns the box of the @a n th element in the leaf order.
+	 */
+	const box_type& box(std::size_t n) const {
+		return this->B_[n];
+	}
 
+	/**
+	 * @brief Returns the number of the nodes.
+	 */
+	std::size_t node_size() const {
+		return this->Y_.size();
+	}
+
+	/**
+	 * @brief Returns the @a n th node. The root is the node @c 0.
+	 */
+	const node& node_at(std::size_t n) const {
+		return this->Y_[n];
+	}
+
+	/**
+	 * @brief Inserts an element and rebuilds the tree.
+	 * @param x
+	 */
+	void insert(const value_type& x) {
+		this->insert(&x, &x + 1);
+	}
+
+	/**
+	 * @brief Inserts elements and rebuilds the tree.
+	 * @param first
+	 * @param last
+	 */
 	template<typename InputIterator>
-	void insert(InputIterator first, InputIterator last);
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first) {
+			this->X_.push_back(*first);
+			this->B_.push_back(boundary(this->X_.back()));
+		}
+		this->build_();
+	}
+
+	aabbtree& operator=(const aabbtree& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		this->B_ = rhs.B_;
+		this->Y_ = rhs.Y_;
+		return *this;
+	}
 
-// std::pair<iterator,iterator> intersect(const aabb& x) const;
 private:
-	data_container_type X_;
-	node_container_type Y_;
+	data_container_type X_; ///< The elements in the leaf order.
+	std::vector<box_type> B_; ///< The boxes of the elements.
+	node_container_type Y_; ///< The nodes.
 
 private:
-	void generate(typename data_container_type::const_iterator first,
-			typename data_container_type::const_iterator last) {
-
-		std::vector<aabb<vector_type> > boxies;
-		boxies.reserve(std::distance(first, last));
-		for (typename data_container_type::const_iterator p = first; p != last;
-				++p) {
-			boxies.push_back(make_aabb(*p));
+	/**
+	 * @brief Range of the elements under a node in the build.
+	 */
+	struct range {
+		std::size_t node;
+		std::size_t first;
+		std::size_t last;
+	};
+
+	/**
+	 * @brief Compares centroids of boxes on an axis.
+	 */
+	struct centroid_less {
+		const std::vector<box_type>& boxes;
+		const std::size_t axis;
+
+		centroid_less(const std::vector<box_type>& B, std::size_t n) :
+				boxes(B), axis(n) {
+		}
+
+		bool operator()(std::size_t a, std::size_t b) const {
+			return (this->boxes[a].min()[this->axis]
+					+ this->boxes[a].max()[this->axis])
+					< (this->boxes[b].min()[this->axis]
+							+ this->boxes[b].max()[this->axis]);
+		}
+	};
+
+	/**
+	 * @brief Builds the nodes top-down, splitting at the median of the
+	 * centroids on the longest axis.
+	 */
+	void build_() {
+		typedef typename vector_traits<Vector>::value_type value_type;
+		const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+		this->Y_.clear();
+
+		const std::size_t n = this->X_.size();
+		if (n == 0) {
+			return;
+		}
+
+		std::vector<std::size_t> index(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			index[i] = i;
+		}
+
+		this->Y_.reserve(2 * (n / LeafSize) + 1);
+		this->Y_.push_back(node());
+
+		std::vector<range> stack;
+		const range root = { 0, 0, n };
+		stack.push_back(root);
+
+		while (!stack.empty()) {
+			const range r = stack.back();
+			stack.pop_back();
+
+			box_type box = this->B_[index[r.first]];
+			Vector c_min = box.min() + box.max();
+			Vector c_max = c_min;
+			for (std::size_t i = r.first + 1; i < r.last; ++i) {
+				const box_type& b = this->B_[index[i]];
+				box = box | b;
+
+				const Vector c = b.min() + b.max();
+				for (std::size_t d = 0; d < Dimension; ++d) {
+					c_min[d] = std::min(c_min[d], c[d]);
+					c_max[d] = std::max(c_max[d], c[d]);
+				}
+			}
+			this->Y_[r.node].box = box;
+
+			if (r.last - r.first <= LeafSize) {
+				this->Y_[r.node].first = r.first;
+				this->Y_[r.node].size = r.last - r.first;
+				continue;
+			}
+
+			std::size_t axis = 0;
+			value_type extent = c_max[0] - c_min[0];
+			for (std::size_t d = 1; d < Dimension; ++d) {
+				if (c_max[d] - c_min[d] > extent) {
+					extent = c_max[d] - c_min[d];
+					axis = d;
+				}
+			}
+
+			const std::size_t middle = r.first + (r.last - r.first) / 2;
+			std::nth_element(index.begin() + r.first, index.begin() + middle,
+					index.begin() + r.last, centroid_less(this->B_, axis));
+
+			const std::size_t child = this->Y_.size();
+			this->Y_.push_back(node());
+			this->Y_.push_back(node());
+			this->Y_[r.node].first = child;
+			this->Y_[r.node].size = 0;
+
+			const range upper = { child + 1, middle, r.last };
+			const range lower = { child, r.first, middle };
+			stack.push_back(upper);
+			stack.push_back(lower);
+		}
+
+		data_container_type X;
+		std::vector<box_type> B;
+		X.reserve(n);
+		B.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			X.push_back(this->X_[index[i]]);
+			B.push_back(this->B_[index[i]]);
 		}
+		this->X_.swap(X);
+		this->B_.swap(B);
 	}
 };
 
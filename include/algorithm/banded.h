@@ -0,0 +1,265 @@
+/*
+ * banded.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_BANDED_H_
+#define ALGORITHM_BANDED_H_
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "../gkdef.h"
+
+namespace gk {
+
+/**
+ * @brief Square matrix whose non-zero elements are within a band around the
+ * diagonal.
+ *
+ * The rows are stored one after another, each of its @f$l + u + 1@f$
+ * elements from the column @f$i - l@f$ to @f$i + u@f$, so that the memory
+ * and the factorizations are linear in the size for a fixed band.
+ *
+ * @tparam T Type of an element.
+ *
+ * @date 2026/10/19
+ */
+template<typename T>
+class banded_matrix {
+public:
+	typedef T value_type;
+
+public:
+	banded_matrix() :
+			n_(0), l_(0), u_(0), A_() {
+	}
+
+	banded_matrix(const banded_matrix& other) :
+			n_(other.n_), l_(other.l_), u_(other.u_), A_(other.A_) {
+	}
+
+	/**
+	 * @brief Constructs the zero matrix of a size @a n, whose band has
+	 * @a lower sub-diagonals and @a upper super-diagonals.
+	 */
+	banded_matrix(std::size_t n, std::size_t lower, std::size_t upper) :
+			n_(n), l_(lower), u_(upper), A_(n * (lower + upper + 1),
+					value_type(GK_FLOAT_ZERO)) {
+	}
+
+	~banded_matrix() {
+	}
+
+	/**
+	 * @brief Returns the number of the rows and the columns.
+	 */
+	std::size_t size() const {
+		return this->n_;
+	}
+
+	/**
+	 * @brief Returns the number of the sub-diagonals.
+	 */
+	std::size_t lower() const {
+		return this->l_;
+	}
+
+	/**
+	 * @brief Returns the number of the super-diagonals.
+	 */
+	std::size_t upper() const {
+		return this->u_;
+	}
+
+	/**
+	 * @brief Makes the zero matrix of a size @a n, reusing the storage.
+	 */
+	void reset(std::size_t n, std::size_t lower, std::size_t upper) {
+		this->n_ = n;
+		this->l_ = lower;
+		this->u_ = upper;
+		this->A_.assign(n * (lower + upper + 1), value_type(GK_FLOAT_ZERO));
+	}
+
+	/**
+	 * @brief Returns the element at a row @a i and a column @a j, which is
+	 * within the band, @f$i - l \le j \le i + u@f$.
+	 */
+	const value_type& operator()(std::size_t i, std::size_t j) const {
+		return this->A_[i * (this->l_ + this->u_ + 1) + j + this->l_ - i];
+	}
+
+	value_type& operator()(std::size_t i, std::size_t j) {
+		return this->A_[i * (this->l_ + this->u_ + 1) + j + this->l_ - i];
+	}
+
+	void swap(banded_matrix& other) {
+		std::swap(this->n_, other.n_);
+		std::swap(this->l_, other.l_);
+		std::swap(this->u_, other.u_);
+		this->A_.swap(other.A_);
+	}
+
+	banded_matrix& operator=(const banded_matrix& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->n_ = rhs.n_;
+		this->l_ = rhs.l_;
+		this->u_ = rhs.u_;
+		this->A_ = rhs.A_;
+		return *this;
+	}
+
+private:
+	std::size_t n_;
+	std::size_t l_; ///< The number of the sub-diagonals.
+	std::size_t u_; ///< The number of the super-diagonals.
+	std::vector<value_type> A_;
+};
+
+namespace alg {
+
+/**
+ * @brief Factorizes a symmetric positive definite banded matrix @a A into
+ * @f$LL^T@f$ in place, in @f$O(nl^2)@f$.
+ *
+ * Only the lower band is read, and it is overwritten by @f$L@f$.
+ *
+ * @param A The matrix.
+ * @return false if @a A is not positive definite.
+ */
+template<typename T>
+bool cholesky(banded_matrix<T>& A) {
+	const std::size_t n = A.size();
+	const std::size_t l = A.lower();
+
+	for (std::size_t j = 0; j < n; ++j) {
+		const std::size_t k0 = (j > l) ? j - l : 0;
+
+		T s = A(j, j);
+		for (std::size_t k = k0; k < j; ++k) {
+			s -= A(j, k) * A(j, k);
+		}
+		if (!(s > T(GK_FLOAT_ZERO))) {
+			return false;
+		}
+		A(j, j) = std::sqrt(s);
+
+		const T w = T(GK_FLOAT_ONE) / A(j, j);
+		for (std::size_t i = j + 1; i <= std::min(n - 1, j + l); ++i) {
+			T x = A(i, j);
+			for (std::size_t k = (i > l) ? i - l : 0; k < j; ++k) {
+				x -= A(i, k) * A(j, k);
+			}
+			A(i, j) = x * w;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Solves @f$LL^T x = b@f$ in place with a factor made by cholesky().
+ *
+ * @param L The factor.
+ * @param b The beginning of the right-hand sides, replaced with the
+ * solutions. They are scalars or vectors.
+ */
+template<typename T, typename RandomAccessIterator>
+void cholesky_solve(const banded_matrix<T>& L, RandomAccessIterator b) {
+	const std::size_t n = L.size();
+	const std::size_t l = L.lower();
+
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t k = (i > l) ? i - l : 0; k < i; ++k) {
+			b[i] = b[i] - L(i, k) * b[k];
+		}
+		b[i] = (T(GK_FLOAT_ONE) / L(i, i)) * b[i];
+	}
+
+	for (std::size_t i = n; i-- > 0;) {
+		for (std::size_t k = i + 1; k <= std::min(n - 1, i + l); ++k) {
+			b[i] = b[i] - L(k, i) * b[k];
+		}
+		b[i] = (T(GK_FLOAT_ONE) / L(i, i)) * b[i];
+	}
+}
+
+/**
+ * @brief Factorizes a banded matrix @a A into @f$LU@f$ in place without
+ * pivoting, in @f$O(nlu)@f$.
+ *
+ * The unit lower factor @f$L@f$ without its diagonal is written in the
+ * lower band and @f$U@f$ in the others, so that the band does not grow.
+ * Collocation matrices of B-splines at parameters interlacing the knots
+ * are totally positive, which makes the elimination stable without
+ * pivoting (de Boor, A Practical Guide to Splines, XIII). Rows of
+ * derivatives break the total positivity; they are left to the caller to
+ * order so that the pivots stay nonzero.
+ *
+ * @param A The matrix.
+ * @return false if a pivot is zero.
+ */
+template<typename T>
+bool lu(banded_matrix<T>& A) {
+	const std::size_t n = A.size();
+	const std::size_t l = A.lower();
+	const std::size_t u = A.upper();
+
+	for (std::size_t k = 0; k < n; ++k) {
+		if (A(k, k) == T(GK_FLOAT_ZERO)) {
+			return false;
+		}
+
+		const T w = T(GK_FLOAT_ONE) / A(k, k);
+		const std::size_t j1 = std::min(n - 1, k + u);
+		for (std::size_t i = k + 1; i <= std::min(n - 1, k + l); ++i) {
+			const T x = A(i, k) * w;
+			A(i, k) = x;
+			for (std::size_t j = k + 1; j <= j1; ++j) {
+				A(i, j) -= x * A(k, j);
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Solves @f$LUx = b@f$ in place with factors made by lu().
+ *
+ * @param A The factors.
+ * @param b The beginning of the right-hand sides, replaced with the
+ * solutions. They are scalars or vectors.
+ */
+template<typename T, typename RandomAccessIterator>
+void lu_solve(const banded_matrix<T>& A, RandomAccessIterator b) {
+	const std::size_t n = A.size();
+	const std::size_t l = A.lower();
+	const std::size_t u = A.upper();
+
+	for (std::size_t i = 1; i < n; ++i) {
+		for (std::size_t k = (i > l) ? i - l : 0; k < i; ++k) {
+			b[i] = b[i] - A(i, k) * b[k];
+		}
+	}
+
+	for (std::size_t i = n; i-- > 0;) {
+		for (std::size_t k = i + 1; k <= std::min(n - 1, i + u); ++k) {
+			b[i] = b[i] - A(i, k) * b[k];
+		}
+		b[i] = (T(GK_FLOAT_ONE) / A(i, i)) * b[i];
+	}
+}
+
+}  // namespace alg
+
+}  // namespace gk
+
+#endif /* ALGORITHM_BANDED_H_ */
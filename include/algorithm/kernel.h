@@ -81,7 +81,7 @@ namespace alg {
  */
 template<typename Vector>
 Vector between_positions(const Vector& first, const Vector& second,
-		gkfloat ratio) {
+		float_type ratio) {
 	return first + ratio * (second - first);
 }
 
@@ -100,7 +100,7 @@ template<typename Vector>
 Vector nearest_to_line(const Vector& reference,
 		const direction<vector_traits<Vector>::Dimension>& u, const Vector& v) {
 	const Vector r = v - reference;
-	return dot(r, u) * u - r;
+	return dot(r, u) * to_vector<Vector>(u) - r;
 }
 
 /**
@@ -116,7 +116,7 @@ Vector nearest_to_plane(const Vector& reference,
 
 	const Vector r = reference - v;
 
-	return dot(r, n) * n;
+	return dot(r, n) * to_vector<Vector>(n);
 }
 
 /**
@@ -138,24 +138,23 @@ std::pair<Vector, Vector> nearest_between_lines(const Vector& reference1,
 
 	typedef typename vector_traits<Vector>::value_type length;
 
-	const gkfloat alpha = dot(direction1, direction2);
-	const gkfloat beta = GK_FLOAT_ONE - alpha * alpha;
+	const length alpha = dot(direction1, direction2);
+	const length beta = length(GK_FLOAT_ONE) - alpha * alpha;
 
 	const Vector r = reference1 - reference2;
+	const Vector u = to_vector<Vector>(direction1);
+	const Vector v = to_vector<Vector>(direction2);
 
-	if (beta == GK_FLOAT_ZERO) {
+	if (beta == length(GK_FLOAT_ZERO)) {
 		/* parallel */
-		return std::make_pair(reference1 + length(GK_FLOAT_ZERO) * direction1,
-				reference2 + dot(r, direction2) * direction2);
+		return std::make_pair(reference1, reference2 + dot(r, v) * v);
 
 	} else {
 		/* no parallel */
-		const length s = (alpha * dot(r, direction2) - dot(r, direction1))
-				/ beta;
-		const length t = dot(r, direction2) + alpha * s;
+		const length s = (alpha * dot(r, v) - dot(r, u)) / beta;
+		const length t = dot(r, v) + alpha * s;
 
-		return std::make_pair(reference1 + s * direction1,
-				reference2 + t * direction2);
+		return std::make_pair(reference1 + s * u, reference2 + t * v);
 	}
 }
 
@@ -186,9 +185,11 @@ OutputIterator intersect_2lines(const Vector& reference1,
 	const std::pair<Vector, Vector> X = nearest_between_lines(reference1,
 			direction1, reference2, direction2);
 
+	typedef typename vector_traits<Vector>::value_type value_type;
+
 	const Vector d = X.second - X.first;
 	if (dot(d, d) < epsilon * epsilon) {
-		*result = X.first + 0.5 * d;
+		*result = X.first + value_type(0.5) * d;
 		++result;
 		return result;
 	} else {
@@ -197,38 +198,64 @@ OutputIterator intersect_2lines(const Vector& reference1,
 }
 
 /**
- * @brief Computes an intersection of 2 segments.
+ * @brief Computes an intersection of 2 segments, whose directions are
+ * given.
  *
  * @param a_start
  * @param a_end
+ * @param a_direction The direction from @a a_start to @a a_end.
  * @param b_start
  * @param b_end
+ * @param b_direction The direction from @a b_start to @a b_end.
  * @param epsilon
  * @param result
  * @return
  */
 template<typename Vector, typename Tolerance, typename OutputIterator>
 OutputIterator intersect_2segments(const Vector& a_start, const Vector& a_end,
-		const Vector& b_start, const Vector& b_end, const Tolerance& epsilon,
-		OutputIterator result) {
+		const direction<vector_traits<Vector>::Dimension>& a_direction,
+		const Vector& b_start, const Vector& b_end,
+		const direction<vector_traits<Vector>::Dimension>& b_direction,
+		const Tolerance& epsilon, OutputIterator result) {
 
-	std::vector<Vector> X;
-	intersect_2lines(a_start, normalize(a_end - a_start), b_start,
-			normalize(b_end - b_start), epsilon, std::inserter(X, X.begin()));
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
 
-	if (X.empty()) {
+	const std::pair<Vector, Vector> X = nearest_between_lines(a_start,
+			a_direction, b_start, b_direction);
+	const Vector d = X.second - X.first;
+	if (!(dot(d, d) < epsilon * epsilon)) {
 		return result;
 	}
 
-	if (std::signbit(
-			dot(X.front() - a_start, X.front() - a_end)
-					* dot(X.front() - b_start, X.front() - b_end))) {
-		*result = X.front();
+	// The intersection is between the edges of both segments.
+	const Vector x = X.first + value_type(0.5) * d;
+	if (!(dot(x - a_start, x - a_end) > Zero)
+			&& !(dot(x - b_start, x - b_end) > Zero)) {
+		*result = x;
 		++result;
-		return result;
-	} else {
-		return result;
 	}
+
+	return result;
+}
+
+/**
+ * @brief Computes an intersection of 2 segments.
+ *
+ * @param a_start
+ * @param a_end
+ * @param b_start
+ * @param b_end
+ * @param epsilon
+ * @param result
+ * @return
+ */
+template<typename Vector, typename Tolerance, typename OutputIterator>
+OutputIterator intersect_2segments(const Vector& a_start, const Vector& a_end,
+		const Vector& b_start, const Vector& b_end, const Tolerance& epsilon,
+		OutputIterator result) {
+	return intersect_2segments(a_start, a_end, normalize(a_end - a_start),
+			b_start, b_end, normalize(b_end - b_start), epsilon, result);
 }
 
 /**
@@ -251,7 +278,7 @@ OutputIterator intersect_2planes(const Vector& reference1,
 
 	const size_t Dimension = vector_traits<Vector>::Dimension;
 
-	if (std::fabs(dot(normal1, normal2)) == gkfloat(GK_FLOAT_ONE)) {
+	if (std::fabs(dot(normal1, normal2)) == float_type(GK_FLOAT_ONE)) {
 		return result;
 	}
 
@@ -268,6 +295,45 @@ OutputIterator intersect_2planes(const Vector& reference1,
 	return result;
 }
 
+/**
+ * @brief Computes an intersection of a line and a segment, whose direction
+ * and length are given.
+ * @param reference
+ * @param u
+ * @param segment_start
+ * @param v The direction of the segment.
+ * @param L The length of the segment.
+ * @param epsilon
+ * @param result
+ * @return
+ */
+template<typename Vector, size_t Dimension, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect_line_segment(const Vector& reference,
+		const direction<Dimension>& u, const Vector& segment_start,
+		const direction<Dimension>& v,
+		const typename vector_traits<Vector>::value_type& L,
+		const Tolerance& epsilon, OutputIterator result) {
+
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::pair<Vector, Vector> X = nearest_between_lines(reference, u,
+			segment_start, v);
+	const Vector d = X.second - X.first;
+	if (!(dot(d, d) < epsilon * epsilon)) {
+		return result;
+	}
+
+	// The nearest position on the segment is at t from its start.
+	const value_type t = dot(X.second - segment_start, v);
+	if (-epsilon < t && t < L + epsilon) {
+		*result = X.first + value_type(0.5) * d;
+		++result;
+	}
+
+	return result;
+}
+
 /**
  * @brief Computes an intersection of a line and a segment.
  * @param reference
@@ -287,29 +353,8 @@ OutputIterator intersect_line_segment(const Vector& reference,
 
 	const Vector r = segment_end - segment_start;
 	const direction<Dimension> v = normalize(r);
-	OutputIterator last = intersect_2lines(reference, u, segment_start, v,
+	return intersect_line_segment(reference, u, segment_start, v, dot(r, v),
 			epsilon, result);
-
-	const size_t NoIntersection = 0;
-	const size_t OneIntersection = 1;
-	switch (std::distance(result, last)) {
-	case NoIntersection:
-		return result;
-
-	case OneIntersection:
-		typedef typename vector_traits<Vector>::value_type value_type;
-		const value_type t = dot(*result - segment_start, v);
-		const value_type L = dot(r, v);
-
-		if (-epsilon < t && t < L + epsilon) {
-			return last;
-		} else {
-			return result;
-		}
-
-	default:
-		return result;
-	}
 }
 
 /**
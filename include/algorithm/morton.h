@@ -0,0 +1,96 @@
+/*
+ * morton.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_MORTON_H_
+#define ALGORITHM_MORTON_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../gkaabb.h"
+#include "radix_sort.h"
+
+namespace gk {
+
+/**
+ * @brief Computes the Morton code of a position @a v in a box, interleaving
+ * the bits of its components quantized on the box.
+ *
+ * @param box The box, not empty.
+ * @param v
+ * @return The code of @f$\lfloor 64 / Dimension \rfloor@f$ bits on each
+ * axis, the bit @a b of the axis @a d at the bit @f$b \cdot Dimension + d@f$.
+ */
+template<typename Vector>
+uint64_t morton_code(const aabb<Vector>& box, const Vector& v) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const std::size_t Dimension = vector_traits<Vector>::Dimension;
+	const std::size_t Bits = 64 / Dimension;
+	const uint64_t Mask = (Bits < 64) ? (uint64_t(1) << Bits) - 1 : ~uint64_t(0);
+	const value_type Scale = value_type(Mask);
+
+	uint64_t q[Dimension];
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		const value_type w = box.max()[d] - box.min()[d];
+		const value_type x =
+				(w > value_type(GK_FLOAT_ZERO)) ?
+						(v[d] - box.min()[d]) / w : value_type(GK_FLOAT_ZERO);
+		// The scale rounds up to a power of 2 in float, so the quantized
+		// value is clamped in the integer not to wrap to zero.
+		const value_type y = std::min(std::max(x, value_type(GK_FLOAT_ZERO)),
+				value_type(GK_FLOAT_ONE)) * Scale;
+		q[d] = (y < Scale) ? uint64_t(y) : Mask;
+	}
+
+	uint64_t code = 0;
+	for (std::size_t b = 0; b < Bits; ++b) {
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			code |= ((q[d] >> b) & 1) << (b * Dimension + d);
+		}
+	}
+	return code;
+}
+
+/**
+ * @brief Orders positions along the Morton curve of their box, which keeps
+ * near positions adjacent for coherent traversals.
+ *
+ * @param first The beginning of the positions, not empty.
+ * @param last The end of the positions.
+ * @param order The indices of the positions in the order of the curve.
+ */
+template<typename InputRandomAccessIterator, typename Index>
+void morton_order(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, std::vector<Index>& order) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+	const std::size_t Dimension = vector_traits<vector_type>::Dimension;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	order.resize(n);
+	if (n == 0) {
+		return;
+	}
+
+	const aabb<vector_type> box(first, last);
+	std::vector<uint64_t> K(n);
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (n >= impl::radix_sort_kernel::ParallelSize)
+#endif
+	for (std::ptrdiff_t i = 0; i < n; ++i) {
+		K[i] = morton_code(box, vector_type(first[i]));
+		order[i] = Index(i);
+	}
+
+	radix_sort(K, order, 64 / Dimension * Dimension);
+}
+
+} // namespace gk
+
+#endif /* ALGORITHM_MORTON_H_ */
@@ -0,0 +1,126 @@
+/*
+ * radix_sort.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_RADIX_SORT_H_
+#define ALGORITHM_RADIX_SORT_H_
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+#include "../gkdef.h"
+
+#ifdef GK_OPENMP
+#include <omp.h>
+#endif
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Parameters of the radix sort.
+ *
+ * @date 2026/10/18
+ */
+struct radix_sort_kernel {
+	static const std::size_t DigitBits = 8; ///< The number of the bits sorted in a pass.
+	static const std::size_t BucketSize = 1 << DigitBits;
+	static const std::ptrdiff_t ParallelSize = 1 << 16; ///< The minimum number of keys to sort in parallel.
+};
+
+} // namespace impl
+
+/**
+ * @brief Sorts unsigned integer keys together with their values by the
+ * least significant digit radix sort.
+ *
+ * The sort is stable and runs in O(n) for a fixed width of the keys; one
+ * pass for each 8 bits of @a bits. Large ranges are split in chunks across
+ * threads with OpenMP; each chunk counts its digits and scatters its keys
+ * to the offsets of its own, so that the result does not depend on the
+ * number of the threads.
+ *
+ * @param keys The keys, each less than @f$2^{bits}@f$.
+ * @param values The values of the keys, as many as @a keys.
+ * @param bits The number of the significant bits of the keys.
+ */
+template<typename Key, typename Value>
+void radix_sort(std::vector<Key>& keys, std::vector<Value>& values,
+		std::size_t bits = sizeof(Key) * CHAR_BIT) {
+	typedef impl::radix_sort_kernel kernel_type;
+	const std::size_t B = kernel_type::BucketSize;
+	const Key Mask = Key(B - 1);
+
+	const std::ptrdiff_t n = keys.size();
+	if (n < 2) {
+		return;
+	}
+
+#ifdef GK_OPENMP
+	const std::ptrdiff_t m =
+			(n >= kernel_type::ParallelSize) ? omp_get_max_threads() : 1;
+#else
+	const std::ptrdiff_t m = 1;
+#endif
+
+	std::vector<Key> K(n);
+	std::vector<Value> V(n);
+	std::vector<std::size_t> H(m * B);
+
+	for (std::size_t shift = 0; shift < bits; shift += kernel_type::DigitBits) {
+		std::fill(H.begin(), H.end(), 0);
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) num_threads(m) if (m > 1)
+#endif
+		for (std::ptrdiff_t t = 0; t < m; ++t) {
+			std::size_t* const h = &H[t * B];
+			const std::ptrdiff_t last = n * (t + 1) / m;
+			for (std::ptrdiff_t i = n * t / m; i < last; ++i) {
+				++h[(keys[i] >> shift) & Mask];
+			}
+		}
+
+		// The offsets in the order of the digits, then of the chunks.
+		std::size_t offset = 0;
+		bool sorted = false;
+		for (std::size_t b = 0; b < B; ++b) {
+			const std::size_t first = offset;
+			for (std::ptrdiff_t t = 0; t < m; ++t) {
+				const std::size_t c = H[t * B + b];
+				H[t * B + b] = offset;
+				offset += c;
+			}
+			sorted = sorted || (offset - first == std::size_t(n));
+		}
+		if (sorted) {
+			// All the keys have the same digit.
+			continue;
+		}
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) num_threads(m) if (m > 1)
+#endif
+		for (std::ptrdiff_t t = 0; t < m; ++t) {
+			std::size_t* const h = &H[t * B];
+			const std::ptrdiff_t last = n * (t + 1) / m;
+			for (std::ptrdiff_t i = n * t / m; i < last; ++i) {
+				const std::size_t j = h[(keys[i] >> shift) & Mask]++;
+				K[j] = keys[i];
+				V[j] = values[i];
+			}
+		}
+
+		keys.swap(K);
+		values.swap(V);
+	}
+}
+
+} // namespace gk
+
+#endif /* ALGORITHM_RADIX_SORT_H_ */
@@ -0,0 +1,584 @@
+/*
+ * ray_triangle.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_RAY_TRIANGLE_H_
+#define ALGORITHM_RAY_TRIANGLE_H_
+
+#include <cmath>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../primitive/triangle.h"
+
+namespace gk {
+
+/**
+ * @brief Intersection of a ray and a triangle.
+ *
+ * The intersection is @f$\mathbf{x}_0 + s\mathbf{u} + t\mathbf{v}@f$ on a
+ * triangle, as triangle::operator()(s, t), and
+ * @f$\mathbf{o} + r\mathbf{d}@f$ on a ray.
+ *
+ * @tparam T Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename T>
+struct triangle_hit {
+	T ray; ///< Parameter on the ray, the distance for a unit direction.
+	T s; ///< Barycentric coordinate of the second vertex.
+	T t; ///< Barycentric coordinate of the third vertex.
+
+	triangle_hit() :
+			ray(), s(), t() {
+	}
+};
+
+/**
+ * @brief Ray @f$\mathbf{o} + r\mathbf{d}@f$ prepared for the watertight
+ * intersection with triangles.
+ *
+ * The space is permuted so that the largest component of the direction is
+ * the z-axis, and sheared so that the direction is the z-axis itself. The
+ * edge functions of a triangle are then computed in 2D on the projected
+ * vertices, which gives the same sign to an edge from both of the triangles
+ * sharing it; a ray through an edge or a vertex hits at least one of the
+ * triangles around it.
+ *
+ * @tparam Vector Type of a vector in 3D.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+struct watertight_ray {
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	Vector origin;
+	std::size_t kx; ///< The axis projected to the x-axis.
+	std::size_t ky; ///< The axis projected to the y-axis.
+	std::size_t kz; ///< The axis of the largest component of the direction.
+	value_type sx; ///< The shear of the x-axis.
+	value_type sy; ///< The shear of the y-axis.
+	value_type sz; ///< The scale of the z-axis.
+
+	watertight_ray() :
+			origin(), kx(), ky(), kz(), sx(), sy(), sz() {
+	}
+
+	watertight_ray(const Vector& o, const Vector& d) :
+			origin(o), kx(), ky(), kz(), sx(), sy(), sz() {
+		this->kz = GK::X;
+		if (std::abs(d[GK::Y]) > std::abs(d[this->kz])) {
+			this->kz = GK::Y;
+		}
+		if (std::abs(d[GK::Z]) > std::abs(d[this->kz])) {
+			this->kz = GK::Z;
+		}
+		this->kx = (this->kz + 1) % GK::GK_3D;
+		this->ky = (this->kx + 1) % GK::GK_3D;
+
+		// Keeps the winding of the triangles.
+		if (d[this->kz] < value_type(GK_FLOAT_ZERO)) {
+			std::swap(this->kx, this->ky);
+		}
+
+		this->sx = d[this->kx] / d[this->kz];
+		this->sy = d[this->ky] / d[this->kz];
+		this->sz = value_type(GK_FLOAT_ONE) / d[this->kz];
+	}
+};
+
+/**
+ * @brief Packet of triangles in the structure of arrays, the leaf of a ray
+ * query.
+ *
+ * A lane of each component holds @a Width triangles. The lanes not set are
+ * degenerate, and no ray hits them.
+ *
+ * @tparam T Type of a component.
+ * @tparam Width The number of the triangles, 4 or 8 to fill a SIMD
+ * register of float.
+ *
+ * @date 2026/10/19
+ */
+template<typename T, std::size_t Width>
+struct triangle_packet {
+	static const std::size_t Size = Width;
+
+	typedef T value_type;
+
+	T x[GK::GK_3D][Width]; ///< The first vertices.
+	T u[GK::GK_3D][Width]; ///< The edges from the first to the second vertices.
+	T v[GK::GK_3D][Width]; ///< The edges from the first to the third vertices.
+
+	triangle_packet() {
+		this->clear();
+	}
+
+	/**
+	 * @brief Makes all the lanes degenerate.
+	 */
+	void clear() {
+		for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+			std::fill(this->x[d], this->x[d] + Width, T(GK_FLOAT_ZERO));
+			std::fill(this->u[d], this->u[d] + Width, T(GK_FLOAT_ZERO));
+			std::fill(this->v[d], this->v[d] + Width, T(GK_FLOAT_ZERO));
+		}
+	}
+
+	/**
+	 * @brief Sets the triangle of vertices @a first, @a second and @a third
+	 * to a lane @a n.
+	 */
+	template<typename Vector>
+	void set(std::size_t n, const Vector& first, const Vector& second,
+			const Vector& third) {
+		for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+			this->x[d][n] = T(first[d]);
+			this->u[d][n] = T(second[d] - first[d]);
+			this->v[d][n] = T(third[d] - first[d]);
+		}
+	}
+
+	template<typename Vector>
+	void set(std::size_t n, const triangle<Vector>& a) {
+		this->set(n, a[triangle<Vector>::First], a[triangle<Vector>::Second],
+				a[triangle<Vector>::Third]);
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Möller–Trumbore intersection of a ray and the triangles of a
+ * packet.
+ *
+ * Every lane runs the same operations without a branch, and the comparisons
+ * make a mask; a lane of a zero determinant, a ray parallel to the triangle
+ * or a degenerate triangle, is rejected. The packets of 4 and 8 float run
+ * on SSE and AVX registers; the others on loops which the compiler may
+ * vectorize.
+ *
+ * @date 2026/10/19
+ */
+template<typename T, std::size_t Width>
+struct triangle_packet_kernel {
+	typedef triangle_packet<T, Width> packet_type;
+
+	/**
+	 * @return The mask of the lanes hit, the bit @a i for the lane @a i.
+	 */
+	static unsigned intersect(const packet_type& X, const T* o, const T* d,
+			T r_min, T r_max, T* r, T* s, T* t) {
+		const T Zero = T(GK_FLOAT_ZERO);
+		const T One = T(GK_FLOAT_ONE);
+
+		unsigned hit[Width];
+		for (std::size_t i = 0; i < Width; ++i) {
+			const T px = d[GK::Y] * X.v[GK::Z][i] - d[GK::Z] * X.v[GK::Y][i];
+			const T py = d[GK::Z] * X.v[GK::X][i] - d[GK::X] * X.v[GK::Z][i];
+			const T pz = d[GK::X] * X.v[GK::Y][i] - d[GK::Y] * X.v[GK::X][i];
+			const T det = X.u[GK::X][i] * px + X.u[GK::Y][i] * py
+					+ X.u[GK::Z][i] * pz;
+
+			const T wx = o[GK::X] - X.x[GK::X][i];
+			const T wy = o[GK::Y] - X.x[GK::Y][i];
+			const T wz = o[GK::Z] - X.x[GK::Z][i];
+			const T qx = wy * X.u[GK::Z][i] - wz * X.u[GK::Y][i];
+			const T qy = wz * X.u[GK::X][i] - wx * X.u[GK::Z][i];
+			const T qz = wx * X.u[GK::Y][i] - wy * X.u[GK::X][i];
+
+			const T f = One / det;
+			s[i] = (wx * px + wy * py + wz * pz) * f;
+			t[i] = (d[GK::X] * qx + d[GK::Y] * qy + d[GK::Z] * qz) * f;
+			r[i] = (X.v[GK::X][i] * qx + X.v[GK::Y][i] * qy
+					+ X.v[GK::Z][i] * qz) * f;
+
+			hit[i] = (det != Zero) & (s[i] >= Zero) & (t[i] >= Zero)
+					& (s[i] + t[i] <= One) & (r[i] >= r_min) & (r[i] <= r_max);
+		}
+
+		unsigned mask = 0;
+		for (std::size_t i = 0; i < Width; ++i) {
+			mask |= hit[i] << i;
+		}
+		return mask;
+	}
+};
+
+#if defined(GK_SSE2)
+
+template<>
+struct triangle_packet_kernel<float, 4> {
+	typedef triangle_packet<float, 4> packet_type;
+
+	static unsigned intersect(const packet_type& X, const float* o,
+			const float* d, float r_min, float r_max, float* r, float* s,
+			float* t) {
+		const __m128 dx = _mm_set1_ps(d[GK::X]);
+		const __m128 dy = _mm_set1_ps(d[GK::Y]);
+		const __m128 dz = _mm_set1_ps(d[GK::Z]);
+		const __m128 ux = _mm_loadu_ps(X.u[GK::X]);
+		const __m128 uy = _mm_loadu_ps(X.u[GK::Y]);
+		const __m128 uz = _mm_loadu_ps(X.u[GK::Z]);
+		const __m128 vx = _mm_loadu_ps(X.v[GK::X]);
+		const __m128 vy = _mm_loadu_ps(X.v[GK::Y]);
+		const __m128 vz = _mm_loadu_ps(X.v[GK::Z]);
+
+		const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, vz), _mm_mul_ps(dz, vy));
+		const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, vx), _mm_mul_ps(dx, vz));
+		const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, vy), _mm_mul_ps(dy, vx));
+		const __m128 det = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(ux, px), _mm_mul_ps(uy, py)),
+				_mm_mul_ps(uz, pz));
+
+		const __m128 wx = _mm_sub_ps(_mm_set1_ps(o[GK::X]),
+				_mm_loadu_ps(X.x[GK::X]));
+		const __m128 wy = _mm_sub_ps(_mm_set1_ps(o[GK::Y]),
+				_mm_loadu_ps(X.x[GK::Y]));
+		const __m128 wz = _mm_sub_ps(_mm_set1_ps(o[GK::Z]),
+				_mm_loadu_ps(X.x[GK::Z]));
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(wy, uz), _mm_mul_ps(wz, uy));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(wz, ux), _mm_mul_ps(wx, uz));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(wx, uy), _mm_mul_ps(wy, ux));
+
+		const __m128 f = _mm_div_ps(_mm_set1_ps(1.0f), det);
+		const __m128 ss = _mm_mul_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(wx, px), _mm_mul_ps(wy, py)),
+						_mm_mul_ps(wz, pz)), f);
+		const __m128 tt = _mm_mul_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)),
+						_mm_mul_ps(dz, qz)), f);
+		const __m128 rr = _mm_mul_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, qx), _mm_mul_ps(vy, qy)),
+						_mm_mul_ps(vz, qz)), f);
+		_mm_storeu_ps(s, ss);
+		_mm_storeu_ps(t, tt);
+		_mm_storeu_ps(r, rr);
+
+		const __m128 zero = _mm_setzero_ps();
+		__m128 hit = _mm_cmpneq_ps(det, zero);
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(ss, zero));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(tt, zero));
+		hit = _mm_and_ps(hit,
+				_mm_cmple_ps(_mm_add_ps(ss, tt), _mm_set1_ps(1.0f)));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(rr, _mm_set1_ps(r_min)));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(rr, _mm_set1_ps(r_max)));
+		return unsigned(_mm_movemask_ps(hit));
+	}
+};
+
+#endif
+
+#if defined(GK_AVX)
+
+template<>
+struct triangle_packet_kernel<float, 8> {
+	typedef triangle_packet<float, 8> packet_type;
+
+	static unsigned intersect(const packet_type& X, const float* o,
+			const float* d, float r_min, float r_max, float* r, float* s,
+			float* t) {
+		const __m256 dx = _mm256_set1_ps(d[GK::X]);
+		const __m256 dy = _mm256_set1_ps(d[GK::Y]);
+		const __m256 dz = _mm256_set1_ps(d[GK::Z]);
+		const __m256 ux = _mm256_loadu_ps(X.u[GK::X]);
+		const __m256 uy = _mm256_loadu_ps(X.u[GK::Y]);
+		const __m256 uz = _mm256_loadu_ps(X.u[GK::Z]);
+		const __m256 vx = _mm256_loadu_ps(X.v[GK::X]);
+		const __m256 vy = _mm256_loadu_ps(X.v[GK::Y]);
+		const __m256 vz = _mm256_loadu_ps(X.v[GK::Z]);
+
+		const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, vz),
+				_mm256_mul_ps(dz, vy));
+		const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, vx),
+				_mm256_mul_ps(dx, vz));
+		const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, vy),
+				_mm256_mul_ps(dy, vx));
+		const __m256 det = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(ux, px), _mm256_mul_ps(uy, py)),
+				_mm256_mul_ps(uz, pz));
+
+		const __m256 wx = _mm256_sub_ps(_mm256_set1_ps(o[GK::X]),
+				_mm256_loadu_ps(X.x[GK::X]));
+		const __m256 wy = _mm256_sub_ps(_mm256_set1_ps(o[GK::Y]),
+				_mm256_loadu_ps(X.x[GK::Y]));
+		const __m256 wz = _mm256_sub_ps(_mm256_set1_ps(o[GK::Z]),
+				_mm256_loadu_ps(X.x[GK::Z]));
+		const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(wy, uz),
+				_mm256_mul_ps(wz, uy));
+		const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(wz, ux),
+				_mm256_mul_ps(wx, uz));
+		const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(wx, uy),
+				_mm256_mul_ps(wy, ux));
+
+		const __m256 f = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+		const __m256 ss = _mm256_mul_ps(
+				_mm256_add_ps(
+						_mm256_add_ps(_mm256_mul_ps(wx, px),
+								_mm256_mul_ps(wy, py)), _mm256_mul_ps(wz, pz)),
+				f);
+		const __m256 tt = _mm256_mul_ps(
+				_mm256_add_ps(
+						_mm256_add_ps(_mm256_mul_ps(dx, qx),
+								_mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)),
+				f);
+		const __m256 rr = _mm256_mul_ps(
+				_mm256_add_ps(
+						_mm256_add_ps(_mm256_mul_ps(vx, qx),
+								_mm256_mul_ps(vy, qy)), _mm256_mul_ps(vz, qz)),
+				f);
+		_mm256_storeu_ps(s, ss);
+		_mm256_storeu_ps(t, tt);
+		_mm256_storeu_ps(r, rr);
+
+		const __m256 zero = _mm256_setzero_ps();
+		__m256 hit = _mm256_cmp_ps(det, zero, _CMP_NEQ_UQ);
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(ss, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(tt, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit,
+				_mm256_cmp_ps(_mm256_add_ps(ss, tt), _mm256_set1_ps(1.0f),
+						_CMP_LE_OQ));
+		hit = _mm256_and_ps(hit,
+				_mm256_cmp_ps(rr, _mm256_set1_ps(r_min), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit,
+				_mm256_cmp_ps(rr, _mm256_set1_ps(r_max), _CMP_LE_OQ));
+		return unsigned(_mm256_movemask_ps(hit));
+	}
+};
+
+#endif
+
+}  // namespace impl
+
+namespace alg {
+
+/**
+ * @brief Intersects a ray @f$\mathbf{o} + r\mathbf{d}@f$,
+ * @f$r_{min} \le r \le r_{max}@f$, and a triangle in 3D by the
+ * Möller–Trumbore algorithm.
+ *
+ * Both sides of the triangle are hit. A ray through an edge shared by two
+ * triangles may miss both by rounding; use the watertight_ray overload to
+ * classify the inside and the outside of a closed mesh.
+ *
+ * @param origin The origin @f$\mathbf{o}@f$.
+ * @param direction The direction @f$\mathbf{d}@f$, not necessarily a unit
+ * vector.
+ * @param first
+ * @param second
+ * @param third
+ * @param r_min
+ * @param r_max
+ * @param hit The intersection, set if the ray hits the triangle.
+ * @return true if the ray hits the triangle.
+ */
+template<typename Vector>
+bool intersect_ray_triangle(const Vector& origin, const Vector& direction,
+		const Vector& first, const Vector& second, const Vector& third,
+		typename vector_traits<Vector>::value_type r_min,
+		typename vector_traits<Vector>::value_type r_max,
+		triangle_hit<typename vector_traits<Vector>::value_type>& hit) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+	const value_type One = value_type(GK_FLOAT_ONE);
+
+	const Vector u = second - first;
+	const Vector v = third - first;
+	const Vector p = cross<Vector>()(direction, v);
+	const value_type det = dot(u, p);
+	if (det == Zero) {
+		return false;
+	}
+
+	const value_type f = One / det;
+	const Vector w = origin - first;
+	const value_type s = dot(w, p) * f;
+	if (s < Zero || s > One) {
+		return false;
+	}
+
+	const Vector q = cross<Vector>()(w, u);
+	const value_type t = dot(direction, q) * f;
+	if (t < Zero || s + t > One) {
+		return false;
+	}
+
+	const value_type r = dot(v, q) * f;
+	if (r < r_min || r > r_max) {
+		return false;
+	}
+
+	hit.ray = r;
+	hit.s = s;
+	hit.t = t;
+	return true;
+}
+
+/**
+ * @brief Intersects a ray and a triangle in 3D by the watertight algorithm
+ * of Woop, Benthin and Wald.
+ *
+ * An edge function of zero in float is recomputed in double, so that the
+ * signs of the edges shared by triangles agree.
+ *
+ * @param x The ray.
+ * @param first
+ * @param second
+ * @param third
+ * @param r_min
+ * @param r_max
+ * @param hit The intersection, set if the ray hits the triangle.
+ * @return true if the ray hits the triangle.
+ *
+ * @see watertight_ray
+ */
+template<typename Vector>
+bool intersect_ray_triangle(const watertight_ray<Vector>& x,
+		const Vector& first, const Vector& second, const Vector& third,
+		typename vector_traits<Vector>::value_type r_min,
+		typename vector_traits<Vector>::value_type r_max,
+		triangle_hit<typename vector_traits<Vector>::value_type>& hit) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename refinement_traits<value_type>::value_type real_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	const Vector A = first - x.origin;
+	const Vector B = second - x.origin;
+	const Vector C = third - x.origin;
+
+	const value_type ax = A[x.kx] - x.sx * A[x.kz];
+	const value_type ay = A[x.ky] - x.sy * A[x.kz];
+	const value_type bx = B[x.kx] - x.sx * B[x.kz];
+	const value_type by = B[x.ky] - x.sy * B[x.kz];
+	const value_type cx = C[x.kx] - x.sx * C[x.kz];
+	const value_type cy = C[x.ky] - x.sy * C[x.kz];
+
+	value_type U = cx * by - cy * bx;
+	value_type V = ax * cy - ay * cx;
+	value_type W = bx * ay - by * ax;
+	if (U == Zero || V == Zero || W == Zero) {
+		U = value_type(real_type(cx) * real_type(by) - real_type(cy) * real_type(bx));
+		V = value_type(real_type(ax) * real_type(cy) - real_type(ay) * real_type(cx));
+		W = value_type(real_type(bx) * real_type(ay) - real_type(by) * real_type(ax));
+	}
+
+	if ((U < Zero || V < Zero || W < Zero)
+			&& (U > Zero || V > Zero || W > Zero)) {
+		return false;
+	}
+
+	const value_type det = U + V + W;
+	if (det == Zero) {
+		return false;
+	}
+
+	const value_type f = value_type(GK_FLOAT_ONE) / det;
+	const value_type r = (U * A[x.kz] + V * B[x.kz] + W * C[x.kz]) * x.sz * f;
+	if (r < r_min || r > r_max) {
+		return false;
+	}
+
+	hit.ray = r;
+	hit.s = V * f;
+	hit.t = W * f;
+	return true;
+}
+
+/**
+ * @brief Intersects a ray @f$\mathbf{o} + r\mathbf{d}@f$,
+ * @f$r_{min} \le r \le r_{max}@f$, and the triangles of a packet at once by
+ * the Möller–Trumbore algorithm.
+ *
+ * @param X
+ * @param origin
+ * @param direction
+ * @param r_min
+ * @param r_max
+ * @param r The parameters on the ray of the lanes, @a Width values.
+ * @param s The barycentric coordinates of the second vertices.
+ * @param t The barycentric coordinates of the third vertices.
+ * @return The mask of the lanes hit, the bit @a i for the lane @a i; the
+ * values of the other lanes are undefined.
+ */
+template<typename Vector, typename T, std::size_t Width>
+unsigned intersect_ray_triangles(const Vector& origin, const Vector& direction,
+		const triangle_packet<T, Width>& X, T r_min, T r_max, T* r, T* s,
+		T* t) {
+	const T o[] = { T(origin[GK::X]), T(origin[GK::Y]), T(origin[GK::Z]) };
+	const T d[] = { T(direction[GK::X]), T(direction[GK::Y]), T(
+			direction[GK::Z]) };
+	return impl::triangle_packet_kernel<T, Width>::intersect(X, o, d, r_min,
+			r_max, r, s, t);
+}
+
+}  // namespace alg
+
+/**
+ * @brief Computes the intersection of a ray @f$\mathbf{o} + r\mathbf{d}@f$,
+ * @f$r_{min} \le r \le r_{max}@f$, and a triangle in 3D.
+ *
+ * @param a
+ * @param origin
+ * @param direction
+ * @param r_min
+ * @param r_max
+ * @param result The beginning of the intersection, triangle_hit.
+ * @return The end of the intersection.
+ *
+ * @see alg::intersect_ray_triangle()
+ */
+template<typename Vector, typename OutputIterator>
+OutputIterator intersect(const triangle<Vector>& a, const Vector& origin,
+		const Vector& direction,
+		const typename vector_traits<Vector>::value_type& r_min,
+		const typename vector_traits<Vector>::value_type& r_max,
+		OutputIterator result) {
+	typedef triangle<Vector> triangle_type;
+
+	triangle_hit<typename vector_traits<Vector>::value_type> hit;
+	if (alg::intersect_ray_triangle(origin, direction, a[triangle_type::First],
+			a[triangle_type::Second], a[triangle_type::Third], r_min, r_max,
+			hit)) {
+		*result = hit;
+		++result;
+	}
+	return result;
+}
+
+/**
+ * @brief Computes the intersection of a watertight ray and a triangle in 3D.
+ *
+ * @param x
+ * @param a
+ * @param r_min
+ * @param r_max
+ * @param result The beginning of the intersection, triangle_hit.
+ * @return The end of the intersection.
+ */
+template<typename Vector, typename OutputIterator>
+OutputIterator intersect(const watertight_ray<Vector>& x,
+		const triangle<Vector>& a,
+		const typename vector_traits<Vector>::value_type& r_min,
+		const typename vector_traits<Vector>::value_type& r_max,
+		OutputIterator result) {
+	typedef triangle<Vector> triangle_type;
+
+	triangle_hit<typename vector_traits<Vector>::value_type> hit;
+	if (alg::intersect_ray_triangle(x, a[triangle_type::First],
+			a[triangle_type::Second], a[triangle_type::Third], r_min, r_max,
+			hit)) {
+		*result = hit;
+		++result;
+	}
+	return result;
+}
+
+}  // namespace gk
+
+#endif /* ALGORITHM_RAY_TRIANGLE_H_ */
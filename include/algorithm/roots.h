@@ -0,0 +1,428 @@
+/*
+ * roots.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_ROOTS_H_
+#define ALGORITHM_ROOTS_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+
+#include "../gkdef.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Finds the roots of scalar B-splines and Bézier polynomials.
+ *
+ * A B-spline is decomposed into Bézier segments (The NURBS Book, A5.6).
+ * The number of the sign changes of the Bernstein coefficients of a segment
+ * bounds the number of its roots (Descartes' rule of signs), so a segment
+ * without a change has no root, and one with a single change has exactly
+ * one, which is refined by the Illinois method with Newton steps kept in
+ * the bracket. The others are split at the middle by de Casteljau's
+ * algorithm until their roots are isolated, or until they are narrower than
+ * the tolerance, where a multiple root is reported once at the middle. The
+ * intervals are kept on a stack, and the roots are written in increasing
+ * order. An instance keeps its buffers, so it is made once for each thread.
+ *
+ * @tparam T Type of a parameter and a coefficient.
+ *
+ * @date 2026/10/19
+ */
+template<typename T>
+class roots_kernel {
+public:
+	typedef T value_type;
+
+public:
+	roots_kernel() :
+			B_(), R_(), alpha_(), C_(), I_(), W_() {
+	}
+
+	~roots_kernel() {
+	}
+
+	/**
+	 * @brief Writes the roots of a scalar B-spline to @a result.
+	 *
+	 * @param p Degree, at least 1.
+	 * @param U_first The beginning of the clamped knot vector.
+	 * @param U_last The end of the knot vector.
+	 * @param C The beginning of the coefficients.
+	 * @param tolerance The width of the parameter intervals where the roots
+	 * are not separated any more.
+	 * @param result The beginning of the roots.
+	 * @return The end of the roots.
+	 */
+	template<typename KnotRandomAccessIterator,
+			typename InputRandomAccessIterator, typename OutputIterator>
+	OutputIterator operator()(std::size_t p, KnotRandomAccessIterator U_first,
+			KnotRandomAccessIterator U_last, InputRandomAccessIterator C,
+			const value_type& tolerance, OutputIterator result) {
+		const value_type One(GK_FLOAT_ONE);
+		const std::size_t m = std::distance(U_first, U_last) - 1;
+		if (p == 0 || m < 2 * p + 1) {
+			return result;
+		}
+
+		KnotRandomAccessIterator U = U_first;
+		this->B_.resize(p + 1);
+		this->R_.resize(p + 1);
+		this->alpha_.resize(p);
+
+		std::size_t a = p;
+		std::size_t b = p + 1;
+		for (std::size_t i = 0; i <= p; ++i) {
+			this->B_[i] = C[i];
+		}
+
+		while (b < m) {
+			const std::size_t i0 = b;
+			while (b < m && U[b + 1] == U[b]) {
+				++b;
+			}
+			const std::size_t mult = b - i0 + 1;
+
+			// Inserts U[b] to extract the Bezier segment of [U[a], U[b]].
+			if (mult < p) {
+				const value_type numer = U[b] - U[a];
+				for (std::size_t j = p; j > mult; --j) {
+					this->alpha_[j - mult - 1] = numer / (U[a + j] - U[a]);
+				}
+				const std::size_t r = p - mult;
+				for (std::size_t j = 1; j <= r; ++j) {
+					const std::size_t s = mult + j;
+					for (std::size_t k = p; k >= s; --k) {
+						const value_type alpha = this->alpha_[k - s];
+						this->B_[k] = alpha * this->B_[k]
+								+ (One - alpha) * this->B_[k - 1];
+					}
+					this->R_[r - j] = this->B_[p];
+				}
+			}
+
+			result = this->bezier_(p, U[a], U[b], tolerance, a == p, result);
+
+			if (b < m) {
+				const std::size_t k = (mult < p) ? p - mult : 0;
+				for (std::size_t i = 0; i < k; ++i) {
+					this->B_[i] = this->R_[i];
+				}
+				for (std::size_t i = k; i <= p; ++i) {
+					this->B_[i] = C[b - p + i];
+				}
+				a = b;
+				++b;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Writes the roots of a polynomial of Bernstein coefficients in
+	 * [first, last) on [a, b] to @a result.
+	 *
+	 * @param first The beginning of the coefficients.
+	 * @param last The end of the coefficients.
+	 * @param a The beginning of the interval.
+	 * @param b The end of the interval.
+	 * @param tolerance The width of the intervals where the roots are not
+	 * separated any more.
+	 * @param result The beginning of the roots.
+	 * @return The end of the roots.
+	 */
+	template<typename InputIterator, typename OutputIterator>
+	OutputIterator bezier(InputIterator first, InputIterator last,
+			const value_type& a, const value_type& b,
+			const value_type& tolerance, OutputIterator result) {
+		this->B_.assign(first, last);
+		if (this->B_.size() < 2) {
+			return result;
+		}
+		return this->bezier_(this->B_.size() - 1, a, b, tolerance, true, result);
+	}
+
+private:
+	/**
+	 * @brief Interval of a parameter on the stack, or a root if it is
+	 * empty.
+	 */
+	typedef std::pair<value_type, value_type> interval_type;
+
+	std::vector<value_type> B_; ///< The Bezier segment.
+	std::vector<value_type> R_; ///< The beginning of the next Bezier segment.
+	std::vector<value_type> alpha_;
+	std::vector<value_type> C_; ///< The coefficients of the intervals on the stack.
+	std::vector<interval_type> I_; ///< The intervals to isolate the roots.
+	std::vector<value_type> W_; ///< The work of de Casteljau's algorithm, 3 segments.
+
+	static const std::size_t MaxIterations = 64;
+
+private:
+	roots_kernel(const roots_kernel&);
+	roots_kernel& operator=(const roots_kernel&);
+
+	static int sign_(const value_type& x) {
+		const value_type Zero(GK_FLOAT_ZERO);
+		return (x > Zero) ? 1 : ((x < Zero) ? -1 : 0);
+	}
+
+	/**
+	 * @brief Returns the number of the sign changes of the coefficients
+	 * @a c of a degree @a p, skipping zeros.
+	 */
+	static std::size_t sign_changes_(std::size_t p, const value_type* c) {
+		std::size_t v = 0;
+		int last = 0;
+		for (std::size_t i = 0; i <= p; ++i) {
+			const int s = sign_(c[i]);
+			if (s != 0) {
+				if (last != 0 && s != last) {
+					++v;
+				}
+				last = s;
+			}
+		}
+		return v;
+	}
+
+	/**
+	 * @brief Writes the roots of the Bezier segment B_ on [a, b].
+	 *
+	 * A root at @a b is written, and one at @a a only if @a first, so that
+	 * a root at a knot is written once.
+	 */
+	template<typename OutputIterator>
+	OutputIterator bezier_(std::size_t p, const value_type& a,
+			const value_type& b, const value_type& tolerance, bool first,
+			OutputIterator result) {
+		const value_type Zero(GK_FLOAT_ZERO);
+		const value_type Half(0.5);
+
+		if (first && this->B_[0] == Zero) {
+			*result = a;
+			++result;
+		}
+
+		this->W_.resize(3 * (p + 1));
+		this->C_.assign(this->B_.begin(), this->B_.end());
+		this->I_.clear();
+		this->I_.push_back(std::make_pair(a, b));
+
+		while (!this->I_.empty()) {
+			const interval_type x = this->I_.back();
+			this->I_.pop_back();
+
+			if (x.first == x.second) {
+				*result = x.first;
+				++result;
+				continue;
+			}
+
+			const std::size_t n = this->C_.size() - (p + 1);
+			value_type* c = &this->W_[0];
+			std::copy(this->C_.begin() + n, this->C_.end(), c);
+			this->C_.resize(n);
+
+			const std::size_t v = sign_changes_(p, c);
+			if (v == 0) {
+				continue;
+			}
+			if (v == 1) {
+				*result = this->refine_(p, c, x.first, x.second, tolerance);
+				++result;
+				continue;
+			}
+			if (x.second - x.first <= tolerance) {
+				*result = Half * (x.first + x.second);
+				++result;
+				continue;
+			}
+
+			// Splits the interval into the left in c and the right in d, and
+			// pushes the left last to be popped first.
+			value_type* d = &this->W_[p + 1];
+			d[p] = c[p];
+			for (std::size_t k = 1; k <= p; ++k) {
+				for (std::size_t i = p; i >= k; --i) {
+					c[i] = Half * (c[i - 1] + c[i]);
+				}
+				d[p - k] = c[p];
+			}
+
+			const value_type middle = Half * (x.first + x.second);
+			this->C_.insert(this->C_.end(), d, d + p + 1);
+			this->I_.push_back(std::make_pair(middle, x.second));
+			if (c[p] == Zero) {
+				this->I_.push_back(std::make_pair(middle, middle));
+			}
+			this->C_.insert(this->C_.end(), c, c + p + 1);
+			this->I_.push_back(std::make_pair(x.first, middle));
+		}
+
+		if (this->B_[p] == Zero) {
+			*result = b;
+			++result;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Evaluates the polynomial of coefficients @a c and its
+	 * derivative at a local parameter @a s in [0, 1].
+	 */
+	static value_type evaluate_(std::size_t p, const value_type* c,
+			value_type* w, const value_type& s, value_type& derivative) {
+		const value_type One(GK_FLOAT_ONE);
+
+		std::copy(c, c + p + 1, w);
+		for (std::size_t k = 1; k < p; ++k) {
+			for (std::size_t i = 0; i <= p - k; ++i) {
+				w[i] = (One - s) * w[i] + s * w[i + 1];
+			}
+		}
+		derivative = value_type(p) * (w[1] - w[0]);
+		return (One - s) * w[0] + s * w[1];
+	}
+
+	/**
+	 * @brief Refines the root of the coefficients @a c of a sign change on
+	 * [a, b].
+	 */
+	value_type refine_(std::size_t p, const value_type* c, const value_type& a,
+			const value_type& b, const value_type& tolerance) {
+		const value_type Zero(GK_FLOAT_ZERO);
+		const value_type Half(0.5);
+
+		// The sign at the upper end; a zero coefficient at an end is a root
+		// written by the caller, and does not tell the side.
+		int upper = 0;
+		for (std::size_t i = p + 1; i-- > 0 && upper == 0;) {
+			upper = sign_(c[i]);
+		}
+
+		value_type* w = &this->W_[2 * (p + 1)];
+
+		value_type lo = Zero;
+		value_type hi = value_type(GK_FLOAT_ONE);
+		value_type flo = c[0];
+		value_type fhi = c[p];
+		int side = 0;
+		const value_type width = tolerance / (b - a);
+
+		for (std::size_t it = 0; it < MaxIterations && hi - lo > width; ++it) {
+			value_type s = Half * (lo + hi);
+			if (flo != Zero && fhi != Zero) {
+				const value_type secant = (lo * fhi - hi * flo) / (fhi - flo);
+				if (lo < secant && secant < hi) {
+					s = secant;
+				}
+			}
+
+			value_type df;
+			const value_type f = evaluate_(p, c, w, s, df);
+			if (f == Zero) {
+				return a + (b - a) * s;
+			}
+
+			// Illinois: halves the value kept at the same end twice.
+			if (sign_(f) == upper) {
+				hi = s;
+				fhi = f;
+				if (side == 1) {
+					flo *= Half;
+				}
+				side = 1;
+			} else {
+				lo = s;
+				flo = f;
+				if (side == -1) {
+					fhi *= Half;
+				}
+				side = -1;
+			}
+
+			if (df != Zero) {
+				const value_type t = s - f / df;
+				if (lo < t && t < hi) {
+					value_type dt;
+					const value_type ft = evaluate_(p, c, w, t, dt);
+					if (ft == Zero) {
+						return a + (b - a) * t;
+					}
+					if (sign_(ft) == upper) {
+						hi = t;
+						fhi = ft;
+					} else {
+						lo = t;
+						flo = ft;
+					}
+					side = 0;
+				}
+			}
+		}
+
+		return a + (b - a) * Half * (lo + hi);
+	}
+};
+
+}  // namespace impl
+
+namespace alg {
+
+/**
+ * @brief Computes the roots of a scalar B-spline.
+ *
+ * @param degree Degree, at least 1.
+ * @param U_first The beginning of the clamped knot vector.
+ * @param U_last The end of the knot vector.
+ * @param C The beginning of the coefficients.
+ * @param tolerance The width of the parameter intervals where the roots are
+ * not separated any more.
+ * @param result The beginning of the roots, in increasing order.
+ * @return The end of the roots.
+ */
+template<typename KnotRandomAccessIterator, typename InputRandomAccessIterator,
+		typename T, typename OutputIterator>
+OutputIterator bspline_roots(std::size_t degree,
+		KnotRandomAccessIterator U_first, KnotRandomAccessIterator U_last,
+		InputRandomAccessIterator C, const T& tolerance,
+		OutputIterator result) {
+	impl::roots_kernel<T> kernel;
+	return kernel(degree, U_first, U_last, C, tolerance, result);
+}
+
+/**
+ * @brief Computes the roots of a polynomial of Bernstein coefficients on
+ * [a, b].
+ *
+ * @param first The beginning of the coefficients.
+ * @param last The end of the coefficients.
+ * @param a The beginning of the interval.
+ * @param b The end of the interval.
+ * @param tolerance The width of the intervals where the roots are not
+ * separated any more.
+ * @param result The beginning of the roots, in increasing order.
+ * @return The end of the roots.
+ */
+template<typename InputIterator, typename T, typename OutputIterator>
+OutputIterator bezier_roots(InputIterator first, InputIterator last,
+		const T& a, const T& b, const T& tolerance, OutputIterator result) {
+	impl::roots_kernel<T> kernel;
+	return kernel.bezier(first, last, a, b, tolerance, result);
+}
+
+}  // namespace alg
+
+}  // namespace gk
+
+#endif /* ALGORITHM_ROOTS_H_ */
@@ -0,0 +1,397 @@
+/*
+ * simplify.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_SIMPLIFY_H_
+#define ALGORITHM_SIMPLIFY_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+#include "../gkvector.h"
+#include "../primitive/line.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Returns the area of a triangle of @a a, @a b and @a c in any
+ * dimension, @f$\frac{1}{2}\sqrt{|u|^2|v|^2 - (u \cdot v)^2}@f$.
+ */
+template<typename Vector>
+typename vector_traits<Vector>::value_type area_of_corner(const Vector& a,
+		const Vector& b, const Vector& c) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const Vector u = a - b;
+	const Vector v = c - b;
+	const value_type uv = dot(u, v);
+	const value_type d = dot(u, u) * dot(v, v) - uv * uv;
+	return value_type(0.5) * std::sqrt(std::max(d, value_type(GK_FLOAT_ZERO)));
+}
+
+/**
+ * @brief Simplifies polylines by the Douglas-Peucker algorithm.
+ *
+ * The ranges left to split are kept on a stack instead of the call stack,
+ * so that a polyline of any length is simplified without recursion. An
+ * instance keeps its buffers, so it is made once for each thread.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class douglas_peucker_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	douglas_peucker_kernel() :
+			stack_(), keep_() {
+	}
+
+	~douglas_peucker_kernel() {
+	}
+
+	/**
+	 * @brief Writes the vertices in [first, last) within a @a tolerance of
+	 * the simplified polyline to @a result.
+	 */
+	template<typename InputRandomAccessIterator, typename OutputIterator>
+	OutputIterator operator()(InputRandomAccessIterator first,
+			InputRandomAccessIterator last, const value_type& tolerance,
+			OutputIterator result) {
+		const std::size_t n = std::distance(first, last);
+		if (n < 3) {
+			return std::copy(first, last, result);
+		}
+
+		const value_type tolerance2 = tolerance * tolerance;
+
+		this->keep_.assign(n, 0);
+		this->keep_[0] = 1;
+		this->keep_[n - 1] = 1;
+
+		this->stack_.clear();
+		this->stack_.push_back(std::make_pair(std::size_t(0), n - 1));
+
+		while (!this->stack_.empty()) {
+			const std::size_t i = this->stack_.back().first;
+			const std::size_t j = this->stack_.back().second;
+			this->stack_.pop_back();
+
+			const Vector a = first[i];
+			const Vector b = first[j];
+			const Vector u = b - a;
+			const value_type uu = dot(u, u);
+			const value_type w =
+					(uu > value_type(GK_FLOAT_ZERO)) ?
+							value_type(GK_FLOAT_ONE) / uu :
+							value_type(GK_FLOAT_ZERO);
+
+			std::size_t k = i;
+			value_type d_max = tolerance2;
+			for (std::size_t m = i + 1; m < j; ++m) {
+				// |r - t u|^2 of the parameter t of the nearest position.
+				const Vector r = first[m] - a;
+				const value_type ru = dot(r, u);
+				const value_type t = std::min(
+						std::max(ru * w, value_type(GK_FLOAT_ZERO)),
+						value_type(GK_FLOAT_ONE));
+				const value_type d = dot(r, r) - t * (value_type(2) * ru - t * uu);
+				if (d > d_max) {
+					d_max = d;
+					k = m;
+				}
+			}
+
+			if (k == i) {
+				continue;
+			}
+
+			this->keep_[k] = 1;
+			if (k - i > 1) {
+				this->stack_.push_back(std::make_pair(i, k));
+			}
+			if (j - k > 1) {
+				this->stack_.push_back(std::make_pair(k, j));
+			}
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			if (this->keep_[i]) {
+				*result = first[i];
+				++result;
+			}
+		}
+		return result;
+	}
+
+private:
+	std::vector<std::pair<std::size_t, std::size_t> > stack_; ///< The ranges to split.
+	std::vector<unsigned char> keep_; ///< The flags of the kept vertices.
+
+private:
+	douglas_peucker_kernel(const douglas_peucker_kernel&);
+	douglas_peucker_kernel& operator=(const douglas_peucker_kernel&);
+};
+
+/**
+ * @brief Simplifies polylines by the Visvalingam-Whyatt algorithm.
+ *
+ * The vertex of the smallest effective area, the area of the triangle with
+ * its neighbors, is removed repeatedly. The areas are kept on a binary heap
+ * whose stale entries are skipped when they are popped, and the area of a
+ * neighbor is not let below the area removed, so that the vertices are
+ * removed in non-decreasing order of their areas. An instance keeps its
+ * buffers, so it is made once for each thread.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class visvalingam_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	visvalingam_kernel() :
+			heap_(), A_(), prev_(), next_() {
+	}
+
+	~visvalingam_kernel() {
+	}
+
+	/**
+	 * @brief Writes the vertices in [first, last) whose effective areas are
+	 * not less than an @a area to @a result.
+	 */
+	template<typename InputRandomAccessIterator, typename OutputIterator>
+	OutputIterator operator()(InputRandomAccessIterator first,
+			InputRandomAccessIterator last, const value_type& area,
+			OutputIterator result) {
+		typedef std::greater<entry_type> compare_type;
+
+		const std::size_t n = std::distance(first, last);
+		if (n < 3) {
+			return std::copy(first, last, result);
+		}
+
+		this->A_.resize(n);
+		this->prev_.resize(n);
+		this->next_.resize(n);
+		this->heap_.clear();
+
+		for (std::size_t i = 0; i < n; ++i) {
+			this->prev_[i] = i - 1;
+			this->next_[i] = i + 1;
+		}
+
+		for (std::size_t i = 1; i < n - 1; ++i) {
+			this->A_[i] = area_of_corner(Vector(first[i - 1]),
+					Vector(first[i]), Vector(first[i + 1]));
+			if (this->A_[i] < area) {
+				this->heap_.push_back(std::make_pair(this->A_[i], i));
+			}
+		}
+		std::make_heap(this->heap_.begin(), this->heap_.end(),
+				compare_type());
+
+		const std::size_t Removed = n;
+		while (!this->heap_.empty()) {
+			std::pop_heap(this->heap_.begin(), this->heap_.end(),
+					compare_type());
+			const entry_type e = this->heap_.back();
+			this->heap_.pop_back();
+
+			const std::size_t i = e.second;
+			if (this->next_[i] == Removed || e.first != this->A_[i]) {
+				continue;
+			}
+
+			const std::size_t p = this->prev_[i];
+			const std::size_t q = this->next_[i];
+			this->next_[p] = q;
+			this->prev_[q] = p;
+			this->next_[i] = Removed;
+
+			if (p > 0) {
+				this->update_(first, p, e.first, area);
+			}
+			if (q < n - 1) {
+				this->update_(first, q, e.first, area);
+			}
+		}
+
+		for (std::size_t i = 0; i < n; i = this->next_[i]) {
+			*result = first[i];
+			++result;
+		}
+		return result;
+	}
+
+private:
+	typedef std::pair<value_type, std::size_t> entry_type;
+
+	std::vector<entry_type> heap_; ///< The min-heap of the areas and the vertices.
+	std::vector<value_type> A_; ///< The effective areas of the vertices.
+	std::vector<std::size_t> prev_;
+	std::vector<std::size_t> next_; ///< The next vertices, or the size of removed ones.
+
+private:
+	visvalingam_kernel(const visvalingam_kernel&);
+	visvalingam_kernel& operator=(const visvalingam_kernel&);
+
+	/**
+	 * @brief Recomputes the area of a vertex @a i after its neighbor of an
+	 * area @a removed is removed.
+	 */
+	template<typename InputRandomAccessIterator>
+	void update_(InputRandomAccessIterator first, std::size_t i,
+			const value_type& removed, const value_type& area) {
+		typedef std::greater<entry_type> compare_type;
+
+		this->A_[i] = std::max(
+				area_of_corner(Vector(first[this->prev_[i]]), Vector(first[i]),
+						Vector(first[this->next_[i]])), removed);
+		if (this->A_[i] < area) {
+			this->heap_.push_back(std::make_pair(this->A_[i], i));
+			std::push_heap(this->heap_.begin(), this->heap_.end(),
+					compare_type());
+		}
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Simplifies a polyline by the Douglas-Peucker algorithm.
+ *
+ * @param x
+ * @param tolerance The maximum distance of the removed vertices from the
+ * simplified polyline.
+ * @return The simplified polyline, which keeps the first and the last
+ * vertices.
+ */
+template<typename Vector>
+polyline<Vector> simplify(const polyline<Vector>& x,
+		const typename vector_traits<Vector>::value_type& tolerance) {
+	impl::douglas_peucker_kernel<Vector> kernel;
+
+	std::vector<Vector> V;
+	kernel(x.begin(), x.end(), tolerance, std::back_inserter(V));
+	return polyline<Vector>(V.begin(), V.end());
+}
+
+/**
+ * @brief Simplifies a polyline by the Visvalingam-Whyatt algorithm.
+ *
+ * @param x
+ * @param area The minimum effective area of the kept vertices.
+ * @return The simplified polyline, which keeps the first and the last
+ * vertices.
+ */
+template<typename Vector>
+polyline<Vector> simplify_by_area(const polyline<Vector>& x,
+		const typename vector_traits<Vector>::value_type& area) {
+	impl::visvalingam_kernel<Vector> kernel;
+
+	std::vector<Vector> V;
+	kernel(x.begin(), x.end(), area, std::back_inserter(V));
+	return polyline<Vector>(V.begin(), V.end());
+}
+
+/**
+ * @brief Simplifies polylines in [first, last) by the Douglas-Peucker
+ * algorithm.
+ *
+ * The polylines are processed in parallel when OpenMP is enabled.
+ *
+ * @param first The beginning of the polylines.
+ * @param last The end of the polylines.
+ * @param tolerance The maximum distance of the removed vertices.
+ * @param result The beginning of the simplified polylines.
+ * @return The end of the simplified polylines.
+ */
+template<typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator, typename T>
+OutputRandomAccessIterator simplify(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, const T& tolerance,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type polyline_type;
+	typedef typename polyline_type::vector_type vector_type;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::douglas_peucker_kernel<vector_type> kernel;
+		std::vector<vector_type> V;
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			V.clear();
+			kernel(first[i].begin(), first[i].end(), tolerance,
+					std::back_inserter(V));
+			result[i] = polyline_type(V.begin(), V.end());
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Simplifies polylines in [first, last) by the Visvalingam-Whyatt
+ * algorithm.
+ *
+ * The polylines are processed in parallel when OpenMP is enabled.
+ *
+ * @param first The beginning of the polylines.
+ * @param last The end of the polylines.
+ * @param area The minimum effective area of the kept vertices.
+ * @param result The beginning of the simplified polylines.
+ * @return The end of the simplified polylines.
+ */
+template<typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator, typename T>
+OutputRandomAccessIterator simplify_by_area(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, const T& area,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type polyline_type;
+	typedef typename polyline_type::vector_type vector_type;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::visvalingam_kernel<vector_type> kernel;
+		std::vector<vector_type> V;
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			V.clear();
+			kernel(first[i].begin(), first[i].end(), area,
+					std::back_inserter(V));
+			result[i] = polyline_type(V.begin(), V.end());
+		}
+	}
+
+	return result + n;
+}
+
+}  // namespace gk
+
+#endif /* ALGORITHM_SIMPLIFY_H_ */
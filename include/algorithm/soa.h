@@ -0,0 +1,281 @@
+/*
+ * soa.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_SOA_H_
+#define ALGORITHM_SOA_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../gkaabb.h"
+#include "../vector/point_soa.h"
+#include "../primitive/plane.h"
+#include "kernel.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Kernels over the lanes of positions.
+ *
+ * Each kernel loops over the axes outside and the positions inside, so
+ * that the inner loops run over contiguous lanes which the compiler
+ * vectorizes. Large ranges are split across threads with OpenMP.
+ *
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t Dimension>
+struct soa_kernel {
+	static const std::ptrdiff_t ParallelSize = 1 << 15; ///< The minimum number of positions to process in parallel.
+
+	typedef point_soa<T, Dimension> container_type;
+
+	/**
+	 * @brief Computes @f$s_i = \mathbf{n} \cdot (\mathbf{r} -
+	 * \mathbf{x}_i)@f$ to @a s, which has the stride of @a X.
+	 */
+	static void plane_distances(const T* r, const T* n, const container_type& X,
+			T* s) {
+		T c = T(GK_FLOAT_ZERO);
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			c += n[d] * r[d];
+		}
+
+		const std::ptrdiff_t m = X.stride();
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= ParallelSize)
+#endif
+		for (std::ptrdiff_t i = 0; i < m; ++i) {
+			s[i] = c;
+		}
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			const T* const x = X.lane(d);
+			const T a = n[d];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= ParallelSize)
+#endif
+			for (std::ptrdiff_t i = 0; i < m; ++i) {
+				s[i] -= a * x[i];
+			}
+		}
+	}
+
+	/**
+	 * @brief Computes @f$t_i = \mathbf{u} \cdot (\mathbf{x}_i -
+	 * \mathbf{r})@f$ to @a t, which has the stride of @a X.
+	 */
+	static void line_parameters(const T* r, const T* u, const container_type& X,
+			T* t) {
+		T c = T(GK_FLOAT_ZERO);
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			c += u[d] * r[d];
+		}
+
+		const std::ptrdiff_t m = X.stride();
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= ParallelSize)
+#endif
+		for (std::ptrdiff_t i = 0; i < m; ++i) {
+			t[i] = -c;
+		}
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			const T* const x = X.lane(d);
+			const T a = u[d];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= ParallelSize)
+#endif
+			for (std::ptrdiff_t i = 0; i < m; ++i) {
+				t[i] += a * x[i];
+			}
+		}
+	}
+};
+
+} // namespace impl
+
+/**
+ * @brief Computes the displacements from positions @a X to their nearest
+ * positions on a plane @a p, as nearest(const plane<Vector>&, const Vector&)
+ * does for one position.
+ * @param p
+ * @param X
+ * @param result The displacements, which may be @a X.
+ */
+template<typename Vector, typename T, std::size_t Dimension>
+void nearest(const plane<Vector>& p, const point_soa<T, Dimension>& X,
+		point_soa<T, Dimension>& result) {
+	T r[Dimension];
+	T n[Dimension];
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		r[d] = T(p.reference()[d]);
+		n[d] = T(p.normal()[d]);
+	}
+
+	std::vector<T> s(X.stride());
+	impl::soa_kernel<T, Dimension>::plane_distances(r, n, X, &s[0]);
+
+	// Writes the positions only, which keeps the padding of the lanes zero.
+	result.resize(X.size());
+	const std::ptrdiff_t m = X.size();
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		T* const y = result.lane(d);
+		const T a = n[d];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= impl::soa_kernel<T, Dimension>::ParallelSize)
+#endif
+		for (std::ptrdiff_t i = 0; i < m; ++i) {
+			y[i] = s[i] * a;
+		}
+	}
+}
+
+/**
+ * @brief Tests which side of a plane @a p positions @a X are on, as
+ * orientation(const plane<Vector>&, const Vector&) does for one position.
+ * @param p
+ * @param X
+ * @param result The beginning of the results; @c true if the reference of
+ * @a p is on the side of the normal from a position.
+ * @return The end of the results.
+ */
+template<typename Vector, typename T, std::size_t Dimension,
+		typename OutputIterator>
+OutputIterator orientation(const plane<Vector>& p,
+		const point_soa<T, Dimension>& X, OutputIterator result) {
+	T r[Dimension];
+	T n[Dimension];
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		r[d] = T(p.reference()[d]);
+		n[d] = T(p.normal()[d]);
+	}
+
+	std::vector<T> s(X.stride());
+	impl::soa_kernel<T, Dimension>::plane_distances(r, n, X, &s[0]);
+
+	for (std::size_t i = 0; i < X.size(); ++i) {
+		*result = !(s[i] < T(GK_FLOAT_ZERO));
+		++result;
+	}
+	return result;
+}
+
+/**
+ * @brief Computes the signed distances from a plane @a p to positions
+ * @a X; positive on the side of the normal.
+ * @param p
+ * @param X
+ * @param result The beginning of the distances.
+ * @return The end of the distances.
+ */
+template<typename Vector, typename T, std::size_t Dimension,
+		typename OutputIterator>
+OutputIterator distances(const plane<Vector>& p,
+		const point_soa<T, Dimension>& X, OutputIterator result) {
+	T r[Dimension];
+	T n[Dimension];
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		r[d] = T(p.reference()[d]);
+		n[d] = T(p.normal()[d]);
+	}
+
+	std::vector<T> s(X.stride());
+	impl::soa_kernel<T, Dimension>::plane_distances(r, n, X, &s[0]);
+
+	for (std::size_t i = 0; i < X.size(); ++i) {
+		*result = -s[i];
+		++result;
+	}
+	return result;
+}
+
+/**
+ * @brief Computes the box enclosing positions @a X, which are not empty.
+ */
+template<typename T, std::size_t Dimension>
+aabb<typename point_soa<T, Dimension>::vector_type> boundary(
+		const point_soa<T, Dimension>& X) {
+	typedef typename point_soa<T, Dimension>::vector_type vector_type;
+
+	const std::ptrdiff_t m = X.size();
+
+	vector_type u;
+	vector_type v;
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		const T* const x = X.lane(d);
+		T a = x[0];
+		T b = x[0];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) reduction(min : a) reduction(max : b) if (m >= impl::soa_kernel<T, Dimension>::ParallelSize)
+#endif
+		for (std::ptrdiff_t i = 0; i < m; ++i) {
+			a = (x[i] < a) ? x[i] : a;
+			b = (b < x[i]) ? x[i] : b;
+		}
+
+		u[d] = a;
+		v[d] = b;
+	}
+
+	return aabb<vector_type>(u, v);
+}
+
+namespace alg {
+
+/**
+ * @brief Computes the displacements from positions @a X to a line, as
+ * nearest_to_line(const Vector&, const direction&, const Vector&) does
+ * for one position.
+ * @param reference Reference of a line.
+ * @param u Direction of a line.
+ * @param X Positions.
+ * @param result The displacements, which may be @a X.
+ */
+template<typename Vector, typename T, std::size_t Dimension>
+void nearest_to_line(const Vector& reference,
+		const direction<vector_traits<Vector>::Dimension>& u,
+		const point_soa<T, Dimension>& X, point_soa<T, Dimension>& result) {
+	T r[Dimension];
+	T w[Dimension];
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		r[d] = T(reference[d]);
+		w[d] = T(u[d]);
+	}
+
+	std::vector<T> t(X.stride());
+	impl::soa_kernel<T, Dimension>::line_parameters(r, w, X, &t[0]);
+
+	// Writes the positions only, which keeps the padding of the lanes zero.
+	result.resize(X.size());
+	const std::ptrdiff_t m = X.size();
+	for (std::size_t d = 0; d < Dimension; ++d) {
+		const T* const x = X.lane(d);
+		T* const y = result.lane(d);
+		const T a = w[d];
+		const T b = r[d];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= impl::soa_kernel<T, Dimension>::ParallelSize)
+#endif
+		for (std::ptrdiff_t i = 0; i < m; ++i) {
+			y[i] = t[i] * a - (x[i] - b);
+		}
+	}
+}
+
+}  // namespace alg
+
+} // namespace gk
+
+#endif /* ALGORITHM_SOA_H_ */
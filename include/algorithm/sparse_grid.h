@@ -0,0 +1,237 @@
+/*
+ * sparse_grid.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_SPARSE_GRID_H_
+#define ALGORITHM_SPARSE_GRID_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "../gkdef.h"
+
+namespace gk {
+
+/**
+ * @brief Sparse grid of values in 3D, stored in blocks of
+ * @f$8^3@f$ voxels.
+ *
+ * A block is either allocated, holding a value for each of its voxels, or
+ * a tile, holding one value for all of them. The table of the blocks costs
+ * a 4 byte index and a tile value for each block, so that a grid of
+ * @f$1024^3@f$ voxels costs 16 MB of float, or 24 MB of double, besides
+ * its allocated blocks.
+ *
+ * Allocating a block may move the others; the values are written in
+ * parallel after all the blocks are allocated.
+ *
+ * @tparam T Type of a value.
+ *
+ * @date 2026/10/19
+ */
+template<typename T>
+class sparse_grid {
+public:
+	static const std::size_t BlockBits = 3;
+	static const std::size_t BlockSize = 1 << BlockBits; ///< The number of the voxels on an edge of a block.
+	static const std::size_t BlockVolume = BlockSize * BlockSize * BlockSize;
+
+	typedef T value_type;
+	typedef uint32_t index_type;
+
+	static const index_type NoBlock = 0xffffffff; ///< The index of a tile.
+
+public:
+	sparse_grid() :
+			B_(), tiles_(), V_() {
+		std::fill(this->N_, this->N_ + GK::GK_3D, 0);
+		std::fill(this->M_, this->M_ + GK::GK_3D, 0);
+	}
+
+	sparse_grid(const sparse_grid& other) :
+			B_(other.B_), tiles_(other.tiles_), V_(other.V_) {
+		std::copy(other.N_, other.N_ + GK::GK_3D, this->N_);
+		std::copy(other.M_, other.M_ + GK::GK_3D, this->M_);
+	}
+
+	/**
+	 * @brief Constructs the grid of @a nx, @a ny and @a nz voxels, all tiles
+	 * of a value @a background.
+	 */
+	sparse_grid(std::size_t nx, std::size_t ny, std::size_t nz,
+			const value_type& background) :
+			B_(), tiles_(), V_() {
+		this->reset(nx, ny, nz, background);
+	}
+
+	~sparse_grid() {
+	}
+
+	/**
+	 * @brief Returns the number of the voxels on an axis @a d.
+	 */
+	std::size_t size(std::size_t d) const {
+		return this->N_[d];
+	}
+
+	/**
+	 * @brief Returns the number of the blocks on an axis @a d.
+	 */
+	std::size_t block_size(std::size_t d) const {
+		return this->M_[d];
+	}
+
+	/**
+	 * @brief Returns the number of the blocks.
+	 */
+	std::size_t block_count() const {
+		return this->B_.size();
+	}
+
+	/**
+	 * @brief Returns the number of the allocated blocks.
+	 */
+	std::size_t allocated_count() const {
+		return this->V_.size() / BlockVolume;
+	}
+
+	/**
+	 * @brief Returns the index of the block at @a i, @a j and @a k in the
+	 * blocks.
+	 */
+	std::size_t block_index(std::size_t i, std::size_t j, std::size_t k) const {
+		return i + this->M_[GK::X] * (j + this->M_[GK::Y] * k);
+	}
+
+	bool is_allocated(std::size_t b) const {
+		return this->B_[b] != NoBlock;
+	}
+
+	/**
+	 * @brief Returns the values of an allocated block @a b, the voxel at
+	 * @a x, @a y and @a z in the block at @f$x + 8(y + 8z)@f$.
+	 */
+	const value_type* block(std::size_t b) const {
+		return &this->V_[std::size_t(this->B_[b]) * BlockVolume];
+	}
+
+	value_type* block(std::size_t b) {
+		return &this->V_[std::size_t(this->B_[b]) * BlockVolume];
+	}
+
+	/**
+	 * @brief Returns the value of a tile @a b.
+	 */
+	const value_type& tile(std::size_t b) const {
+		return this->tiles_[b];
+	}
+
+	void tile(std::size_t b, const value_type& value) {
+		this->tiles_[b] = value;
+	}
+
+	/**
+	 * @brief Allocates a block @a b, filled with the value of its tile.
+	 */
+	void allocate(std::size_t b) {
+		if (this->B_[b] != NoBlock) {
+			return;
+		}
+
+		this->B_[b] = index_type(this->allocated_count());
+		this->V_.resize(this->V_.size() + BlockVolume, this->tiles_[b]);
+	}
+
+	/**
+	 * @brief Reserves the memory of @a n allocated blocks.
+	 */
+	void reserve(std::size_t n) {
+		this->V_.reserve(n * BlockVolume);
+	}
+
+	/**
+	 * @brief Makes the grid of @a nx, @a ny and @a nz voxels, all tiles of a
+	 * value @a background.
+	 */
+	void reset(std::size_t nx, std::size_t ny, std::size_t nz,
+			const value_type& background) {
+		this->N_[GK::X] = nx;
+		this->N_[GK::Y] = ny;
+		this->N_[GK::Z] = nz;
+		for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+			this->M_[d] = (this->N_[d] + BlockSize - 1) / BlockSize;
+		}
+
+		const std::size_t n = this->M_[GK::X] * this->M_[GK::Y]
+				* this->M_[GK::Z];
+		this->B_.assign(n, index_type(NoBlock));
+		this->tiles_.assign(n, background);
+		std::vector<value_type>().swap(this->V_);
+	}
+
+	void swap(sparse_grid& other) {
+		std::swap_ranges(this->N_, this->N_ + GK::GK_3D, other.N_);
+		std::swap_ranges(this->M_, this->M_ + GK::GK_3D, other.M_);
+		this->B_.swap(other.B_);
+		this->tiles_.swap(other.tiles_);
+		this->V_.swap(other.V_);
+	}
+
+	/**
+	 * @brief Returns the value of the voxel at @a i, @a j and @a k.
+	 */
+	const value_type& operator()(std::size_t i, std::size_t j,
+			std::size_t k) const {
+		const std::size_t Mask = BlockSize - 1;
+
+		const std::size_t b = this->block_index(i >> BlockBits, j >> BlockBits,
+				k >> BlockBits);
+		if (this->B_[b] == NoBlock) {
+			return this->tiles_[b];
+		}
+		return this->block(b)[(i & Mask)
+				+ BlockSize * ((j & Mask) + BlockSize * (k & Mask))];
+	}
+
+	/**
+	 * @brief Sets the value of the voxel at @a i, @a j and @a k, allocating
+	 * its block.
+	 */
+	void set(std::size_t i, std::size_t j, std::size_t k,
+			const value_type& value) {
+		const std::size_t Mask = BlockSize - 1;
+
+		const std::size_t b = this->block_index(i >> BlockBits, j >> BlockBits,
+				k >> BlockBits);
+		this->allocate(b);
+		this->block(b)[(i & Mask)
+				+ BlockSize * ((j & Mask) + BlockSize * (k & Mask))] = value;
+	}
+
+	sparse_grid& operator=(const sparse_grid& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		std::copy(rhs.N_, rhs.N_ + GK::GK_3D, this->N_);
+		std::copy(rhs.M_, rhs.M_ + GK::GK_3D, this->M_);
+		this->B_ = rhs.B_;
+		this->tiles_ = rhs.tiles_;
+		this->V_ = rhs.V_;
+		return *this;
+	}
+
+private:
+	std::size_t N_[GK::GK_3D]; ///< The numbers of the voxels.
+	std::size_t M_[GK::GK_3D]; ///< The numbers of the blocks.
+	std::vector<index_type> B_; ///< The indices of the blocks in @a V_, or NoBlock.
+	std::vector<value_type> tiles_; ///< The values of the tiles.
+	std::vector<value_type> V_; ///< The values of the allocated blocks.
+};
+
+} // namespace gk
+
+#endif /* ALGORITHM_SPARSE_GRID_H_ */
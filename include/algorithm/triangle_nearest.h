@@ -0,0 +1,128 @@
+/*
+ * triangle_nearest.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_TRIANGLE_NEAREST_H_
+#define ALGORITHM_TRIANGLE_NEAREST_H_
+
+#include "../gkvector.h"
+#include "../primitive/triangle.h"
+
+namespace gk {
+
+namespace alg {
+
+/**
+ * @brief Computes the nearest position on a triangle to a position @a p by
+ * the Voronoi regions of its vertices and edges (Ericson, Real-Time
+ * Collision Detection, 5.1.5).
+ *
+ * The regions are tested with the dot products of the edges, each computed
+ * once, in the order of the vertices, the edges and the face; no square
+ * root nor cross product is needed.
+ *
+ * @param p
+ * @param first
+ * @param second
+ * @param third
+ * @param s The barycentric coordinate of the second vertex.
+ * @param t The barycentric coordinate of the third vertex.
+ * @return The nearest position,
+ * @f$\mathbf{x}_0 + s\mathbf{u} + t\mathbf{v}@f$.
+ */
+template<typename Vector>
+Vector nearest_on_triangle(const Vector& p, const Vector& first,
+		const Vector& second, const Vector& third,
+		typename vector_traits<Vector>::value_type& s,
+		typename vector_traits<Vector>::value_type& t) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+	const value_type One = value_type(GK_FLOAT_ONE);
+
+	const Vector u = second - first;
+	const Vector v = third - first;
+
+	const Vector w0 = p - first;
+	const value_type d1 = dot(u, w0);
+	const value_type d2 = dot(v, w0);
+	if (d1 <= Zero && d2 <= Zero) {
+		s = Zero;
+		t = Zero;
+		return first;
+	}
+
+	const Vector w1 = p - second;
+	const value_type d3 = dot(u, w1);
+	const value_type d4 = dot(v, w1);
+	if (d3 >= Zero && d4 <= d3) {
+		s = One;
+		t = Zero;
+		return second;
+	}
+
+	const value_type vc = d1 * d4 - d3 * d2;
+	if (vc <= Zero && d1 >= Zero && d3 <= Zero) {
+		s = d1 / (d1 - d3);
+		t = Zero;
+		return first + s * u;
+	}
+
+	const Vector w2 = p - third;
+	const value_type d5 = dot(u, w2);
+	const value_type d6 = dot(v, w2);
+	if (d6 >= Zero && d5 <= d6) {
+		s = Zero;
+		t = One;
+		return third;
+	}
+
+	const value_type vb = d5 * d2 - d1 * d6;
+	if (vb <= Zero && d2 >= Zero && d6 <= Zero) {
+		s = Zero;
+		t = d2 / (d2 - d6);
+		return first + t * v;
+	}
+
+	const value_type va = d3 * d6 - d5 * d4;
+	if (va <= Zero && d4 - d3 >= Zero && d5 - d6 >= Zero) {
+		t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		s = One - t;
+		return second + t * (third - second);
+	}
+
+	const value_type f = One / (va + vb + vc);
+	s = vb * f;
+	t = vc * f;
+	return first + s * u + t * v;
+}
+
+}  // namespace alg
+
+/**
+ * @brief Computes the nearest position on a triangle @a a to a position
+ * @a p.
+ *
+ * @param a
+ * @param p
+ * @param s The barycentric coordinate of the second vertex.
+ * @param t The barycentric coordinate of the third vertex.
+ * @return The nearest position, @c a(s, t).
+ *
+ * @see alg::nearest_on_triangle()
+ */
+template<typename Vector>
+Vector nearest(const triangle<Vector>& a, const Vector& p,
+		typename vector_traits<Vector>::value_type& s,
+		typename vector_traits<Vector>::value_type& t) {
+	typedef triangle<Vector> triangle_type;
+
+	return alg::nearest_on_triangle(p, a[triangle_type::First],
+			a[triangle_type::Second], a[triangle_type::Third], s, t);
+}
+
+}  // namespace gk
+
+#endif /* ALGORITHM_TRIANGLE_NEAREST_H_ */
@@ -0,0 +1,276 @@
+/*
+ * triangle_overlap.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef ALGORITHM_TRIANGLE_OVERLAP_H_
+#define ALGORITHM_TRIANGLE_OVERLAP_H_
+
+#include <cmath>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../primitive/triangle.h"
+
+namespace gk {
+
+/**
+ * @brief Intersection of two triangles in 3D.
+ *
+ * Triangles on different planes meet in a segment, which degenerates to a
+ * point where they touch. Triangles on the same plane overlap in a polygon,
+ * which is not computed.
+ *
+ * @tparam Vector Type of a vector in 3D.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+struct triangle_overlap {
+	bool coplanar; ///< true if the triangles are on the same plane.
+	Vector start; ///< The start of the segment, unless coplanar.
+	Vector end; ///< The end of the segment, unless coplanar.
+
+	triangle_overlap() :
+			coplanar(), start(), end() {
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Computes the interval where a triangle crosses the plane of the
+ * other, on the line of intersection of the planes (Möller).
+ *
+ * The vertex alone on its side of the plane is chosen from the signed
+ * distances @a d; the ends are on the two edges from it.
+ *
+ * @return false if the vertices are on the plane.
+ */
+template<typename Vector>
+bool triangle_plane_interval(const Vector* x,
+		const typename vector_traits<Vector>::value_type* d, const Vector& D,
+		typename vector_traits<Vector>::value_type* t, Vector* X) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	std::size_t i;
+	if (d[0] * d[1] > Zero) {
+		i = 2;
+	} else if (d[0] * d[2] > Zero) {
+		i = 1;
+	} else if (d[1] * d[2] > Zero || d[0] != Zero) {
+		i = 0;
+	} else if (d[1] != Zero) {
+		i = 1;
+	} else if (d[2] != Zero) {
+		i = 2;
+	} else {
+		return false;
+	}
+
+	for (std::size_t k = 0; k < 2; ++k) {
+		const std::size_t j = (i + 1 + k) % 3;
+		X[k] = x[i] + (x[j] - x[i]) * (d[i] / (d[i] - d[j]));
+		t[k] = dot(D, X[k]);
+	}
+	if (t[1] < t[0]) {
+		std::swap(t[0], t[1]);
+		std::swap(X[0], X[1]);
+	}
+	return true;
+}
+
+/**
+ * @brief Computes twice the signed area of a triangle @a a, @a b, @a c
+ * projected on the axes @a i and @a j.
+ */
+template<typename Vector>
+typename vector_traits<Vector>::value_type orientation_2d(const Vector& a,
+		const Vector& b, const Vector& c, std::size_t i, std::size_t j) {
+	return (b[i] - a[i]) * (c[j] - a[j]) - (b[j] - a[j]) * (c[i] - a[i]);
+}
+
+/**
+ * @brief Tests whether projected segments @a a0 @a a1 and @a b0 @a b1 meet,
+ * including their ends.
+ */
+template<typename Vector>
+bool segments_meet_2d(const Vector& a0, const Vector& a1, const Vector& b0,
+		const Vector& b1, std::size_t i, std::size_t j) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	const value_type s0 = orientation_2d(a0, a1, b0, i, j);
+	const value_type s1 = orientation_2d(a0, a1, b1, i, j);
+	const value_type s2 = orientation_2d(b0, b1, a0, i, j);
+	const value_type s3 = orientation_2d(b0, b1, a1, i, j);
+
+	if (s0 == Zero && s1 == Zero) {
+		// Collinear; the intervals on the longer axis overlap.
+		const std::size_t k =
+				(std::abs(a1[i] - a0[i]) < std::abs(a1[j] - a0[j])) ? j : i;
+		return !(std::max(a0[k], a1[k]) < std::min(b0[k], b1[k])
+				|| std::max(b0[k], b1[k]) < std::min(a0[k], a1[k]));
+	}
+
+	return !((s0 > Zero && s1 > Zero) || (s0 < Zero && s1 < Zero)
+			|| (s2 > Zero && s3 > Zero) || (s2 < Zero && s3 < Zero));
+}
+
+/**
+ * @brief Tests whether a projected point @a p is in a triangle @a x,
+ * including its boundary.
+ */
+template<typename Vector>
+bool contains_2d(const Vector* x, const Vector& p, std::size_t i,
+		std::size_t j) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	const value_type s0 = orientation_2d(x[0], x[1], p, i, j);
+	const value_type s1 = orientation_2d(x[1], x[2], p, i, j);
+	const value_type s2 = orientation_2d(x[2], x[0], p, i, j);
+	return !((s0 < Zero || s1 < Zero || s2 < Zero)
+			&& (s0 > Zero || s1 > Zero || s2 > Zero));
+}
+
+/**
+ * @brief Tests whether triangles @a x and @a y on a plane of a normal
+ * @a n overlap, projecting them on the axes other than the largest
+ * component of @a n.
+ */
+template<typename Vector>
+bool coplanar_triangles_overlap(const Vector* x, const Vector* y,
+		const Vector& n) {
+	std::size_t k = GK::X;
+	if (std::abs(n[GK::Y]) > std::abs(n[k])) {
+		k = GK::Y;
+	}
+	if (std::abs(n[GK::Z]) > std::abs(n[k])) {
+		k = GK::Z;
+	}
+	const std::size_t i = (k + 1) % GK::GK_3D;
+	const std::size_t j = (k + 2) % GK::GK_3D;
+
+	for (std::size_t a = 0; a < 3; ++a) {
+		for (std::size_t b = 0; b < 3; ++b) {
+			if (segments_meet_2d(x[a], x[(a + 1) % 3], y[b], y[(b + 1) % 3], i,
+					j)) {
+				return true;
+			}
+		}
+	}
+	return contains_2d(x, y[0], i, j) || contains_2d(y, x[0], i, j);
+}
+
+}  // namespace impl
+
+namespace alg {
+
+/**
+ * @brief Intersects two non-degenerate triangles in 3D by the interval
+ * method of Möller.
+ *
+ * The vertices of each triangle are classified by their signed distances to
+ * the plane of the other, which rejects most of the disjoint pairs. The
+ * triangles crossing both planes are cut to intervals on the line of
+ * intersection of the planes, and the overlap of the intervals is the
+ * segment. Coplanar triangles are tested in 2D on the axes other than the
+ * largest component of the normal.
+ *
+ * @param a0
+ * @param a1
+ * @param a2
+ * @param b0
+ * @param b1
+ * @param b2
+ * @param result The intersection, set if the triangles intersect.
+ * @return true if the triangles intersect, including touching.
+ */
+template<typename Vector>
+bool intersect_2triangles(const Vector& a0, const Vector& a1, const Vector& a2,
+		const Vector& b0, const Vector& b1, const Vector& b2,
+		triangle_overlap<Vector>& result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	const Vector x[] = { a0, a1, a2 };
+	const Vector y[] = { b0, b1, b2 };
+
+	const Vector m = cross<Vector>()(b1 - b0, b2 - b0);
+	value_type dx[3];
+	for (std::size_t i = 0; i < 3; ++i) {
+		dx[i] = dot(m, x[i] - b0);
+	}
+	if ((dx[0] > Zero && dx[1] > Zero && dx[2] > Zero)
+			|| (dx[0] < Zero && dx[1] < Zero && dx[2] < Zero)) {
+		return false;
+	}
+
+	const Vector n = cross<Vector>()(a1 - a0, a2 - a0);
+	if (dx[0] == Zero && dx[1] == Zero && dx[2] == Zero) {
+		if (!impl::coplanar_triangles_overlap(x, y, n)) {
+			return false;
+		}
+		result.coplanar = true;
+		return true;
+	}
+
+	value_type dy[3];
+	for (std::size_t i = 0; i < 3; ++i) {
+		dy[i] = dot(n, y[i] - a0);
+	}
+	if ((dy[0] > Zero && dy[1] > Zero && dy[2] > Zero)
+			|| (dy[0] < Zero && dy[1] < Zero && dy[2] < Zero)) {
+		return false;
+	}
+
+	const Vector D = cross<Vector>()(n, m);
+	value_type s[2];
+	value_type t[2];
+	Vector X[2];
+	Vector Y[2];
+	if (!impl::triangle_plane_interval(x, dx, D, s, X)
+			|| !impl::triangle_plane_interval(y, dy, D, t, Y)) {
+		// The planes are parallel within rounding.
+		return false;
+	}
+	if (s[1] < t[0] || t[1] < s[0]) {
+		return false;
+	}
+
+	result.coplanar = false;
+	result.start = (t[0] < s[0]) ? X[0] : Y[0];
+	result.end = (s[1] < t[1]) ? X[1] : Y[1];
+	return true;
+}
+
+}  // namespace alg
+
+/**
+ * @brief Computes the intersection of two triangles in 3D.
+ *
+ * @param a
+ * @param b
+ * @param result The intersection, set if the triangles intersect.
+ * @return true if the triangles intersect.
+ *
+ * @see alg::intersect_2triangles()
+ */
+template<typename Vector>
+bool intersect(const triangle<Vector>& a, const triangle<Vector>& b,
+		triangle_overlap<Vector>& result) {
+	typedef triangle<Vector> triangle_type;
+
+	return alg::intersect_2triangles(a[triangle_type::First],
+			a[triangle_type::Second], a[triangle_type::Third],
+			b[triangle_type::First], b[triangle_type::Second],
+			b[triangle_type::Third], result);
+}
+
+}  // namespace gk
+
+#endif /* ALGORITHM_TRIANGLE_OVERLAP_H_ */
@@ -8,9 +8,14 @@
 #ifndef BSPLINE_ALGORITHM_H_
 #define BSPLINE_ALGORITHM_H_
 
+#include <vector>
+#include <iterator>
+#include <limits>
+
 #include "bspline.h"
 #include "../primitive/line.h"
 #include "../algorithm/kernel.h"
+#include "../algorithm/roots.h"
 #include "../gkintersect.h"
 
 namespace gk {
@@ -74,11 +79,73 @@ OutputIterator intersect_bspline_segment(const bspline<Vector, Parameter>& a,
 	return result;
 }
 
+/**
+ * @brief Computes intersections of a B-spline and a hyperplane.
+ *
+ * The signed distances of the control points from the hyperplane are the
+ * coefficients of the signed distance of the curve, so the intersections
+ * are the roots of the scalar B-spline, found by alg::bspline_roots()
+ * without subdividing the curve.
+ *
+ * @param a
+ * @param reference A point on the hyperplane.
+ * @param normal The normal vector of the hyperplane.
+ * @param epsilon Tolerance to merge the intersections at a touch.
+ * @param result
+ * @return
+ */
+template<typename Vector, typename Parameter, typename Normal,
+		typename Tolerance, typename OutputIterator>
+OutputIterator intersect_bspline_hyperplane(const bspline<Vector, Parameter>& a,
+		const Vector& reference, const Normal& normal, const Tolerance& epsilon,
+		OutputIterator result) {
+	const std::size_t Dimension = vector_traits<Vector>::Dimension;
+	const std::size_t p = a.degree();
+	const typename bspline<Vector, Parameter>::control_points& Q = a.controls();
+
+	std::vector<Parameter> D(Q.size());
+	for (std::size_t i = 0; i < Q.size(); ++i) {
+		Parameter d = Parameter(GK_FLOAT_ZERO);
+		for (std::size_t k = 0; k < Dimension; ++k) {
+			d += normal[k] * (Q[i][k] - reference[k]);
+		}
+		D[i] = d;
+	}
+
+	const std::pair<Parameter, Parameter> domain = a.domain();
+	const Parameter tolerance = (domain.second - domain.first)
+			* std::numeric_limits<Parameter>::epsilon() * Parameter(16);
+
+	std::vector<Parameter> T;
+	alg::bspline_roots(p, a.knot_vector().begin(), a.knot_vector().end(),
+			D.begin(), tolerance, std::back_inserter(T));
+
+	bspl::basis_table<Parameter> N;
+	Vector last;
+	for (std::size_t i = 0; i < T.size(); ++i) {
+		const std::size_t i0 = N.compute(p, a.knot_vector().begin(),
+				a.knot_vector().end(), T[i]) - p;
+		Vector x = N(0, 0) * Q[i0];
+		for (std::size_t j = 1; j <= p; ++j) {
+			x += N(0, j) * Q[i0 + j];
+		}
+
+		if (i > 0 && norm(Vector(x - last)) <= epsilon) {
+			continue;
+		}
+		*result = x;
+		++result;
+		last = x;
+	}
+
+	return result;
+}
+
 template<typename Vector, typename Parameter, typename Line, typename Tolerance,
-		typename OutputIterator>
-OutputIterator intersect_kernel(const bspline<Vector, Parameter>& a,
+		typename OutputIterator, std::size_t Dimension>
+OutputIterator intersect_bspline_line(const bspline<Vector, Parameter>& a,
 		const Line& b, const Tolerance& epsilon, OutputIterator result,
-		line_tag) {
+		dimension_tag<Dimension>) {
 	typedef typename vector_traits<Vector>::value_type value_type;
 
 	const aabb<Vector> a_box = boundary(a);
@@ -104,6 +171,44 @@ OutputIterator intersect_kernel(const bspline<Vector, Parameter>& a,
 	}
 }
 
+/**
+ * @brief Computes intersections of a B-spline and a line in 2D, where the
+ * line is a hyperplane.
+ */
+template<typename Vector, typename Parameter, typename Line, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect_bspline_line(const bspline<Vector, Parameter>& a,
+		const Line& b, const Tolerance& epsilon, OutputIterator result,
+		dimension_tag<GK::GK_2D>) {
+	const direction<GK::GK_2D>& u = b.dir();
+
+	Vector n;
+	n[GK::X] = -u[GK::Y];
+	n[GK::Y] = u[GK::X];
+	return intersect_bspline_hyperplane(a, b.reference(), n, epsilon, result);
+}
+
+template<typename Vector, typename Parameter, typename Line, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect_kernel(const bspline<Vector, Parameter>& a,
+		const Line& b, const Tolerance& epsilon, OutputIterator result,
+		line_tag) {
+	return intersect_bspline_line(a, b, epsilon, result,
+			dimension_tag<vector_traits<Vector>::Dimension>());
+}
+
+/**
+ * @brief Computes intersections of a B-spline and a plane.
+ */
+template<typename Vector, typename Parameter, typename Plane,
+		typename Tolerance, typename OutputIterator>
+OutputIterator intersect_kernel(const bspline<Vector, Parameter>& a,
+		const Plane& b, const Tolerance& epsilon, OutputIterator result,
+		plane_tag) {
+	return intersect_bspline_hyperplane(a, b.reference(), b.normal(), epsilon,
+			result);
+}
+
 }  // namespace impl
 
 /**
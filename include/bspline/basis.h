@@ -10,6 +10,7 @@
 
 #include <gkdef.h>
 #include <vector>
+#include <memory>
 #include <algorithm>
 
 namespace gk {
@@ -49,6 +50,18 @@ size_t knot_vector_size(size_t degree, size_t control_points_size) {
 	return control_points_size + degree + 1;
 }
 
+/**
+ * @brief Returns the binomial coefficient @f$\binom{n}{k}@f$.
+ */
+template<typename T>
+T binomial(std::size_t n, std::size_t k) {
+	T c = T(GK_FLOAT_ONE);
+	for (std::size_t i = 1; i <= k; ++i) {
+		c = c * T(n - k + i) / T(i);
+	}
+	return c;
+}
+
 template<typename InputIterator>
 std::pair<typename std::iterator_traits<InputIterator>::value_type,
 		typename std::iterator_traits<InputIterator>::value_type> domain(
@@ -68,11 +81,12 @@ std::pair<typename std::iterator_traits<InputIterator>::value_type,
  * @author Takuya Makimoto
  * @date 2016/01/07
  */
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T> >
 class knotvector {
 public:
 	typedef T value_type;
-	typedef std::vector<T> container_type;
+	typedef Allocator allocator_type;
+	typedef std::vector<T, Allocator> container_type;
 
 	typedef typename container_type::const_reference const_reference;
 	typedef typename container_type::const_iterator const_iterator;
@@ -87,6 +101,10 @@ public:
 			X_(other.X_) {
 	}
 
+	explicit knotvector(const Allocator& allocator) :
+			X_(allocator) {
+	}
+
 	knotvector(std::size_t size) :
 			X_(size) {
 	}
@@ -100,6 +118,21 @@ public:
 	~knotvector() {
 	}
 
+	allocator_type get_allocator() const {
+		return this->X_.get_allocator();
+	}
+
+	/**
+	 * @brief Replaces the knots with [first, last), reusing the storage.
+	 * @param first
+	 * @param last
+	 */
+	template<typename InputIterator>
+	void assign(InputIterator first, InputIterator last) {
+		this->X_.assign(first, last);
+		std::stable_sort(this->X_.begin(), this->X_.end());
+	}
+
 	bool empty() const {
 		return this->X_.empty();
 	}
@@ -290,6 +323,216 @@ OutputRandomAccessIterator basis_function(size_t degree,
 	}
 }
 
+/**
+ * @brief Table of the non-zero basis functions and their derivatives on
+ * a knot span.
+ *
+ * Only the @f$p + 1@f$ functions @f$N_{i-p,p}, \dots, N_{i,p}@f$ which are
+ * non-zero on the span @f$[t_i, t_{i+1})@f$ are computed, so the cost
+ * depends on the degree and not on the number of control points. The
+ * buffers are kept between calls; an instance can be reused for many
+ * parameters without allocating.
+ *
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/18
+ */
+template<typename Parameter>
+class basis_table {
+public:
+	typedef Parameter value_type;
+
+public:
+	basis_table() :
+			degree_(), order_(), span_(), ndu_(), a_(), left_(), right_(), ders_() {
+	}
+
+	basis_table(const basis_table& other) :
+			degree_(other.degree_), order_(other.order_), span_(other.span_), ndu_(
+					other.ndu_), a_(other.a_), left_(other.left_), right_(
+					other.right_), ders_(other.ders_) {
+	}
+
+	~basis_table() {
+	}
+
+	/**
+	 * @brief Returns the degree of the last computation.
+	 */
+	size_t degree() const {
+		return this->degree_;
+	}
+
+	/**
+	 * @brief Returns the derivative order of the last computation.
+	 */
+	size_t derivative_order() const {
+		return this->order_;
+	}
+
+	/**
+	 * @brief Returns the index of the knot span of the last computation.
+	 * The first non-zero basis function is @f$N_{span - p}@f$.
+	 */
+	size_t span() const {
+		return this->span_;
+	}
+
+	/**
+	 * @brief Computes the basis functions and their derivatives up to
+	 * @a dorder at a parameter @a t.
+	 *
+	 * @param degree Degree of the basis function.
+	 * @param first The beginning of the knot vector.
+	 * @param last The end of the knot vector.
+	 * @param t Parameter.
+	 * @param dorder Derivative order.
+	 * @return The index of the knot span.
+	 */
+	template<typename RandomAccessIterator>
+	size_t compute(size_t degree, RandomAccessIterator first,
+			RandomAccessIterator last, const Parameter& t, size_t dorder = 0) {
+		const size_t span = std::distance(first,
+				segment_of(degree, first, last, t));
+		this->compute(degree, first, span, t, dorder);
+		return span;
+	}
+
+	/**
+	 * @brief Computes the basis functions and their derivatives on a known
+	 * knot span.
+	 *
+	 * @param degree Degree of the basis function.
+	 * @param T The beginning of the knot vector.
+	 * @param span Index of the knot span which includes @a t.
+	 * @param t Parameter.
+	 * @param dorder Derivative order.
+	 */
+	template<typename RandomAccessIterator>
+	void compute(size_t degree, RandomAccessIterator T, size_t span,
+			const Parameter& t, size_t dorder) {
+		const Parameter Zero = Parameter(GK_FLOAT_ZERO);
+		const Parameter One = Parameter(GK_FLOAT_ONE);
+
+		const size_t p = degree;
+		const size_t order = p + 1;
+
+		this->degree_ = degree;
+		this->order_ = dorder;
+		this->span_ = span;
+
+		this->ndu_.resize(order * order);
+		this->a_.resize(2 * order);
+		this->left_.resize(order);
+		this->right_.resize(order);
+		this->ders_.assign((dorder + 1) * order, Zero);
+
+		// Basis functions and knot differences (The NURBS Book, A2.3).
+		this->ndu_[0] = One;
+		for (size_t j = 1; j <= p; ++j) {
+			this->left_[j] = t - T[span + 1 - j];
+			this->right_[j] = T[span + j] - t;
+
+			Parameter saved = Zero;
+			for (size_t r = 0; r < j; ++r) {
+				this->ndu_[j * order + r] = this->right_[r + 1]
+						+ this->left_[j - r];
+				const Parameter temp = this->ndu_[r * order + j - 1]
+						/ this->ndu_[j * order + r];
+				this->ndu_[r * order + j] = saved + this->right_[r + 1] * temp;
+				saved = this->left_[j - r] * temp;
+			}
+			this->ndu_[j * order + j] = saved;
+		}
+
+		for (size_t j = 0; j <= p; ++j) {
+			this->ders_[j] = this->ndu_[j * order + p];
+		}
+
+		// Derivatives higher than the degree vanish.
+		const size_t n = std::min(dorder, p);
+		for (size_t r = 0; r <= p; ++r) {
+			Parameter* a1 = &this->a_[0];
+			Parameter* a2 = &this->a_[order];
+			a1[0] = One;
+
+			for (size_t k = 1; k <= n; ++k) {
+				Parameter d = Zero;
+				const size_t pk = p - k;
+
+				if (r >= k) {
+					const size_t rk = r - k;
+					a2[0] = a1[0] / this->ndu_[(pk + 1) * order + rk];
+					d = a2[0] * this->ndu_[rk * order + pk];
+				}
+
+				const size_t j1 = (r + 1 >= k) ? 1 : k - r;
+				const size_t j2 = (r <= pk + 1) ? k - 1 : p - r;
+				for (size_t j = j1; j <= j2; ++j) {
+					const size_t rkj = r + j - k;
+					a2[j] = (a1[j] - a1[j - 1])
+							/ this->ndu_[(pk + 1) * order + rkj];
+					d += a2[j] * this->ndu_[rkj * order + pk];
+				}
+
+				if (r <= pk) {
+					a2[k] = -a1[k - 1] / this->ndu_[(pk + 1) * order + r];
+					d += a2[k] * this->ndu_[r * order + pk];
+				}
+
+				this->ders_[k * order + r] = d;
+				std::swap(a1, a2);
+			}
+		}
+
+		Parameter factor = Parameter(p);
+		for (size_t k = 1; k <= n; ++k) {
+			for (size_t j = 0; j <= p; ++j) {
+				this->ders_[k * order + j] *= factor;
+			}
+			factor *= Parameter(p - k);
+		}
+	}
+
+	/**
+	 * @brief Returns the @a k th derivative of the @a j th non-zero basis
+	 * function, @f$N^{(k)}_{span - p + j}@f$.
+	 * @param k Derivative order.
+	 * @param j Local index in @f$[0, p]@f$.
+	 */
+	const Parameter& operator()(size_t k, size_t j) const {
+		return this->ders_[k * (this->degree_ + 1) + j];
+	}
+
+	basis_table& operator=(const basis_table& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->degree_ = rhs.degree_;
+		this->order_ = rhs.order_;
+		this->span_ = rhs.span_;
+		this->ndu_ = rhs.ndu_;
+		this->a_ = rhs.a_;
+		this->left_ = rhs.left_;
+		this->right_ = rhs.right_;
+		this->ders_ = rhs.ders_;
+
+		return *this;
+	}
+
+private:
+	size_t degree_;
+	size_t order_;
+	size_t span_;
+
+	std::vector<Parameter> ndu_; ///< Basis functions and knot differences.
+	std::vector<Parameter> a_; ///< Two rows of the derivative coefficients.
+	std::vector<Parameter> left_;
+	std::vector<Parameter> right_;
+	std::vector<Parameter> ders_; ///< Derivatives in [k][j] order.
+};
+
 }  // namespace bspl
 
 } // namespace gk
@@ -257,7 +257,8 @@ private:
 		}
 
 		// section number
-		const size_t k = knot_segment(this->T_, degree, t);
+		const size_t k = bspl::segment_of(degree, this->T_.begin(),
+				this->T_.end(), t) - this->T_.begin();
 
 		this->Q_.insert(this->Q_.begin() + k, this->Q_[k]);
 
@@ -8,11 +8,25 @@
 #ifndef INCLUDE_BSPLINE_BSURFACE_H_
 #define INCLUDE_BSPLINE_BSURFACE_H_
 
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
 #include "basis.h"
 
 namespace gk {
 
-template<typename Vector>
+/**
+ * @brief Network of control points of a surface.
+ *
+ * The points are stored in one array, major index first.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Allocator Type of an allocator of the points.
+ */
+template<typename Vector, typename Allocator = std::allocator<Vector> >
 class network {
 public:
 	typedef Vector* iterator;
@@ -20,6 +34,9 @@ public:
 	typedef std::reverse_iterator<iterator> reverse_iterator;
 	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
+	typedef Allocator allocator_type;
+	typedef std::vector<Vector, Allocator> container_type;
+
 public:
 
 	network() :
@@ -30,8 +47,14 @@ public:
 			major_size_(other.major_size_), Q_(other.Q_) {
 	}
 
-	network(std::size_t major_size, std::size_t minor_size) :
-			major_size_(major_size), Q_(major_size * minor_size) {
+	explicit network(const Allocator& allocator) :
+			major_size_(), Q_(allocator) {
+	}
+
+	network(std::size_t major_size, std::size_t minor_size,
+			const Allocator& allocator = Allocator()) :
+			major_size_(major_size), Q_(major_size * minor_size, Vector(),
+					allocator) {
 	}
 
 	template<typename InputIterator>
@@ -42,6 +65,10 @@ public:
 	~network() {
 	}
 
+	allocator_type get_allocator() const {
+		return this->Q_.get_allocator();
+	}
+
 	std::size_t major_size() const {
 		return this->major_size_;
 	}
@@ -50,6 +77,95 @@ public:
 		return this->minor_size_();
 	}
 
+	/**
+	 * @brief Returns the number of the control points.
+	 */
+	std::size_t size() const {
+		return this->Q_.size();
+	}
+
+	const_iterator begin() const {
+		return this->data();
+	}
+
+	iterator begin() {
+		return this->data();
+	}
+
+	const_iterator end() const {
+		return this->data() + this->Q_.size();
+	}
+
+	iterator end() {
+		return this->data() + this->Q_.size();
+	}
+
+	const Vector* data() const {
+		return (this->Q_.empty()) ? 0 : &this->Q_[0];
+	}
+
+	Vector* data() {
+		return (this->Q_.empty()) ? 0 : &this->Q_[0];
+	}
+
+	/**
+	 * @brief Changes the sizes. The storage is kept when it shrinks, and
+	 * the points are not preserved.
+	 * @param major_size
+	 * @param minor_size
+	 */
+	void resize(std::size_t major_size, std::size_t minor_size) {
+		this->major_size_ = major_size;
+		this->Q_.resize(major_size * minor_size);
+	}
+
+	/**
+	 * @brief Replaces the points with the block
+	 * [major_first, major_last) @f$\times@f$ [minor_first, minor_last) of
+	 * @a other. @a other may be this network.
+	 *
+	 * @param other
+	 * @param major_first
+	 * @param major_last
+	 * @param minor_first
+	 * @param minor_last
+	 */
+	void assign(const network& other, std::size_t major_first,
+			std::size_t major_last, std::size_t minor_first,
+			std::size_t minor_last) {
+		const std::size_t m = major_last - major_first;
+		const std::size_t n = minor_last - minor_first;
+
+		if (&other == this) {
+			// Each point moves to a lower index, so the forward copy
+			// works in place.
+			for (std::size_t j = 0; j < n; ++j) {
+				for (std::size_t i = 0; i < m; ++i) {
+					this->Q_[i + j * m] = this->Q_[other.element_index_(
+							major_first + i, minor_first + j)];
+				}
+			}
+			this->Q_.resize(m * n);
+			this->major_size_ = m;
+			return;
+		}
+
+		this->resize(m, n);
+		for (std::size_t j = 0; j < n; ++j) {
+			std::copy(
+					other.Q_.begin()
+							+ other.element_index_(major_first, minor_first + j),
+					other.Q_.begin()
+							+ other.element_index_(major_last, minor_first + j),
+					this->Q_.begin() + j * m);
+		}
+	}
+
+	void swap(network& other) {
+		std::swap(this->major_size_, other.major_size_);
+		this->Q_.swap(other.Q_);
+	}
+
 	const Vector& operator()(std::size_t major, std::size_t minor) const {
 		return this->Q_[this->element_index_(major, minor)];
 	}
@@ -71,11 +187,11 @@ public:
 
 private:
 	std::size_t major_size_;
-	std::vector<Vector> Q_;
+	container_type Q_;
 
 private:
 	std::size_t minor_size_() const {
-		return this->Q_.size() - this->major_size_;
+		return (this->major_size_ == 0) ? 0 : this->Q_.size() / this->major_size_;
 	}
 
 	std::size_t element_index_(std::size_t major, std::size_t minor) const {
@@ -83,15 +199,221 @@ private:
 	}
 };
 
+namespace impl {
+
+/**
+ * @brief Lines of control points of a network in one direction.
+ *
+ * The point @a i on the line @a k is at <tt>data[i * step + k * stride]</tt>.
+ */
+template<typename Vector>
+struct network_lines {
+	Vector* data;
+	std::size_t step; ///< The distance between points on a line.
+	std::size_t stride; ///< The distance between lines.
+	std::size_t size; ///< The number of the lines.
+
+	Vector& operator()(std::size_t i, std::size_t k) const {
+		return this->data[i * this->step + k * this->stride];
+	}
+};
+
+template<typename Vector>
+network_lines<Vector> make_network_lines(Vector* data, std::size_t step,
+		std::size_t stride, std::size_t size) {
+	const network_lines<Vector> lines = { data, step, stride, size };
+	return lines;
+}
+
+/**
+ * @brief Inserts knots into all the lines of a network at once
+ * (The NURBS Book, A5.4).
+ *
+ * Each step of the algorithm is applied to every line before the next one,
+ * so the knot vector is walked once, and the innermost loops are contiguous
+ * when the lines are adjacent in memory.
+ *
+ * @param p Degree in the direction of the lines.
+ * @param U The knot vector of @a n + @a p + 1 knots.
+ * @param n The number of the points on a line.
+ * @param X The sorted knots to insert, in the interior of the domain.
+ * @param r The number of the knots to insert.
+ * @param P The lines of @a n points.
+ * @param Ubar The beginning of the @a n + @a p + 1 + @a r refined knots.
+ * @param Q The lines of @a n + @a r refined points.
+ */
+template<typename Vector, typename KnotIterator, typename Parameter,
+		typename KnotOutputIterator>
+void refine_network_lines(std::size_t p, KnotIterator U, std::size_t n,
+		const Parameter* X, std::size_t r, network_lines<const Vector> P,
+		KnotOutputIterator Ubar, network_lines<Vector> Q) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::size_t L = P.size;
+	const std::size_t m = n + p;
+
+	const std::size_t a = std::min(std::max<std::size_t>(
+			std::upper_bound(U, U + m + 1, X[0]) - U, p + 1) - 1, n - 1);
+	const std::size_t b = std::min(std::max<std::size_t>(
+			std::upper_bound(U, U + m + 1, X[r - 1]) - U, p + 1) - 1, n - 1)
+			+ 1;
+
+	for (std::size_t j = 0; j <= a - p; ++j) {
+		for (std::size_t k = 0; k < L; ++k) {
+			Q(j, k) = P(j, k);
+		}
+	}
+	for (std::size_t j = b - 1; j < n; ++j) {
+		for (std::size_t k = 0; k < L; ++k) {
+			Q(j + r, k) = P(j, k);
+		}
+	}
+	for (std::size_t j = 0; j <= a; ++j) {
+		Ubar[j] = U[j];
+	}
+	for (std::size_t j = b + p; j <= m; ++j) {
+		Ubar[j + r] = U[j];
+	}
+
+	std::size_t i = b + p - 1;
+	std::size_t k = b + p + r - 1;
+	for (std::size_t j = r; j-- > 0;) {
+		while (X[j] <= U[i] && i > a) {
+			for (std::size_t h = 0; h < L; ++h) {
+				Q(k - p - 1, h) = P(i - p - 1, h);
+			}
+			Ubar[k] = U[i];
+			--k;
+			--i;
+		}
+
+		for (std::size_t h = 0; h < L; ++h) {
+			Q(k - p - 1, h) = Q(k - p, h);
+		}
+		for (std::size_t l = 1; l <= p; ++l) {
+			const std::size_t index = k - p + l;
+			Parameter alpha = Ubar[k + l] - X[j];
+			if (alpha == Parameter(0)) {
+				for (std::size_t h = 0; h < L; ++h) {
+					Q(index - 1, h) = Q(index, h);
+				}
+			} else {
+				alpha /= Ubar[k + l] - U[i - p + l];
+				const Parameter beta = Parameter(1) - alpha;
+				for (std::size_t h = 0; h < L; ++h) {
+					Q(index - 1, h) = value_type(alpha) * Q(index - 1, h)
+							+ value_type(beta) * Q(index, h);
+				}
+			}
+		}
+
+		Ubar[k] = X[j];
+		--k;
+	}
+}
+
+/**
+ * @brief Decomposes all the lines of a network in one direction into
+ * Bézier segments (The NURBS Book, A5.6).
+ *
+ * The knot vector must be clamped. A knot of multiplicity more than @a p
+ * separates the segments as one of multiplicity @a p does.
+ *
+ * @param p Degree in the direction of the lines.
+ * @param U The knot vector of @a n + @a p + 1 knots.
+ * @param n The number of the points on a line.
+ * @param P The lines of @a n points.
+ * @param Q The lines of @f$(p + 1)@f$ points for each non-empty knot span.
+ */
+template<typename Vector, typename KnotIterator>
+void decompose_network_lines(std::size_t p, KnotIterator U, std::size_t n,
+		network_lines<const Vector> P, network_lines<Vector> Q) {
+	typedef typename std::iterator_traits<KnotIterator>::value_type Parameter;
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::size_t L = P.size;
+	const std::size_t m = n + p;
+
+	std::vector<Parameter> alpha(p + 1);
+
+	std::size_t a = p;
+	std::size_t b = p + 1;
+	std::size_t offset = 0;
+
+	for (std::size_t i = 0; i <= p; ++i) {
+		for (std::size_t h = 0; h < L; ++h) {
+			Q(i, h) = P(i, h);
+		}
+	}
+
+	while (b < m) {
+		const std::size_t i = b;
+		while (b < m && U[b + 1] == U[b]) {
+			++b;
+		}
+		const std::size_t multiplicity = std::min(b - i + 1, p);
+
+		if (multiplicity < p) {
+			const Parameter numerator = U[b] - U[a];
+			for (std::size_t j = p; j > multiplicity; --j) {
+				alpha[j - multiplicity - 1] = numerator / (U[a + j] - U[a]);
+			}
+
+			const std::size_t r = p - multiplicity;
+			for (std::size_t j = 1; j <= r; ++j) {
+				const std::size_t save = r - j;
+				const std::size_t s = multiplicity + j;
+				for (std::size_t k = p; k >= s; --k) {
+					const Parameter w = alpha[k - s];
+					for (std::size_t h = 0; h < L; ++h) {
+						Q(offset + k, h) = value_type(w) * Q(offset + k, h)
+								+ value_type(Parameter(1) - w)
+										* Q(offset + k - 1, h);
+					}
+				}
+				if (b < m) {
+					for (std::size_t h = 0; h < L; ++h) {
+						Q(offset + p + 1 + save, h) = Q(offset + p, h);
+					}
+				}
+			}
+		}
+
+		offset += p + 1;
+		if (b < m) {
+			for (std::size_t j = p - multiplicity; j <= p; ++j) {
+				for (std::size_t h = 0; h < L; ++h) {
+					Q(offset + j, h) = P(b - p + j, h);
+				}
+			}
+			a = b;
+			++b;
+		}
+	}
+}
+
+}  // namespace impl
+
 /**
  * @brief B-spline surface.
  *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ * @tparam Allocator Type of an allocator of the control points, rebound for
+ * the knots. A pool allocator keeps repeated refinement and subdivision off
+ * the global heap.
+ *
  * @date 2016/04/06
  */
-template<typename Vector, typename Parameter>
+template<typename Vector, typename Parameter,
+		typename Allocator = std::allocator<Vector> >
 class bsurface {
 public:
 	typedef Vector vector_type;
+	typedef Allocator allocator_type;
+	typedef typename rebind_allocator<Allocator, Parameter>::type parameter_allocator_type;
+	typedef bspl::knotvector<Parameter, parameter_allocator_type> knotvector_type;
+	typedef network<Vector, Allocator> network_type;
 
 public:
 	bsurface() :
@@ -102,17 +424,53 @@ public:
 			S_(other.S_), T_(other.T_), Q_(other.Q_) {
 	}
 
+	explicit bsurface(const Allocator& allocator) :
+			S_(parameter_allocator_type(allocator)), T_(
+					parameter_allocator_type(allocator)), Q_(allocator) {
+	}
+
+	/**
+	 * @brief
+	 * @param S_first The beginning of the knot vector in major order.
+	 * @param S_last The end of the knot vector in major order.
+	 * @param T_first The beginning of the knot vector in minor order.
+	 * @param T_last The end of the knot vector in minor order.
+	 * @param Q_first The beginning of the control points, major index first.
+	 * @param Q_last The end of the control points.
+	 * @param major_size The number of the control points in major order.
+	 */
 	template<typename KnotInputIterator1, typename KnotInputIterator2,
 			typename VectorInputIterator>
 	bsurface(KnotInputIterator1 S_first, KnotInputIterator1 S_last,
 			KnotInputIterator2 T_first, KnotInputIterator2 T_last,
-			VectorInputIterator Q_first, VectorInputIterator Q_last) :
-			S_(S_first, S_last), T_(T_first, T_last), Q_(Q_first, Q_last) {
+			VectorInputIterator Q_first, VectorInputIterator Q_last,
+			std::size_t major_size) :
+			S_(S_first, S_last), T_(T_first, T_last), Q_(Q_first, Q_last,
+					major_size) {
+	}
+
+	/**
+	 * @brief
+	 * @param S_first The beginning of the knot vector in major order.
+	 * @param S_last The end of the knot vector in major order.
+	 * @param T_first The beginning of the knot vector in minor order.
+	 * @param T_last The end of the knot vector in minor order.
+	 * @param Q The control points.
+	 */
+	template<typename KnotInputIterator1, typename KnotInputIterator2>
+	bsurface(KnotInputIterator1 S_first, KnotInputIterator1 S_last,
+			KnotInputIterator2 T_first, KnotInputIterator2 T_last,
+			const network_type& Q) :
+			S_(S_first, S_last), T_(T_first, T_last), Q_(Q) {
 	}
 
 	~bsurface() {
 	}
 
+	allocator_type get_allocator() const {
+		return this->Q_.get_allocator();
+	}
+
 	std::size_t major_degree() const {
 		return this->major_degree_();
 	}
@@ -122,27 +480,254 @@ public:
 	}
 
 	/**
+	 * @brief Returns the knot vector in major order.
+	 */
+	const knotvector_type& major_knot_vector() const {
+		return this->S_;
+	}
+
+	/**
+	 * @brief Returns the knot vector in minor order.
+	 */
+	const knotvector_type& minor_knot_vector() const {
+		return this->T_;
+	}
+
+	/**
+	 * @brief Returns the parameter domain in major order.
+	 */
+	std::pair<Parameter, Parameter> major_domain() const {
+		return bspl::domain(this->major_degree_(), this->S_.begin(),
+				this->S_.end());
+	}
+
+	/**
+	 * @brief Returns the parameter domain in minor order.
+	 */
+	std::pair<Parameter, Parameter> minor_domain() const {
+		return bspl::domain(this->minor_degree_(), this->T_.begin(),
+				this->T_.end());
+	}
+
+	/**
+	 * @brief Returns the control points.
+	 */
+	const network_type& controls() const {
+		return this->Q_;
+	}
+
+	/**
+	 * @brief Returns the mutable control points.
+	 */
+	network_type& controls() {
+		return this->Q_;
+	}
+
+	/**
+	 * @brief Inserts a knot in major order without changing the shape.
+	 * @param s Knot in the interior of the domain.
+	 * @param multiplicity The number of the insertions.
+	 */
+	void insert_major(const Parameter& s, std::size_t multiplicity = 1) {
+		const std::vector<Parameter> X(multiplicity, s);
+		this->refine_(X.begin(), X.end(), true);
+	}
+
+	/**
+	 * @brief Inserts a knot in minor order without changing the shape.
+	 * @param t Knot in the interior of the domain.
+	 * @param multiplicity The number of the insertions.
+	 */
+	void insert_minor(const Parameter& t, std::size_t multiplicity = 1) {
+		const std::vector<Parameter> X(multiplicity, t);
+		this->refine_(X.begin(), X.end(), false);
+	}
+
+	/**
+	 * @brief Inserts knots in major order at once (knot refinement).
 	 *
-	 * @param s
-	 * @param t
-	 * @return
+	 * All the rows of the network are refined in one pass, which costs
+	 * far less than inserting the knots one by one. The knots out of the
+	 * interior of the domain are ignored.
+	 *
+	 * @param first The beginning of the knots.
+	 * @param last The end of the knots.
 	 */
-	Vector operator()(const Parameter& s, const Parameter& t) const {
-		std::vector<gkfloat> M;
-		bspl::basis_function(this->major_degree_(), this->S_.begin(),
-				this->S_.end(), s, std::inserter(M, M.begin()));
+	template<typename InputIterator>
+	void refine_major(InputIterator first, InputIterator last) {
+		this->refine_(first, last, true);
+	}
 
-		std::vector<gkfloat> N;
-		bspl::basis_function(this->minor_degree_(), this->T_.begin(),
-				this->T_.end(), t, std::inserter(N, N.begin()));
+	/**
+	 * @brief Inserts knots in minor order at once (knot refinement).
+	 * @param first The beginning of the knots.
+	 * @param last The end of the knots.
+	 * @see refine_major(InputIterator, InputIterator)
+	 */
+	template<typename InputIterator>
+	void refine_minor(InputIterator first, InputIterator last) {
+		this->refine_(first, last, false);
+	}
 
-		Vector r;
-		for (std::size_t i = 0; i < M.size(); ++i) {
-			for (std::size_t j = 0; j < N.size(); ++j) {
-				r += M[i] * N[j] * this->Q_(i, j);
+	/**
+	 * @brief Subdivides this at a parameter @a s in major order.
+	 *
+	 * @param s Parameter to subdivide.
+	 * @param selection The part to return; this keeps the other.
+	 *
+	 * @return The other, or an empty surface if @a s is not in the interior
+	 * of the domain.
+	 */
+	bsurface subdivide_major(const Parameter& s,
+			gkselection selection = GK::Upper) {
+		bsurface other(this->Q_.get_allocator());
+		this->subdivide_(s, true, selection, other);
+		return other;
+	}
+
+	/**
+	 * @brief Subdivides this at @a s in major order into @a other, reusing
+	 * the storage of @a other.
+	 * @param s Parameter to subdivide.
+	 * @param other Receives the part of @a selection.
+	 * @param selection
+	 */
+	void subdivide_major(const Parameter& s, bsurface& other,
+			gkselection selection = GK::Upper) {
+		this->subdivide_(s, true, selection, other);
+	}
+
+	/**
+	 * @brief Subdivides this at a parameter @a t in minor order.
+	 *
+	 * @param t Parameter to subdivide.
+	 * @param selection The part to return; this keeps the other.
+	 *
+	 * @return The other, or an empty surface if @a t is not in the interior
+	 * of the domain.
+	 */
+	bsurface subdivide_minor(const Parameter& t,
+			gkselection selection = GK::Upper) {
+		bsurface other(this->Q_.get_allocator());
+		this->subdivide_(t, false, selection, other);
+		return other;
+	}
+
+	/**
+	 * @brief Subdivides this at @a t in minor order into @a other, reusing
+	 * the storage of @a other.
+	 * @param t Parameter to subdivide.
+	 * @param other Receives the part of @a selection.
+	 * @param selection
+	 */
+	void subdivide_minor(const Parameter& t, bsurface& other,
+			gkselection selection = GK::Upper) {
+		this->subdivide_(t, false, selection, other);
+	}
+
+	/**
+	 * @brief Computes the partial derivatives
+	 * @f$\mathbf{S}_{s^k t^l} = \partial^{k+l}\mathbf{S} / \partial s^k \partial t^l@f$
+	 * for all @f$k + l \le d@f$ at @f$(s, t)@f$.
+	 *
+	 * The knot spans are located once and one table of the basis functions
+	 * and their derivatives is computed for each direction, so all the
+	 * derivatives are obtained in a single pass.
+	 *
+	 * @param s Parameter in major order.
+	 * @param t Parameter in minor order.
+	 * @param d The maximum total derivative order.
+	 * @param out The beginning of @f$(d + 1)^2@f$ vectors. The derivative
+	 * @f$\mathbf{S}_{s^k t^l}@f$ is stored at <tt>out[k * (d + 1) + l]</tt>,
+	 * and the elements of @f$k + l > d@f$ are zero vectors.
+	 * @return The end of the output.
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& s, const Parameter& t,
+			std::size_t d, RandomAccessIterator out) const {
+		bspl::basis_table<Parameter> M;
+		bspl::basis_table<Parameter> N;
+		return this->derivatives(s, t, d, out, M, N);
+	}
+
+	/**
+	 * @brief Computes the partial derivatives with tables given by a caller.
+	 *
+	 * This overload is for loops evaluating the surface many times; the
+	 * tables keep their buffers between calls.
+	 *
+	 * @param s Parameter in major order.
+	 * @param t Parameter in minor order.
+	 * @param d The maximum total derivative order.
+	 * @param out The beginning of @f$(d + 1)^2@f$ vectors.
+	 * @param M Work table of the basis functions in major order.
+	 * @param N Work table of the basis functions in minor order.
+	 * @return The end of the output.
+	 * @see derivatives(const Parameter&, const Parameter&, std::size_t, RandomAccessIterator) const
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& s, const Parameter& t,
+			std::size_t d, RandomAccessIterator out,
+			bspl::basis_table<Parameter>& M,
+			bspl::basis_table<Parameter>& N) const {
+		typedef typename vector_traits<Vector>::value_type value_type;
+
+		const std::size_t p = this->major_degree_();
+		const std::size_t q = this->minor_degree_();
+		const std::size_t du = std::min(d, p);
+		const std::size_t dv = std::min(d, q);
+
+		std::fill(out, out + (d + 1) * (d + 1), zero_vector<Vector>());
+
+		const std::size_t i0 = M.compute(p, this->S_.begin(), this->S_.end(),
+				s, du) - p;
+		const std::size_t j0 = N.compute(q, this->T_.begin(), this->T_.end(),
+				t, dv) - q;
+
+		for (std::size_t k = 0; k <= du; ++k) {
+			const std::size_t dd = std::min(d - k, dv);
+
+			for (std::size_t j = 0; j <= q; ++j) {
+				// Contracts the major direction once for each column, then
+				// distributes it to all the derivatives in minor order.
+				Vector column = value_type(M(k, 0)) * this->Q_(i0, j0 + j);
+				for (std::size_t i = 1; i <= p; ++i) {
+					column += value_type(M(k, i)) * this->Q_(i0 + i, j0 + j);
+				}
+
+				for (std::size_t l = 0; l <= dd; ++l) {
+					out[k * (d + 1) + l] += value_type(N(l, j)) * column;
+				}
 			}
 		}
 
+		return out + (d + 1) * (d + 1);
+	}
+
+	/**
+	 * @brief Computes the unit normal vector at @f$(s, t)@f$,
+	 * @f$\mathbf{S}_s \times \mathbf{S}_t / |\mathbf{S}_s \times \mathbf{S}_t|@f$.
+	 * @param s Parameter in major order.
+	 * @param t Parameter in minor order.
+	 * @return
+	 */
+	direction<vector_traits<Vector>::Dimension> normal(const Parameter& s,
+			const Parameter& t) const {
+		const std::size_t d = 1;
+		Vector D[(d + 1) * (d + 1)];
+		this->derivatives(s, t, d, D);
+		return normal_direction(D[1 * (d + 1) + 0], D[0 * (d + 1) + 1]);
+	}
+
+	/**
+	 * @brief Computes the position at @f$(s, t)@f$.
+	 * @param s Parameter in major order.
+	 * @param t Parameter in minor order.
+	 * @return
+	 */
+	Vector operator()(const Parameter& s, const Parameter& t) const {
+		Vector r;
+		this->derivatives(s, t, 0, &r);
 		return r;
 	}
 
@@ -159,20 +744,188 @@ public:
 	}
 
 private:
-	bspl::knotvector<Parameter> S_; ///< The knot vector in major order.
-	bspl::knotvector<Parameter> T_; ///< The knot vector in minor order.
-	network<Vector> Q_; ///< The control points.
+	knotvector_type S_; ///< The knot vector in major order.
+	knotvector_type T_; ///< The knot vector in minor order.
+	network_type Q_; ///< The control points.
 
 private:
+	typedef std::vector<Parameter, parameter_allocator_type> parameter_container_type;
+
+	template<typename InputIterator>
+	void refine_(InputIterator first, InputIterator last, bool major) {
+		parameter_container_type X(first, last,
+				parameter_allocator_type(this->Q_.get_allocator()));
+		std::sort(X.begin(), X.end());
+
+		const std::pair<Parameter, Parameter> D =
+				(major) ? this->major_domain() : this->minor_domain();
+		typename parameter_container_type::iterator lower = std::upper_bound(
+				X.begin(), X.end(), D.first);
+		typename parameter_container_type::iterator upper = std::lower_bound(
+				lower, X.end(), D.second);
+		const std::size_t r = upper - lower;
+		if (r == 0) {
+			return;
+		}
+
+		knotvector_type& U = (major) ? this->S_ : this->T_;
+		const std::size_t p =
+				(major) ? this->major_degree_() : this->minor_degree_();
+		const std::size_t M = this->Q_.major_size();
+		const std::size_t N = this->Q_.minor_size();
+
+		network_type R((major) ? M + r : M, (major) ? N : N + r,
+				this->Q_.get_allocator());
+		parameter_container_type Ubar(U.size() + r, Parameter(),
+				parameter_allocator_type(this->Q_.get_allocator()));
+
+		const Vector* P = this->Q_.data();
+		if (major) {
+			impl::refine_network_lines(p, U.begin(), M, &*lower, r,
+					impl::make_network_lines(P, 1, M, N), Ubar.begin(),
+					impl::make_network_lines(R.data(), 1, M + r, N));
+		} else {
+			impl::refine_network_lines(p, U.begin(), N, &*lower, r,
+					impl::make_network_lines(P, M, 1, M), Ubar.begin(),
+					impl::make_network_lines(R.data(), M, 1, M));
+		}
+
+		U.assign(Ubar.begin(), Ubar.end());
+		this->Q_.swap(R);
+	}
+
+	void subdivide_(const Parameter& s, bool major, gkselection selection,
+			bsurface& other) {
+		if (this->Q_.size() == 0) {
+			other = bsurface(this->Q_.get_allocator());
+			return;
+		}
+
+		const std::pair<Parameter, Parameter> D =
+				(major) ? this->major_domain() : this->minor_domain();
+		if (!(D.first < s && s < D.second)) {
+			other = bsurface(this->Q_.get_allocator());
+			return;
+		}
+
+		const std::size_t p =
+				(major) ? this->major_degree_() : this->minor_degree_();
+		const knotvector_type& U = (major) ? this->S_ : this->T_;
+
+		const std::size_t multiplicity = std::upper_bound(U.begin(), U.end(),
+				s) - std::lower_bound(U.begin(), U.end(), s);
+		if (multiplicity < p) {
+			const std::vector<Parameter> X(p - multiplicity, s);
+			this->refine_(X.begin(), X.end(), major);
+		}
+
+		const std::size_t a = std::lower_bound(U.begin(), U.end(), s)
+				- U.begin();
+		const std::size_t e = std::upper_bound(U.begin(), U.end(), s)
+				- U.begin();
+
+		const bool lower = (selection != GK::Upper);
+		extract_(*this, major, lower, a, e, s, other);
+		extract_(*this, major, !lower, a, e, s, *this);
+	}
+
+	/**
+	 * @brief Extracts one side of a knot @a s of multiplicity @a p or more
+	 * at [a, e) into @a y. @a y may be @a x.
+	 */
+	static void extract_(const bsurface& x, bool major, bool lower,
+			std::size_t a, std::size_t e, const Parameter& s, bsurface& y) {
+		const std::size_t p = (major) ? x.major_degree_() : x.minor_degree_();
+		const knotvector_type& U = (major) ? x.S_ : x.T_;
+		const std::size_t M = x.Q_.major_size();
+		const std::size_t N = x.Q_.minor_size();
+
+		parameter_container_type K(
+				parameter_allocator_type(x.Q_.get_allocator()));
+		std::size_t first;
+		std::size_t last;
+		if (lower) {
+			K.reserve(a + p + 1);
+			K.assign(U.begin(), U.begin() + a);
+			K.insert(K.end(), p + 1, s);
+			first = 0;
+			last = a;
+		} else {
+			K.reserve(p + 1 + U.size() - e);
+			K.assign(p + 1, s);
+			K.insert(K.end(), U.begin() + e, U.end());
+			first = e - p - 1;
+			last = (major) ? M : N;
+		}
+
+		if (major) {
+			y.Q_.assign(x.Q_, first, last, 0, N);
+		} else {
+			y.Q_.assign(x.Q_, 0, M, first, last);
+		}
+
+		if (&y != &x) {
+			if (major) {
+				y.T_ = x.T_;
+			} else {
+				y.S_ = x.S_;
+			}
+		}
+		((major) ? y.S_ : y.T_).assign(K.begin(), K.end());
+	}
+
 	std::size_t major_degree_() const {
-		return bspline_degree(this->S_.size(), this->Q_.major_size());
+		return bspl::degree(this->S_.size(), this->Q_.major_size());
 	}
 
 	std::size_t minor_degree_() const {
-		return bspline_degree(this->T_.size(), this->Q_.minor_size());
+		return bspl::degree(this->T_.size(), this->Q_.minor_size());
 	}
 };
 
+/**
+ * @brief Subdivides a surface at @f$(s, t)@f$ into four patches.
+ *
+ * The patches are written in the order of the control points, the lower
+ * part in major order first:
+ * @f$[s_0, s] \times [t_0, t]@f$, @f$[s, s_1] \times [t_0, t]@f$,
+ * @f$[s_0, s] \times [t, t_1]@f$ and @f$[s, s_1] \times [t, t_1]@f$.
+ * A parameter out of the interior of the domain gives empty patches on the
+ * upper side. Assigning to existing surfaces reuses their storage.
+ *
+ * @param x The surface.
+ * @param s Parameter in major order.
+ * @param t Parameter in minor order.
+ * @param result The destination of the four patches.
+ * @return The end of the destination.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator subdivide(const bsurface<Vector, Parameter, Allocator>& x,
+		const Parameter& s, const Parameter& t, OutputIterator result) {
+	typedef bsurface<Vector, Parameter, Allocator> surface_type;
+
+	surface_type y00(x);
+	surface_type y10(x.get_allocator());
+	surface_type y01(x.get_allocator());
+	surface_type y11(x.get_allocator());
+
+	y00.subdivide_major(s, y10, GK::Upper);
+	y00.subdivide_minor(t, y01, GK::Upper);
+	y10.subdivide_minor(t, y11, GK::Upper);
+
+	*result = y00;
+	++result;
+	*result = y10;
+	++result;
+	*result = y01;
+	++result;
+	*result = y11;
+	++result;
+
+	return result;
+}
+
 }  // namespace gk
 
 #endif /* INCLUDE_BSPLINE_BSURFACE_H_ */
@@ -0,0 +1,1258 @@
+/*
+ * bsurface_algorithm.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_BSURFACE_ALGORITHM_H_
+#define BSPLINE_BSURFACE_ALGORITHM_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../gkaabb.h"
+#include "../algorithm/aabbtree.h"
+#include "bsurface.h"
+
+namespace gk {
+
+/**
+ * @brief Patch of a B-spline surface on one cell of knot spans.
+ *
+ * The patch lies in the box of its @f$(p + 1) \times (q + 1)@f$ Bézier
+ * control points, which is tighter than the box of the B-spline control
+ * points which are non-zero on the cell.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename Parameter>
+struct bsurface_patch {
+	typedef Vector vector_type;
+
+	std::size_t major_span; ///< Index of the knot span in major order.
+	std::size_t minor_span; ///< Index of the knot span in minor order.
+	std::pair<Parameter, Parameter> major_domain;
+	std::pair<Parameter, Parameter> minor_domain;
+	aabb<Vector> box; ///< The box of the local control points.
+
+	bsurface_patch() :
+			major_span(), minor_span(), major_domain(), minor_domain(), box() {
+	}
+};
+
+template<typename Vector, typename Parameter>
+const aabb<Vector>& boundary(const bsurface_patch<Vector, Parameter>& x) {
+	return x.box;
+}
+
+/**
+ * @brief Hierarchy of the patches of a B-spline surface.
+ *
+ * The leaves are the patches on the non-empty cells of knot spans, bounded
+ * by their Bézier control net boxes. The Bézier control points and a grid
+ * of samples are kept for every patch to isolate and seed iterative
+ * methods. The knot vectors must be clamped. The hierarchy refers to the
+ * surface, which must outlive it.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ * @tparam Allocator Type of an allocator of the surface.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename Parameter,
+		typename Allocator = std::allocator<Vector> >
+class bsurface_tree {
+public:
+	typedef bsurface<Vector, Parameter, Allocator> surface_type;
+	typedef bsurface_patch<Vector, Parameter> patch_type;
+	typedef aabbtree<patch_type, Vector> tree_type;
+
+public:
+	/**
+	 * @brief Builds the hierarchy of a surface @a x.
+	 * @param x
+	 */
+	explicit bsurface_tree(const surface_type& x) :
+			X_(&x), tree_(), B_(), P_(), m_(x.major_degree() + 2), n_(
+					x.minor_degree() + 2) {
+		this->build_();
+	}
+
+	bsurface_tree(const bsurface_tree& other) :
+			X_(other.X_), tree_(other.tree_), B_(other.B_), P_(other.P_), m_(
+					other.m_), n_(other.n_) {
+	}
+
+	~bsurface_tree() {
+	}
+
+	const surface_type& surface() const {
+		return *this->X_;
+	}
+
+	const tree_type& tree() const {
+		return this->tree_;
+	}
+
+	/**
+	 * @brief Returns the Bézier control point @f$(a, b)@f$ of the @a k th
+	 * patch in the leaf order, where @f$a \le p@f$ and @f$b \le q@f$.
+	 */
+	const Vector& bezier(std::size_t k, std::size_t a, std::size_t b) const {
+		const std::size_t p = this->X_->major_degree();
+		const std::size_t q = this->X_->minor_degree();
+		return this->B_[(k * (p + 1) + a) * (q + 1) + b];
+	}
+
+	/**
+	 * @brief Returns the number of samples of a patch in major order.
+	 */
+	std::size_t major_samples() const {
+		return this->m_;
+	}
+
+	/**
+	 * @brief Returns the number of samples of a patch in minor order.
+	 */
+	std::size_t minor_samples() const {
+		return this->n_;
+	}
+
+	/**
+	 * @brief Returns the sample @f$(a, b)@f$ of the @a k th patch in the
+	 * leaf order.
+	 */
+	const Vector& sample(std::size_t k, std::size_t a, std::size_t b) const {
+		return this->P_[(k * this->m_ + a) * this->n_ + b];
+	}
+
+	/**
+	 * @brief Returns the parameters of the sample @f$(a, b)@f$ of the
+	 * @a k th patch.
+	 */
+	std::pair<Parameter, Parameter> sample_parameter(std::size_t k,
+			std::size_t a, std::size_t b) const {
+		const patch_type& x = this->tree_[k];
+		const Parameter u = Parameter(a) / Parameter(this->m_ - 1);
+		const Parameter v = Parameter(b) / Parameter(this->n_ - 1);
+		return std::make_pair(
+				x.major_domain.first
+						+ u * (x.major_domain.second - x.major_domain.first),
+				x.minor_domain.first
+						+ v * (x.minor_domain.second - x.minor_domain.first));
+	}
+
+	bsurface_tree& operator=(const bsurface_tree& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		this->tree_ = rhs.tree_;
+		this->B_ = rhs.B_;
+		this->P_ = rhs.P_;
+		this->m_ = rhs.m_;
+		this->n_ = rhs.n_;
+		return *this;
+	}
+
+private:
+	const surface_type* X_;
+	tree_type tree_;
+	std::vector<Vector> B_; ///< The Bézier control points in the leaf order of the patches.
+	std::vector<Vector> P_; ///< The samples in the leaf order of the patches.
+	std::size_t m_;
+	std::size_t n_;
+
+private:
+	void build_() {
+		const surface_type& X = *this->X_;
+		const std::size_t p = X.major_degree();
+		const std::size_t q = X.minor_degree();
+		const typename surface_type::network_type& Q = X.controls();
+		const typename surface_type::knotvector_type& S =
+				X.major_knot_vector();
+		const typename surface_type::knotvector_type& T =
+				X.minor_knot_vector();
+
+		const std::size_t m0 = Q.major_size();
+		const std::size_t n0 = Q.minor_size();
+
+		// The ordinals of the non-empty knot spans, which index the Bézier
+		// segments.
+		std::vector<std::size_t> I(m0, 0);
+		std::vector<std::size_t> J(n0, 0);
+		std::size_t m = 0;
+		for (std::size_t i = p; i < m0; ++i) {
+			I[i] = m;
+			m += (S[i] < S[i + 1]) ? 1 : 0;
+		}
+		std::size_t n = 0;
+		for (std::size_t j = q; j < n0; ++j) {
+			J[j] = n;
+			n += (T[j] < T[j + 1]) ? 1 : 0;
+		}
+
+		// Decomposes the rows, then the columns of the result.
+		const std::size_t Mb = m * (p + 1);
+		const std::size_t Nb = n * (q + 1);
+		std::vector<Vector> R(Mb * n0);
+		std::vector<Vector> B(Mb * Nb);
+		if (Mb != 0 && Nb != 0) {
+			impl::decompose_network_lines(p, S.begin(), m0,
+					impl::make_network_lines(Q.data(), 1, m0, n0),
+					impl::make_network_lines(&R[0], 1, Mb, n0));
+			impl::decompose_network_lines(q, T.begin(), n0,
+					impl::make_network_lines<const Vector>(&R[0], Mb, 1, Mb),
+					impl::make_network_lines(&B[0], Mb, 1, Mb));
+		}
+
+		std::vector<patch_type> patches;
+		std::vector<Vector> net;
+		net.reserve((p + 1) * (q + 1));
+
+		for (std::size_t i = p; i < m0; ++i) {
+			if (!(S[i] < S[i + 1])) {
+				continue;
+			}
+
+			for (std::size_t j = q; j < n0; ++j) {
+				if (!(T[j] < T[j + 1])) {
+					continue;
+				}
+
+				net.clear();
+				for (std::size_t a = 0; a <= p; ++a) {
+					for (std::size_t b = 0; b <= q; ++b) {
+						net.push_back(
+								B[I[i] * (p + 1) + a + (J[j] * (q + 1) + b) * Mb]);
+					}
+				}
+
+				patch_type x;
+				x.major_span = i;
+				x.minor_span = j;
+				x.major_domain = std::make_pair(S[i], S[i + 1]);
+				x.minor_domain = std::make_pair(T[j], T[j + 1]);
+				x.box = aabb<Vector>(net.begin(), net.end());
+				patches.push_back(x);
+			}
+		}
+
+		this->tree_ = tree_type(patches.begin(), patches.end());
+
+		this->B_.resize(this->tree_.size() * (p + 1) * (q + 1));
+		for (std::size_t k = 0; k < this->tree_.size(); ++k) {
+			const patch_type& x = this->tree_[k];
+			for (std::size_t a = 0; a <= p; ++a) {
+				for (std::size_t b = 0; b <= q; ++b) {
+					this->B_[(k * (p + 1) + a) * (q + 1) + b] = B[I[x.major_span]
+							* (p + 1) + a + (J[x.minor_span] * (q + 1) + b) * Mb];
+				}
+			}
+		}
+
+		bspl::basis_table<Parameter> M;
+		bspl::basis_table<Parameter> N;
+		this->P_.resize(this->tree_.size() * this->m_ * this->n_);
+		for (std::size_t k = 0; k < this->tree_.size(); ++k) {
+			for (std::size_t a = 0; a < this->m_; ++a) {
+				for (std::size_t b = 0; b < this->n_; ++b) {
+					const std::pair<Parameter, Parameter> u =
+							this->sample_parameter(k, a, b);
+					X.derivatives(u.first, u.second, 0,
+							&this->P_[(k * this->m_ + a) * this->n_ + b], M, N);
+				}
+			}
+		}
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Projects positions onto a B-spline surface.
+ *
+ * The patches are visited nearest first and pruned by the lower bound of
+ * the distance to their boxes. The nearest sample seeds a Newton iteration
+ * on @f$(s, t)@f$. An instance keeps its work buffers, so it is made once
+ * for each thread.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+class bsurface_nearest_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef bsurface_tree<Vector, Parameter, Allocator> tree_type;
+
+	static const std::size_t MaxIterations = 16;
+	static const std::size_t MaxHalvings = 16;
+
+public:
+	explicit bsurface_nearest_kernel(const tree_type& X) :
+			X_(X), M_(), N_(), stack_(), tolerance2_() {
+		const typename tree_type::tree_type& tree = X.tree();
+		if (!tree.empty()) {
+			const aabb<Vector>& box = tree.node_at(0).box;
+			const Vector d = box.max() - box.min();
+			const value_type tolerance = std::sqrt(
+					std::numeric_limits<value_type>::epsilon())
+					* std::sqrt(dot(d, d));
+			this->tolerance2_ = tolerance * tolerance;
+		}
+	}
+
+	~bsurface_nearest_kernel() {
+	}
+
+	std::pair<Parameter, Parameter> operator()(const Vector& v) {
+		value_type d2 = std::numeric_limits<value_type>::max();
+		const std::pair<Parameter, Parameter> seed = this->seed_(v, d2);
+		return this->newton_(v, seed, d2);
+	}
+
+private:
+	const tree_type& X_;
+	bspl::basis_table<Parameter> M_;
+	bspl::basis_table<Parameter> N_;
+	std::vector<std::size_t> stack_;
+	value_type tolerance2_;
+
+private:
+	bsurface_nearest_kernel(const bsurface_nearest_kernel&);
+	bsurface_nearest_kernel& operator=(const bsurface_nearest_kernel&);
+
+	/**
+	 * @brief Finds the nearest sample in the patches which are not pruned.
+	 */
+	std::pair<Parameter, Parameter> seed_(const Vector& v, value_type& best) {
+		const typename tree_type::tree_type& tree = this->X_.tree();
+
+		std::pair<Parameter, Parameter> seed;
+		if (tree.empty()) {
+			return seed;
+		}
+
+		this->stack_.clear();
+		this->stack_.push_back(0);
+
+		while (!this->stack_.empty()) {
+			const typename tree_type::tree_type::node& x = tree.node_at(
+					this->stack_.back());
+			this->stack_.pop_back();
+
+			if (!(square_distance(x.box, v) < best)) {
+				continue;
+			}
+
+			if (x.is_leaf()) {
+				for (std::size_t k = x.first; k < x.first + x.size; ++k) {
+					if (!(square_distance(tree.box(k), v) < best)) {
+						continue;
+					}
+
+					for (std::size_t a = 0; a < this->X_.major_samples(); ++a) {
+						for (std::size_t b = 0; b < this->X_.minor_samples();
+								++b) {
+							const Vector r = this->X_.sample(k, a, b) - v;
+							const value_type d2 = dot(r, r);
+							if (d2 < best) {
+								best = d2;
+								seed = this->X_.sample_parameter(k, a, b);
+							}
+						}
+					}
+				}
+
+			} else {
+				// Visits the nearer child first.
+				const value_type d0 = square_distance(
+						tree.node_at(x.first).box, v);
+				const value_type d1 = square_distance(
+						tree.node_at(x.first + 1).box, v);
+				if (d0 < d1) {
+					this->stack_.push_back(x.first + 1);
+					this->stack_.push_back(x.first);
+				} else {
+					this->stack_.push_back(x.first);
+					this->stack_.push_back(x.first + 1);
+				}
+			}
+		}
+
+		return seed;
+	}
+
+	/**
+	 * @brief Newton iteration of the point inversion (The NURBS Book, 6.1).
+	 *
+	 * A step, clamped to the domain, is accepted only if it reduces the
+	 * distance; otherwise it is halved. Where the Hessian of the distance
+	 * is not positive definite, the Gauss-Newton matrix replaces it, so
+	 * that the step is a descent direction.
+	 */
+	std::pair<Parameter, Parameter> newton_(const Vector& v,
+			const std::pair<Parameter, Parameter>& seed, value_type best) {
+		typedef typename refinement_traits<value_type>::value_type real_type;
+
+		const typename tree_type::surface_type& X = this->X_.surface();
+		const std::pair<Parameter, Parameter> Ds = X.major_domain();
+		const std::pair<Parameter, Parameter> Dt = X.minor_domain();
+
+		const std::size_t d = 2;
+		Vector D[(d + 1) * (d + 1)];
+
+		Parameter s = seed.first;
+		Parameter t = seed.second;
+
+		X.derivatives(s, t, d, D, this->M_, this->N_);
+		best = dot(D[0] - v, D[0] - v);
+
+		for (std::size_t i = 0; i < MaxIterations; ++i) {
+			const Vector r = D[0] - v;
+			const Vector& Su = D[1 * (d + 1) + 0];
+			const Vector& Sv = D[0 * (d + 1) + 1];
+			const Vector& Suu = D[2 * (d + 1) + 0];
+			const Vector& Suv = D[1 * (d + 1) + 1];
+			const Vector& Svv = D[0 * (d + 1) + 2];
+
+			// The system is solved in the refinement precision; the float
+			// dots are promoted before the cancellation in the determinant.
+			const real_type f = dot(r, Su);
+			const real_type g = dot(r, Sv);
+			real_type J00 = real_type(dot(Su, Su)) + real_type(dot(r, Suu));
+			real_type J01 = real_type(dot(Su, Sv)) + real_type(dot(r, Suv));
+			real_type J11 = real_type(dot(Sv, Sv)) + real_type(dot(r, Svv));
+
+			real_type det = J00 * J11 - J01 * J01;
+			if (!(J00 > real_type(GK_FLOAT_ZERO))
+					|| !(det > real_type(GK_FLOAT_ZERO))) {
+				J00 = dot(Su, Su);
+				J01 = dot(Su, Sv);
+				J11 = dot(Sv, Sv);
+				det = J00 * J11 - J01 * J01;
+				if (!(det > real_type(GK_FLOAT_ZERO))) {
+					break;
+				}
+			}
+
+			Parameter s1 = s - Parameter((J11 * f - J01 * g) / det);
+			Parameter t1 = t - Parameter((J00 * g - J01 * f) / det);
+
+			// On a boundary, the step continues in the free parameter with
+			// the other one fixed on the boundary.
+			if (s1 < Ds.first || Ds.second < s1) {
+				s1 = std::min(std::max(s1, Ds.first), Ds.second);
+				t1 = t - Parameter((g + J01 * (s1 - s)) / J11);
+			}
+			if (t1 < Dt.first || Dt.second < t1) {
+				t1 = std::min(std::max(t1, Dt.first), Dt.second);
+				s1 = s - Parameter((f + J01 * (t1 - t)) / J00);
+			}
+			s1 = std::min(std::max(s1, Ds.first), Ds.second);
+			t1 = std::min(std::max(t1, Dt.first), Dt.second);
+
+			// Halves the step until the distance decreases.
+			Parameter ds = s1 - s;
+			Parameter dt = t1 - t;
+			bool accepted = false;
+			for (std::size_t k = 0; k < MaxHalvings; ++k) {
+				const Vector step = value_type(ds) * Su + value_type(dt) * Sv;
+				if (!(dot(step, step) > this->tolerance2_)) {
+					break;
+				}
+
+				X.derivatives(s + ds, t + dt, 0, D, this->M_, this->N_);
+				const value_type d2 = dot(D[0] - v, D[0] - v);
+				if (d2 < best) {
+					best = d2;
+					accepted = true;
+					break;
+				}
+
+				ds /= Parameter(2);
+				dt /= Parameter(2);
+			}
+
+			if (!accepted) {
+				break;
+			}
+
+			s += ds;
+			t += dt;
+			X.derivatives(s, t, d, D, this->M_, this->N_);
+		}
+
+		return std::make_pair(s, t);
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Computes the parameters of the nearest position on a B-spline
+ * surface to a position @a v.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param v
+ * @return The parameters @f$(s, t)@f$.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+std::pair<Parameter, Parameter> nearest(
+		const bsurface_tree<Vector, Parameter, Allocator>& X, const Vector& v) {
+	impl::bsurface_nearest_kernel<Vector, Parameter, Allocator> kernel(X);
+	return kernel(v);
+}
+
+/**
+ * @brief Computes the parameters of the nearest position on a B-spline
+ * surface to a position @a v.
+ *
+ * @param x
+ * @param v
+ * @return The parameters @f$(s, t)@f$.
+ *
+ * @related bsurface
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+std::pair<Parameter, Parameter> nearest(
+		const bsurface<Vector, Parameter, Allocator>& x, const Vector& v) {
+	return nearest(bsurface_tree<Vector, Parameter, Allocator>(x), v);
+}
+
+/**
+ * @brief Computes the parameters of the nearest positions on a B-spline
+ * surface to positions in [first, last).
+ *
+ * The positions are processed in parallel when OpenMP is enabled.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param first
+ * @param last
+ * @param result The beginning of the parameters, pairs of @f$(s, t)@f$.
+ * @return The end of the parameters.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename InputRandomAccessIterator, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator nearest(
+		const bsurface_tree<Vector, Parameter, Allocator>& X,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::bsurface_nearest_kernel<Vector, Parameter, Allocator> kernel(X);
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			result[i] = kernel(first[i]);
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Computes the parameters of the nearest positions on a B-spline
+ * surface to positions in [first, last).
+ *
+ * @param x
+ * @param first
+ * @param last
+ * @param result The beginning of the parameters, pairs of @f$(s, t)@f$.
+ * @return The end of the parameters.
+ *
+ * @related bsurface
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename InputRandomAccessIterator, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator nearest(
+		const bsurface<Vector, Parameter, Allocator>& x,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	const bsurface_tree<Vector, Parameter, Allocator> X(x);
+	return nearest(X, first, last, result);
+}
+
+/**
+ * @brief Intersection of a ray and a B-spline surface.
+ *
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/18
+ */
+template<typename Parameter>
+struct bsurface_hit {
+	Parameter major; ///< Parameter on the surface in major order.
+	Parameter minor; ///< Parameter on the surface in minor order.
+	Parameter ray; ///< Parameter on the ray, the distance for a unit direction.
+
+	bsurface_hit() :
+			major(), minor(), ray() {
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Intersects rays @f$\mathbf{o} + r\mathbf{d}@f$ with a 3D B-spline
+ * surface.
+ *
+ * The patches whose boxes the ray passes are isolated by subdivision of
+ * their Bézier nets projected on two planes through the ray; a piece is
+ * dropped when the projected hull does not contain the ray. The pieces
+ * left seed a Newton iteration on @f$(s, t, r)@f$. Rays in a packet share
+ * the traversal of the hierarchy. An instance keeps its work buffers, so it
+ * is made once for each thread.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+class bsurface_ray_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef bsurface_tree<Vector, Parameter, Allocator> tree_type;
+	typedef bsurface_hit<Parameter> hit_type;
+
+	static const std::size_t MaxIterations = 16;
+	static const std::size_t MaxDepth = 24; ///< The maximum number of subdivisions of a patch.
+	static const std::size_t PacketSize = 8; ///< The number of rays sharing a traversal.
+
+public:
+	explicit bsurface_ray_kernel(const tree_type& X) :
+			X_(X), M_(), N_(), stack_(), pieces_(), pool_(), work_(), line_(), hits_(),
+			tolerance_(), s_tolerance_(), t_tolerance_() {
+		const value_type epsilon = std::sqrt(
+				std::numeric_limits<value_type>::epsilon());
+		const typename tree_type::tree_type& tree = X.tree();
+		if (!tree.empty()) {
+			const aabb<Vector>& box = tree.node_at(0).box;
+			const Vector d = box.max() - box.min();
+			this->tolerance_ = epsilon * std::sqrt(dot(d, d));
+
+			const std::pair<Parameter, Parameter> Ds =
+					X.surface().major_domain();
+			const std::pair<Parameter, Parameter> Dt =
+					X.surface().minor_domain();
+			this->s_tolerance_ = Parameter(epsilon) * (Ds.second - Ds.first);
+			this->t_tolerance_ = Parameter(epsilon) * (Dt.second - Dt.first);
+		}
+	}
+
+	~bsurface_ray_kernel() {
+	}
+
+	/**
+	 * @brief Computes all the intersections in [r_min, r_max] in the
+	 * order of the ray parameter.
+	 */
+	template<typename OutputIterator>
+	OutputIterator operator()(const Vector& origin, const Vector& direction,
+			value_type r_min, value_type r_max, OutputIterator result) {
+		this->hits_.clear();
+		if (this->X_.tree().empty()) {
+			return result;
+		}
+
+		const ray x = this->prepare_(origin, direction);
+		this->traverse_(x, r_min, r_max);
+
+		std::sort(this->hits_.begin(), this->hits_.end(), hit_less());
+		return std::copy(this->hits_.begin(), this->hits_.end(), result);
+	}
+
+	/**
+	 * @brief Computes the first intersections in [r_min, r_max) of a packet
+	 * of at most @c PacketSize rays.
+	 */
+	template<typename OriginIterator, typename DirectionIterator,
+			typename OutputIterator>
+	void first(OriginIterator origin, DirectionIterator direction,
+			std::size_t n, value_type r_min, OutputIterator result) {
+		ray X[PacketSize];
+		value_type r_max[PacketSize];
+		std::pair<bool, hit_type> best[PacketSize];
+		for (std::size_t i = 0; i < n; ++i) {
+			X[i] = this->prepare_(origin[i], direction[i]);
+			r_max[i] = std::numeric_limits<value_type>::max();
+			best[i] = std::make_pair(false, hit_type());
+		}
+
+		if (!this->X_.tree().empty()) {
+			this->traverse_packet_(X, n, r_min, r_max, best);
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			result[i] = best[i];
+		}
+	}
+
+private:
+	/**
+	 * @brief Ray prepared for the traversal.
+	 */
+	struct ray {
+		Vector origin;
+		Vector direction;
+		Vector inverse; ///< The reciprocals of the components of the direction.
+		Vector u; ///< Unit normal of the first plane through the ray.
+		Vector v; ///< Unit normal of the second plane through the ray.
+		value_type dd; ///< The square of the norm of the direction.
+	};
+
+	/**
+	 * @brief Piece of a patch in the subdivision, on
+	 * @f$[u_0, u_1] \times [v_0, v_1] \subset [0, 1]^2@f$.
+	 */
+	struct piece {
+		std::size_t offset; ///< The position of the projected net in the pool.
+		Parameter u0;
+		Parameter u1;
+		Parameter v0;
+		Parameter v1;
+		std::size_t depth;
+	};
+
+	struct hit_less {
+		bool operator()(const hit_type& a, const hit_type& b) const {
+			return a.ray < b.ray;
+		}
+	};
+
+	const tree_type& X_;
+	bspl::basis_table<Parameter> M_;
+	bspl::basis_table<Parameter> N_;
+	std::vector<std::size_t> stack_;
+	std::vector<piece> pieces_;
+	std::vector<value_type> pool_; ///< The projected nets of the pieces, 3 values for each point.
+	std::vector<value_type> work_;
+	std::vector<value_type> line_;
+	std::vector<hit_type> hits_;
+	value_type tolerance_;
+	Parameter s_tolerance_;
+	Parameter t_tolerance_;
+
+private:
+	bsurface_ray_kernel(const bsurface_ray_kernel&);
+	bsurface_ray_kernel& operator=(const bsurface_ray_kernel&);
+
+	static ray prepare_(const Vector& origin, const Vector& direction) {
+		const value_type One = value_type(GK_FLOAT_ONE);
+		const cross<Vector> product = cross<Vector>();
+
+		ray x;
+		x.origin = origin;
+		x.direction = direction;
+		x.dd = dot(direction, direction);
+
+		std::size_t axis = 0;
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			x.inverse[i] = One / direction[i];
+			if (std::abs(direction[i]) < std::abs(direction[axis])) {
+				axis = i;
+			}
+		}
+
+		Vector e = zero_vector<Vector>();
+		e[axis] = One;
+		x.u = product(direction, e);
+		x.u = (One / std::sqrt(dot(x.u, x.u))) * x.u;
+		x.v = product(direction, x.u);
+		x.v = (One / std::sqrt(dot(x.v, x.v))) * x.v;
+
+		return x;
+	}
+
+	/**
+	 * @brief Visits the patches the ray passes, nearer first.
+	 */
+	void traverse_(const ray& x, value_type r_min, value_type r_max) {
+		const typename tree_type::tree_type& tree = this->X_.tree();
+
+		this->stack_.clear();
+		this->stack_.push_back(0);
+
+		while (!this->stack_.empty()) {
+			const typename tree_type::tree_type::node& y = tree.node_at(
+					this->stack_.back());
+			this->stack_.pop_back();
+
+			value_type r0 = r_min;
+			value_type r1 = r_max;
+			if (!clip_ray(y.box, x.origin, x.inverse, r0, r1)) {
+				continue;
+			}
+
+			if (y.is_leaf()) {
+				for (std::size_t k = y.first; k < y.first + y.size; ++k) {
+					r0 = r_min;
+					r1 = r_max;
+					if (clip_ray(tree.box(k), x.origin, x.inverse, r0, r1)) {
+						this->patch_(k, x, r_min, r_max);
+					}
+				}
+			} else {
+				this->stack_.push_back(y.first + 1);
+				this->stack_.push_back(y.first);
+			}
+		}
+	}
+
+	/**
+	 * @brief Visits the patches which any ray of a packet passes, keeping
+	 * the first intersection of each ray to prune the others.
+	 */
+	void traverse_packet_(const ray* X, std::size_t n, value_type r_min,
+			value_type* r_max, std::pair<bool, hit_type>* best) {
+		const typename tree_type::tree_type& tree = this->X_.tree();
+
+		this->stack_.clear();
+		this->stack_.push_back(0);
+
+		while (!this->stack_.empty()) {
+			const typename tree_type::tree_type::node& y = tree.node_at(
+					this->stack_.back());
+			this->stack_.pop_back();
+
+			unsigned int mask = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				value_type r0 = r_min;
+				value_type r1 = r_max[i];
+				if (clip_ray(y.box, X[i].origin, X[i].inverse, r0, r1)) {
+					mask |= 1u << i;
+				}
+			}
+			if (mask == 0) {
+				continue;
+			}
+
+			if (!y.is_leaf()) {
+				// Visits the nearer child first for the first active ray.
+				std::size_t i = 0;
+				while (!(mask & (1u << i))) {
+					++i;
+				}
+				value_type r0 = r_min;
+				value_type r1 = r_max[i];
+				value_type s0 = r_min;
+				value_type s1 = r_max[i];
+				clip_ray(tree.node_at(y.first).box, X[i].origin, X[i].inverse,
+						r0, r1);
+				clip_ray(tree.node_at(y.first + 1).box, X[i].origin,
+						X[i].inverse, s0, s1);
+				if (r0 < s0) {
+					this->stack_.push_back(y.first + 1);
+					this->stack_.push_back(y.first);
+				} else {
+					this->stack_.push_back(y.first);
+					this->stack_.push_back(y.first + 1);
+				}
+				continue;
+			}
+
+			for (std::size_t k = y.first; k < y.first + y.size; ++k) {
+				for (std::size_t i = 0; i < n; ++i) {
+					value_type r0 = r_min;
+					value_type r1 = r_max[i];
+					if (!(mask & (1u << i))
+							|| !clip_ray(tree.box(k), X[i].origin,
+									X[i].inverse, r0, r1)) {
+						continue;
+					}
+
+					this->hits_.clear();
+					this->patch_(k, X[i], r_min, r_max[i]);
+					for (std::size_t h = 0; h < this->hits_.size(); ++h) {
+						if (!best[i].first
+								|| this->hits_[h].ray < best[i].second.ray) {
+							best[i] = std::make_pair(true, this->hits_[h]);
+							r_max[i] = this->hits_[h].ray;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Subdivides the Bézier net of the @a k th patch to isolate the
+	 * intersections in [r_min, r_max].
+	 */
+	void patch_(std::size_t k, const ray& x, value_type r_min,
+			value_type r_max) {
+		const typename tree_type::patch_type& patch = this->X_.tree()[k];
+		const std::size_t p = this->X_.surface().major_degree();
+		const std::size_t q = this->X_.surface().minor_degree();
+		const std::size_t w = 3 * (p + 1) * (q + 1);
+		const value_type r_tolerance = this->tolerance_ / std::sqrt(x.dd);
+		const Parameter NewtonSize = Parameter(0.25);
+
+		this->pool_.resize(w);
+		for (std::size_t a = 0; a <= p; ++a) {
+			for (std::size_t b = 0; b <= q; ++b) {
+				const Vector e = this->X_.bezier(k, a, b) - x.origin;
+				value_type* c = &this->pool_[3 * (a * (q + 1) + b)];
+				c[0] = dot(e, x.u);
+				c[1] = dot(e, x.v);
+				c[2] = dot(e, x.direction) / x.dd;
+			}
+		}
+
+		const piece root = { 0, Parameter(0), Parameter(1), Parameter(0),
+				Parameter(1), 0 };
+		this->pieces_.clear();
+		this->pieces_.push_back(root);
+
+		while (!this->pieces_.empty()) {
+			const piece y = this->pieces_.back();
+			this->pieces_.pop_back();
+
+			this->work_.assign(this->pool_.begin() + y.offset,
+					this->pool_.begin() + y.offset + w);
+			this->pool_.resize(y.offset);
+
+			value_type lower[3];
+			value_type upper[3];
+			std::copy(&this->work_[0], &this->work_[0] + 3, lower);
+			std::copy(&this->work_[0], &this->work_[0] + 3, upper);
+			for (std::size_t i = 3; i < w; i += 3) {
+				for (std::size_t d = 0; d < 3; ++d) {
+					lower[d] = std::min(lower[d], this->work_[i + d]);
+					upper[d] = std::max(upper[d], this->work_[i + d]);
+				}
+			}
+
+			if (lower[0] > this->tolerance_ || upper[0] < -this->tolerance_
+					|| lower[1] > this->tolerance_
+					|| upper[1] < -this->tolerance_
+					|| lower[2] > r_max + r_tolerance
+					|| upper[2] < r_min - r_tolerance) {
+				continue;
+			}
+
+			if (y.u1 - y.u0 <= NewtonSize && y.v1 - y.v0 <= NewtonSize) {
+				const Parameter ds = patch.major_domain.second
+						- patch.major_domain.first;
+				const Parameter dt = patch.minor_domain.second
+						- patch.minor_domain.first;
+
+				Parameter s = patch.major_domain.first
+						+ Parameter(0.5) * (y.u0 + y.u1) * ds;
+				Parameter t = patch.minor_domain.first
+						+ Parameter(0.5) * (y.v0 + y.v1) * dt;
+				value_type r = value_type(0.5) * (lower[2] + upper[2]);
+
+				if (this->newton_(x, s, t, r) && !(r < r_min)
+						&& !(r > r_max)) {
+					const bool inside = !(s < patch.major_domain.first
+							+ y.u0 * ds - this->s_tolerance_)
+							&& !(s > patch.major_domain.first + y.u1 * ds
+											+ this->s_tolerance_)
+							&& !(t < patch.minor_domain.first + y.v0 * dt
+											- this->t_tolerance_)
+							&& !(t > patch.minor_domain.first + y.v1 * dt
+											+ this->t_tolerance_);
+					this->record_(s, t, r, r_tolerance);
+					if (inside) {
+						continue;
+					}
+				}
+			}
+
+			if (y.depth >= MaxDepth) {
+				continue;
+			}
+
+			// The upper piece is pushed last, so it is popped first and its
+			// net is on the top of the pool.
+			const bool major = !(y.u1 - y.u0 < y.v1 - y.v0);
+			this->pool_.resize(y.offset + 2 * w);
+			this->split_(&this->work_[0], p, q, major, &this->pool_[y.offset],
+					&this->pool_[y.offset + w]);
+
+			piece lower_piece = y;
+			piece upper_piece = y;
+			lower_piece.depth = upper_piece.depth = y.depth + 1;
+			upper_piece.offset = y.offset + w;
+			if (major) {
+				lower_piece.u1 = upper_piece.u0 = Parameter(0.5)
+						* (y.u0 + y.u1);
+			} else {
+				lower_piece.v1 = upper_piece.v0 = Parameter(0.5)
+						* (y.v0 + y.v1);
+			}
+			this->pieces_.push_back(lower_piece);
+			this->pieces_.push_back(upper_piece);
+		}
+	}
+
+	/**
+	 * @brief Splits a projected net at the middle by de Casteljau's
+	 * algorithm.
+	 */
+	void split_(const value_type* net, std::size_t p, std::size_t q,
+			bool major, value_type* lower, value_type* upper) {
+		const std::size_t size = (major) ? p : q;
+		const std::size_t lines = (major) ? q + 1 : p + 1;
+		const std::size_t step = 3 * ((major) ? q + 1 : 1);
+		const std::size_t stride = 3 * ((major) ? 1 : q + 1);
+		const value_type Half = value_type(0.5);
+
+		this->line_.resize(3 * (size + 1));
+		value_type* c = &this->line_[0];
+		for (std::size_t l = 0; l < lines; ++l) {
+			const std::size_t base = l * stride;
+			for (std::size_t i = 0; i <= size; ++i) {
+				std::copy(net + base + i * step, net + base + i * step + 3,
+						c + 3 * i);
+			}
+
+			for (std::size_t j = 0; j <= size; ++j) {
+				std::copy(c, c + 3, lower + base + j * step);
+				std::copy(c + 3 * (size - j), c + 3 * (size - j) + 3,
+						upper + base + (size - j) * step);
+				for (std::size_t i = 0; i + j < size; ++i) {
+					for (std::size_t d = 0; d < 3; ++d) {
+						c[3 * i + d] = Half * (c[3 * i + d] + c[3 * (i + 1) + d]);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Newton iteration on @f$\mathbf{S}(s, t) - \mathbf{o} - r\mathbf{d}
+	 * = \mathbf{0}@f$.
+	 * @return true if it converged.
+	 */
+	bool newton_(const ray& x, Parameter& s, Parameter& t, value_type& r) {
+		const typename tree_type::surface_type& X = this->X_.surface();
+		const std::pair<Parameter, Parameter> Ds = X.major_domain();
+		const std::pair<Parameter, Parameter> Dt = X.minor_domain();
+		const cross<Vector> product = cross<Vector>();
+		const value_type tolerance2 = this->tolerance_ * this->tolerance_;
+
+		const std::size_t d = 1;
+		Vector D[(d + 1) * (d + 1)];
+
+		for (std::size_t i = 0; i < MaxIterations; ++i) {
+			X.derivatives(s, t, d, D, this->M_, this->N_);
+
+			const Vector& Su = D[1 * (d + 1) + 0];
+			const Vector& Sv = D[0 * (d + 1) + 1];
+			const Vector F = D[0] - x.origin - r * x.direction;
+			const Vector g = -F;
+			const Vector c = -x.direction;
+
+			// Solves [Su Sv -d] (ds, dt, dr) = -F by Cramer's rule.
+			const Vector bc = product(Sv, c);
+			const value_type det = dot(Su, bc);
+			if (det == value_type(GK_FLOAT_ZERO)) {
+				return false;
+			}
+
+			const Parameter s1 = std::min(
+					std::max(s + Parameter(dot(g, bc) / det), Ds.first),
+					Ds.second);
+			const Parameter t1 = std::min(
+					std::max(t + Parameter(dot(Su, product(g, c)) / det),
+							Dt.first), Dt.second);
+			r += dot(Su, product(Sv, g)) / det;
+
+			const Vector step = value_type(s1 - s) * Su
+					+ value_type(t1 - t) * Sv;
+			s = s1;
+			t = t1;
+
+			if (!(dot(F, F) > tolerance2) && !(dot(step, step) > tolerance2)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Keeps an intersection unless it is found already from an
+	 * adjacent piece.
+	 */
+	void record_(const Parameter& s, const Parameter& t, value_type r,
+			value_type r_tolerance) {
+		for (std::size_t i = 0; i < this->hits_.size(); ++i) {
+			const hit_type& h = this->hits_[i];
+			if (!(std::abs(h.ray - r) > r_tolerance)
+					&& !(std::abs(h.major - s) > this->s_tolerance_)
+					&& !(std::abs(h.minor - t) > this->t_tolerance_)) {
+				return;
+			}
+		}
+
+		hit_type h;
+		h.major = s;
+		h.minor = t;
+		h.ray = Parameter(r);
+		this->hits_.push_back(h);
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Computes the intersections of a ray
+ * @f$\mathbf{o} + r\mathbf{d}@f$, @f$r_{min} \le r \le r_{max}@f$,
+ * and a 3D B-spline surface.
+ *
+ * A line is the ray of the interval of the whole real numbers, and a
+ * segment the ray of @f$[0, 1]@f$.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param origin The origin @f$\mathbf{o}@f$.
+ * @param direction The direction @f$\mathbf{d}@f$, not necessarily a unit
+ * vector.
+ * @param r_min
+ * @param r_max
+ * @param result The beginning of the intersections, bsurface_hit, in the
+ * order of the ray parameter.
+ * @return The end of the intersections.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator intersect(const bsurface_tree<Vector, Parameter, Allocator>& X,
+		const Vector& origin, const Vector& direction,
+		const typename vector_traits<Vector>::value_type& r_min,
+		const typename vector_traits<Vector>::value_type& r_max,
+		OutputIterator result) {
+	impl::bsurface_ray_kernel<Vector, Parameter, Allocator> kernel(X);
+	return kernel(origin, direction, r_min, r_max, result);
+}
+
+/**
+ * @brief Computes the intersections of a ray
+ * @f$\mathbf{o} + r\mathbf{d}@f$, @f$r \ge 0@f$, and a 3D B-spline surface.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param origin
+ * @param direction
+ * @param result The beginning of the intersections, bsurface_hit, in the
+ * order of the ray parameter.
+ * @return The end of the intersections.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator intersect(const bsurface_tree<Vector, Parameter, Allocator>& X,
+		const Vector& origin, const Vector& direction, OutputIterator result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	return intersect(X, origin, direction, value_type(GK_FLOAT_ZERO),
+			std::numeric_limits<value_type>::max(), result);
+}
+
+/**
+ * @brief Computes the intersections of a ray
+ * @f$\mathbf{o} + r\mathbf{d}@f$, @f$r \ge 0@f$, and a 3D B-spline surface.
+ *
+ * @param x
+ * @param origin
+ * @param direction
+ * @param result The beginning of the intersections, bsurface_hit, in the
+ * order of the ray parameter.
+ * @return The end of the intersections.
+ *
+ * @related bsurface
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator intersect(const bsurface<Vector, Parameter, Allocator>& x,
+		const Vector& origin, const Vector& direction, OutputIterator result) {
+	return intersect(bsurface_tree<Vector, Parameter, Allocator>(x), origin,
+			direction, result);
+}
+
+/**
+ * @brief Computes the first intersection of a ray
+ * @f$\mathbf{o} + r\mathbf{d}@f$, @f$r \ge 0@f$, and a 3D B-spline surface.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param origin
+ * @param direction
+ * @return The flag whether the ray hits the surface, and the intersection.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+std::pair<bool, bsurface_hit<Parameter> > first_intersection(
+		const bsurface_tree<Vector, Parameter, Allocator>& X,
+		const Vector& origin, const Vector& direction) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	impl::bsurface_ray_kernel<Vector, Parameter, Allocator> kernel(X);
+	std::pair<bool, bsurface_hit<Parameter> > result;
+	kernel.first(&origin, &direction, 1, value_type(GK_FLOAT_ZERO), &result);
+	return result;
+}
+
+/**
+ * @brief Computes the first intersections of rays and a 3D B-spline
+ * surface.
+ *
+ * Consecutive rays are traced in packets which share the traversal of the
+ * hierarchy, so rays with near origins and directions, such as those of
+ * one pixel tile, should be adjacent. The packets are processed in parallel
+ * when OpenMP is enabled.
+ *
+ * @param X The patch hierarchy of the surface.
+ * @param origin_first The beginning of the origins.
+ * @param origin_last The end of the origins.
+ * @param direction_first The beginning of the directions.
+ * @param result The beginning of the pairs of the flag whether the ray hits
+ * the surface and the intersection.
+ * @return The end of the results.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OriginRandomAccessIterator,
+		typename DirectionRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator first_intersections(
+		const bsurface_tree<Vector, Parameter, Allocator>& X,
+		OriginRandomAccessIterator origin_first,
+		OriginRandomAccessIterator origin_last,
+		DirectionRandomAccessIterator direction_first,
+		OutputRandomAccessIterator result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef impl::bsurface_ray_kernel<Vector, Parameter, Allocator> kernel_type;
+
+	const std::ptrdiff_t n = std::distance(origin_first, origin_last);
+	const std::ptrdiff_t packet = kernel_type::PacketSize;
+	const std::ptrdiff_t packets = (n + packet - 1) / packet;
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		kernel_type kernel(X);
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic, 4)
+#endif
+		for (std::ptrdiff_t i = 0; i < packets; ++i) {
+			const std::ptrdiff_t first = i * packet;
+			kernel.first(origin_first + first, direction_first + first,
+					std::min(packet, n - first), value_type(GK_FLOAT_ZERO),
+					result + first);
+		}
+	}
+
+	return result + n;
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_BSURFACE_ALGORITHM_H_ */
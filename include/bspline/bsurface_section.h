@@ -0,0 +1,919 @@
+/*
+ * bsurface_section.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_BSURFACE_SECTION_H_
+#define BSPLINE_BSURFACE_SECTION_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../gkaabb.h"
+#include "../primitive/line.h"
+#include "../primitive/plane.h"
+#include "bspline.h"
+#include "bsurface.h"
+#include "fitting.h"
+
+namespace gk {
+
+/**
+ * @brief Grid of positions on a B-spline surface.
+ *
+ * Every non-empty knot span is divided evenly, so the grid follows the
+ * pieces of the surface. The grid is computed once and shared, read only,
+ * by the sections of any number of planes. The grid refers to the surface,
+ * which must outlive it.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ * @tparam Allocator Type of an allocator of the surface.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename Parameter,
+		typename Allocator = std::allocator<Vector> >
+class bsurface_grid {
+public:
+	typedef bsurface<Vector, Parameter, Allocator> surface_type;
+
+public:
+	/**
+	 * @brief Computes the grid of a surface @a x.
+	 * @param x
+	 * @param density The number of the intervals in a knot span. Zero
+	 * selects the degree plus one in each direction.
+	 */
+	explicit bsurface_grid(const surface_type& x, std::size_t density = 0) :
+			X_(&x), S_(), T_(), P_(), box_() {
+		this->build_(density);
+	}
+
+	bsurface_grid(const bsurface_grid& other) :
+			X_(other.X_), S_(other.S_), T_(other.T_), P_(other.P_), box_(
+					other.box_) {
+	}
+
+	~bsurface_grid() {
+	}
+
+	const surface_type& surface() const {
+		return *this->X_;
+	}
+
+	/**
+	 * @brief Returns the number of the grid lines in major order.
+	 */
+	std::size_t major_size() const {
+		return this->S_.size();
+	}
+
+	/**
+	 * @brief Returns the number of the grid lines in minor order.
+	 */
+	std::size_t minor_size() const {
+		return this->T_.size();
+	}
+
+	/**
+	 * @brief Returns the parameters of the grid lines in major order.
+	 */
+	const std::vector<Parameter>& major_parameters() const {
+		return this->S_;
+	}
+
+	/**
+	 * @brief Returns the parameters of the grid lines in minor order.
+	 */
+	const std::vector<Parameter>& minor_parameters() const {
+		return this->T_;
+	}
+
+	/**
+	 * @brief Returns the box of the positions.
+	 */
+	const aabb<Vector>& box() const {
+		return this->box_;
+	}
+
+	/**
+	 * @brief Returns the position at @f$(s_i, t_j)@f$.
+	 */
+	const Vector& operator()(std::size_t i, std::size_t j) const {
+		return this->P_[i + j * this->S_.size()];
+	}
+
+	bsurface_grid& operator=(const bsurface_grid& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		this->S_ = rhs.S_;
+		this->T_ = rhs.T_;
+		this->P_ = rhs.P_;
+		this->box_ = rhs.box_;
+		return *this;
+	}
+
+private:
+	const surface_type* X_;
+	std::vector<Parameter> S_; ///< The parameters of the grid lines in major order.
+	std::vector<Parameter> T_; ///< The parameters of the grid lines in minor order.
+	std::vector<Vector> P_; ///< The positions, major index first.
+	aabb<Vector> box_;
+
+private:
+	template<typename KnotVector>
+	static void parameters_(const KnotVector& U, std::size_t p,
+			std::size_t n, std::size_t density, std::vector<Parameter>& X) {
+		X.clear();
+		for (std::size_t i = p; i < n; ++i) {
+			if (!(U[i] < U[i + 1])) {
+				continue;
+			}
+
+			for (std::size_t k = 0; k < density; ++k) {
+				X.push_back(
+						U[i]
+								+ (U[i + 1] - U[i]) * Parameter(k)
+										/ Parameter(density));
+			}
+		}
+		if (n != 0) {
+			X.push_back(U[n]);
+		}
+	}
+
+	void build_(std::size_t density) {
+		const surface_type& X = *this->X_;
+		const std::size_t p = X.major_degree();
+		const std::size_t q = X.minor_degree();
+
+		parameters_(X.major_knot_vector(), p, X.controls().major_size(),
+				(density == 0) ? p + 1 : density, this->S_);
+		parameters_(X.minor_knot_vector(), q, X.controls().minor_size(),
+				(density == 0) ? q + 1 : density, this->T_);
+
+		const std::size_t m = this->S_.size();
+		const std::size_t n = this->T_.size();
+
+		bspl::basis_table<Parameter> M;
+		bspl::basis_table<Parameter> N;
+		this->P_.resize(m * n);
+		for (std::size_t j = 0; j < n; ++j) {
+			for (std::size_t i = 0; i < m; ++i) {
+				X.derivatives(this->S_[i], this->T_[j], 0, &this->P_[i + j * m],
+						M, N);
+			}
+		}
+
+		if (!this->P_.empty()) {
+			this->box_ = aabb<Vector>(this->P_.begin(), this->P_.end());
+		}
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Traces the sections of a 3D B-spline surface by planes
+ * @f$\mathbf{n} \cdot (\mathbf{x} - \mathbf{r}) = 0@f$.
+ *
+ * The edges of the grid on which the signed distance changes its sign seed
+ * the curves. Each curve is marched in both directions with a step of the
+ * chord error @f$\varepsilon@f$ for the curvature @f$\kappa@f$,
+ * @f$h = \sqrt{8\varepsilon / \kappa}@f$, halved while the section departs
+ * from the chord by more than @f$0.9\varepsilon@f$ at its quarters, and
+ * the edges it crosses no longer seed. The curvature is that of the
+ * section, the normal curvature of the surface divided by the cosine
+ * between the surface normal and the curve normal in the plane. An instance
+ * keeps its work buffers, so it is made once for each thread.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+class bsurface_section_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef bsurface_grid<Vector, Parameter, Allocator> grid_type;
+
+	static const std::size_t MaxIterations = 8;
+	static const std::size_t MaxHalvings = 12;
+	static const std::size_t MaxSteps = 1 << 20;
+
+public:
+	explicit bsurface_section_kernel(const grid_type& G) :
+			G_(G), M_(), N_(), D_(), H_(), V_(), forward_(), backward_(),
+			points_(), offsets_(1, 0), reference_(), normal_(), tolerance_(),
+			h_max_() {
+		const Vector d = G.box().max() - G.box().min();
+		this->h_max_ = std::sqrt(dot(d, d)) / value_type(32);
+	}
+
+	~bsurface_section_kernel() {
+	}
+
+	/**
+	 * @brief Computes the sections by a plane.
+	 * @param reference A position on the plane.
+	 * @param normal The unit normal of the plane.
+	 * @param tolerance The chord error of the sections.
+	 * @return The number of the sections.
+	 */
+	std::size_t operator()(const Vector& reference, const Vector& normal,
+			value_type tolerance) {
+		this->points_.clear();
+		this->offsets_.assign(1, 0);
+		this->reference_ = reference;
+		this->normal_ = normal;
+		this->tolerance_ = tolerance;
+
+		const std::size_t m = this->G_.major_size();
+		const std::size_t n = this->G_.minor_size();
+		if (m < 2 || n < 2 || !(this->h_max_ > value_type(GK_FLOAT_ZERO))) {
+			return 0;
+		}
+
+		this->D_.resize(m * n);
+		for (std::size_t k = 0; k < m * n; ++k) {
+			this->D_[k] = dot(normal, this->G_(k % m, k / m) - reference);
+		}
+		this->H_.assign((m - 1) * n, false);
+		this->V_.assign(m * (n - 1), false);
+
+		const std::vector<Parameter>& S = this->G_.major_parameters();
+		const std::vector<Parameter>& T = this->G_.minor_parameters();
+
+		for (std::size_t j = 0; j < n; ++j) {
+			for (std::size_t i = 0; i + 1 < m; ++i) {
+				const value_type a = this->D_[i + j * m];
+				const value_type b = this->D_[i + 1 + j * m];
+				if ((a < value_type(GK_FLOAT_ZERO))
+						== (b < value_type(GK_FLOAT_ZERO))
+						|| this->H_[i + j * (m - 1)]) {
+					continue;
+				}
+
+				this->H_[i + j * (m - 1)] = true;
+				this->seed_(S[i] + (S[i + 1] - S[i]) * Parameter(a / (a - b)),
+						T[j], false, true);
+			}
+		}
+
+		for (std::size_t j = 0; j + 1 < n; ++j) {
+			for (std::size_t i = 0; i < m; ++i) {
+				const value_type a = this->D_[i + j * m];
+				const value_type b = this->D_[i + (j + 1) * m];
+				if ((a < value_type(GK_FLOAT_ZERO))
+						== (b < value_type(GK_FLOAT_ZERO)) || this->V_[i + j * m]) {
+					continue;
+				}
+
+				this->V_[i + j * m] = true;
+				this->seed_(S[i],
+						T[j] + (T[j + 1] - T[j]) * Parameter(a / (a - b)), true,
+						false);
+			}
+		}
+
+		return this->size();
+	}
+
+	/**
+	 * @brief Returns the number of the sections.
+	 */
+	std::size_t size() const {
+		return this->offsets_.size() - 1;
+	}
+
+	/**
+	 * @brief Returns the beginning of the positions of the @a k th section.
+	 * A closed section ends with its first position.
+	 */
+	const Vector* begin(std::size_t k) const {
+		return &this->points_[0] + this->offsets_[k];
+	}
+
+	const Vector* end(std::size_t k) const {
+		return &this->points_[0] + this->offsets_[k + 1];
+	}
+
+private:
+	const grid_type& G_;
+	bspl::basis_table<Parameter> M_;
+	bspl::basis_table<Parameter> N_;
+	std::vector<value_type> D_; ///< The signed distances on the grid.
+	std::vector<bool> H_; ///< The flags of the edges in major order which are crossed.
+	std::vector<bool> V_; ///< The flags of the edges in minor order which are crossed.
+	std::vector<Vector> forward_;
+	std::vector<Vector> backward_;
+	std::vector<Vector> points_; ///< The positions of all the sections.
+	std::vector<std::size_t> offsets_; ///< The beginning of each section in the positions.
+	Vector reference_;
+	Vector normal_;
+	value_type tolerance_;
+	value_type h_max_;
+
+private:
+	bsurface_section_kernel(const bsurface_section_kernel&);
+	bsurface_section_kernel& operator=(const bsurface_section_kernel&);
+
+	/**
+	 * @brief Traces the section through a seed on a grid edge.
+	 */
+	void seed_(Parameter s, Parameter t, bool fix_s, bool fix_t) {
+		Vector x;
+		if (!this->correct_(s, t, fix_s, fix_t, x)) {
+			return;
+		}
+
+		this->forward_.clear();
+		this->backward_.clear();
+		const bool closed = this->march_(s, t, value_type(GK_FLOAT_ONE), x,
+				this->forward_);
+		if (!closed) {
+			this->march_(s, t, -value_type(GK_FLOAT_ONE), x, this->backward_);
+		}
+
+		if (this->forward_.empty() && this->backward_.empty()) {
+			return;
+		}
+
+		this->points_.insert(this->points_.end(), this->backward_.rbegin(),
+				this->backward_.rend());
+		this->points_.push_back(x);
+		this->points_.insert(this->points_.end(), this->forward_.begin(),
+				this->forward_.end());
+		this->offsets_.push_back(this->points_.size());
+	}
+
+	/**
+	 * @brief Marches along the section from @f$(s, t)@f$.
+	 *
+	 * A step is bounded by the larger curvature of its ends, so that it
+	 * does not overrun a knot line across which the curvature jumps, and
+	 * its chord error is checked at its quarters.
+	 *
+	 * @return true if the section closes at @a start.
+	 */
+	bool march_(Parameter s, Parameter t, value_type sign, const Vector& start,
+			std::vector<Vector>& X) {
+		const typename grid_type::surface_type& Y = this->G_.surface();
+		const std::pair<Parameter, Parameter> Ds = Y.major_domain();
+		const std::pair<Parameter, Parameter> Dt = Y.minor_domain();
+		const value_type Zero = value_type(GK_FLOAT_ZERO);
+		const value_type One = value_type(GK_FLOAT_ONE);
+		const value_type MinCosine = value_type(0.95);
+		const value_type Slack = value_type(1.25);
+		const value_type Safety = value_type(0.9);
+
+		const Parameter s0 = s;
+		const Parameter t0 = t;
+		Vector x = start;
+		value_type length = Zero;
+
+		Parameter ws;
+		Parameter wt;
+		Vector tangent;
+		value_type h0;
+		if (!this->frame_(s, t, sign, ws, wt, tangent, h0)) {
+			return false;
+		}
+
+		for (std::size_t k = 0; k < MaxSteps; ++k) {
+			bool advanced = false;
+			bool boundary = false;
+			Parameter s1 = s;
+			Parameter t1 = t;
+			Parameter ws1 = ws;
+			Parameter wt1 = wt;
+			Vector tangent1 = tangent;
+			value_type h1 = h0;
+			Vector y;
+			value_type h = h0;
+			for (std::size_t i = 0; i < MaxHalvings && !advanced; ++i) {
+				if (i != 0) {
+					h *= value_type(0.5);
+				}
+
+				// Clips the step at the boundary of the domain.
+				value_type f = One;
+				bool fix_s = false;
+				bool fix_t = false;
+				const value_type hs = h * ws;
+				const value_type ht = h * wt;
+				if (s + hs < Ds.first || Ds.second < s + hs) {
+					const value_type g = ((hs < Zero) ? Ds.first - s : Ds.second - s)
+							/ hs;
+					if (g < f) {
+						f = g;
+						fix_s = true;
+					}
+				}
+				if (t + ht < Dt.first || Dt.second < t + ht) {
+					const value_type g = ((ht < Zero) ? Dt.first - t : Dt.second - t)
+							/ ht;
+					if (g < f) {
+						f = g;
+						fix_s = false;
+						fix_t = true;
+					}
+				}
+
+				s1 = (fix_s) ? ((hs < Zero) ? Ds.first : Ds.second) :
+						s + Parameter(f * hs);
+				t1 = (fix_t) ? ((ht < Zero) ? Dt.first : Dt.second) :
+						t + Parameter(f * ht);
+
+				if (!this->correct_(s1, t1, fix_s, fix_t, y)
+						|| !this->frame_(s1, t1, sign, ws1, wt1, tangent1, h1)) {
+					continue;
+				}
+
+				const Vector chord = y - x;
+				const value_type l = std::sqrt(dot(chord, chord));
+				if (l > this->tolerance_
+						&& (l > Slack * std::min(h0, h1)
+								|| dot(chord, tangent) < MinCosine * l
+								|| dot(chord, tangent1) < MinCosine * l)) {
+					h = std::min(h, value_type(2) * h1);
+					continue;
+				}
+
+				// The curvature may be larger inside the step than at both
+				// of its ends, so the chord error is checked at its quarters.
+				if (l > this->tolerance_
+						&& !this->check_chord_(s, t, s1, t1, x, chord,
+								Safety * this->tolerance_)) {
+					continue;
+				}
+
+				advanced = true;
+				boundary = fix_s || fix_t;
+			}
+
+			if (!advanced) {
+				return false;
+			}
+
+			this->mark_(s, t, s1, t1);
+
+			// Closes the section when it comes back to the start; the chord
+			// back to the start may cross a grid edge too.
+			const Vector r = y - start;
+			length += std::sqrt(dot(y - x, y - x));
+			if (length > value_type(2) * h && dot(r, r) < h * h) {
+				this->mark_(s1, t1, s0, t0);
+				X.push_back(start);
+				return true;
+			}
+
+			X.push_back(y);
+			if (boundary) {
+				return false;
+			}
+
+			s = s1;
+			t = t1;
+			ws = ws1;
+			wt = wt1;
+			tangent = tangent1;
+			h0 = h1;
+			x = y;
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Checks that the section between @f$(s_0, t_0)@f$ at @a x and
+	 * @f$(s_1, t_1)@f$ at @f$\mathbf{x} + \mathbf{c}@f$ is within a
+	 * distance @a e of the chord @f$\mathbf{c}@f$ at its quarters.
+	 * @return false if it is not.
+	 */
+	bool check_chord_(Parameter s0, Parameter t0, Parameter s1, Parameter t1,
+			const Vector& x, const Vector& chord, value_type e) {
+		const std::size_t Divisions = 4;
+		const value_type l2 = dot(chord, chord);
+
+		for (std::size_t i = 1; i < Divisions; ++i) {
+			const Parameter f = Parameter(i) / Parameter(Divisions);
+			Parameter s = s0 + f * (s1 - s0);
+			Parameter t = t0 + f * (t1 - t0);
+			Vector y;
+			if (!this->correct_(s, t, false, false, y)) {
+				continue;
+			}
+
+			const Vector w = y - x;
+			const Vector r = w - (dot(w, chord) / l2) * chord;
+			if (dot(r, r) > e * e) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Computes the unit tangent of the section at @f$(s, t)@f$,
+	 * in the parameter space and in the space, and the step for the chord
+	 * error from the curvature.
+	 * @return false at a singular point.
+	 */
+	bool frame_(const Parameter& s, const Parameter& t, value_type sign,
+			Parameter& ws, Parameter& wt, Vector& tangent, value_type& h) {
+		const typename grid_type::surface_type& Y = this->G_.surface();
+		const cross<Vector> product = cross<Vector>();
+		const value_type Zero = value_type(GK_FLOAT_ZERO);
+		const value_type One = value_type(GK_FLOAT_ONE);
+
+		const std::size_t d = 2;
+		Vector D[(d + 1) * (d + 1)];
+		Y.derivatives(s, t, d, D, this->M_, this->N_);
+		const Vector& Su = D[1 * (d + 1) + 0];
+		const Vector& Sv = D[0 * (d + 1) + 1];
+
+		ws = Parameter(-sign * dot(this->normal_, Sv));
+		wt = Parameter(sign * dot(this->normal_, Su));
+		tangent = value_type(ws) * Su + value_type(wt) * Sv;
+		const value_type speed = std::sqrt(dot(tangent, tangent));
+		if (!(speed > Zero)) {
+			return false;
+		}
+		ws /= Parameter(speed);
+		wt /= Parameter(speed);
+		tangent = (One / speed) * tangent;
+
+		Vector N = product(Su, Sv);
+		const value_type area = std::sqrt(dot(N, N));
+		if (!(area > Zero)) {
+			return false;
+		}
+		N = (One / area) * N;
+
+		const value_type kn = dot(D[2 * (d + 1) + 0], N) * ws * ws
+				+ value_type(2) * dot(D[1 * (d + 1) + 1], N) * ws * wt
+				+ dot(D[0 * (d + 1) + 2], N) * wt * wt;
+		const value_type c = std::abs(dot(N, product(this->normal_, tangent)));
+
+		h = this->h_max_;
+		if (kn != Zero) {
+			h = std::sqrt(value_type(8) * this->tolerance_ * c / std::abs(kn));
+		}
+		h = std::max(std::min(h, this->h_max_), this->tolerance_);
+
+		return true;
+	}
+
+	/**
+	 * @brief Moves @f$(s, t)@f$ onto the plane by Newton's method along
+	 * the gradient of the signed distance, or along the free parameter
+	 * when the other is fixed.
+	 * @return true if it converged.
+	 */
+	bool correct_(Parameter& s, Parameter& t, bool fix_s, bool fix_t,
+			Vector& x) {
+		const typename grid_type::surface_type& Y = this->G_.surface();
+		const std::pair<Parameter, Parameter> Ds = Y.major_domain();
+		const std::pair<Parameter, Parameter> Dt = Y.minor_domain();
+		const value_type Zero = value_type(GK_FLOAT_ZERO);
+		const value_type tolerance = this->tolerance_ * value_type(1.0e-3);
+
+		const std::size_t d = 1;
+		Vector D[(d + 1) * (d + 1)];
+
+		for (std::size_t i = 0; i <= MaxIterations; ++i) {
+			Y.derivatives(s, t, d, D, this->M_, this->N_);
+			const value_type f = dot(this->normal_, D[0] - this->reference_);
+			if (!(std::abs(f) > tolerance)) {
+				x = D[0];
+				return true;
+			}
+			if (i == MaxIterations) {
+				break;
+			}
+
+			const value_type fs = dot(this->normal_, D[1 * (d + 1) + 0]);
+			const value_type ft = dot(this->normal_, D[0 * (d + 1) + 1]);
+			if (fix_s) {
+				if (ft == Zero) {
+					return false;
+				}
+				t -= Parameter(f / ft);
+			} else if (fix_t) {
+				if (fs == Zero) {
+					return false;
+				}
+				s -= Parameter(f / fs);
+			} else {
+				const value_type g2 = fs * fs + ft * ft;
+				if (g2 == Zero) {
+					return false;
+				}
+				s -= Parameter(f * fs / g2);
+				t -= Parameter(f * ft / g2);
+			}
+
+			s = std::min(std::max(s, Ds.first), Ds.second);
+			t = std::min(std::max(t, Dt.first), Dt.second);
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Flags the grid edges crossed by a chord in the parameter
+	 * space, so that they seed no other section.
+	 *
+	 * The ends of the chord on a grid line are included, as a section
+	 * starts on an edge and may end on the boundary.
+	 */
+	void mark_(Parameter s0, Parameter t0, Parameter s1, Parameter t1) {
+		const std::vector<Parameter>& S = this->G_.major_parameters();
+		const std::vector<Parameter>& T = this->G_.minor_parameters();
+		const std::size_t m = S.size();
+		const std::size_t n = T.size();
+
+		if (s0 != s1) {
+			typename std::vector<Parameter>::const_iterator p = std::lower_bound(
+					S.begin(), S.end(), std::min(s0, s1));
+			for (; p != S.end() && !(std::max(s0, s1) < *p); ++p) {
+				const Parameter t = t0 + (*p - s0) * (t1 - t0) / (s1 - s0);
+				const std::size_t j = std::min<std::size_t>(
+						std::max<std::ptrdiff_t>(
+								std::upper_bound(T.begin(), T.end(), t)
+										- T.begin() - 1, 0), n - 2);
+				this->V_[(p - S.begin()) + j * m] = true;
+			}
+		}
+
+		if (t0 != t1) {
+			typename std::vector<Parameter>::const_iterator p = std::lower_bound(
+					T.begin(), T.end(), std::min(t0, t1));
+			for (; p != T.end() && !(std::max(t0, t1) < *p); ++p) {
+				const Parameter s = s0 + (*p - t0) * (s1 - s0) / (t1 - t0);
+				const std::size_t i = std::min<std::size_t>(
+						std::max<std::ptrdiff_t>(
+								std::upper_bound(S.begin(), S.end(), s)
+										- S.begin() - 1, 0), m - 2);
+				this->H_[i + (p - T.begin()) * (m - 1)] = true;
+			}
+		}
+	}
+};
+
+/**
+ * @brief Returns the normal of a plane as a vector.
+ */
+template<typename Vector>
+Vector plane_normal(const plane<Vector>& x) {
+	Vector n = Vector();
+	for (std::size_t i = 0; i < vector_traits<Vector>::Dimension; ++i) {
+		n[i] = x.normal()[i];
+	}
+	return n;
+}
+
+/**
+ * @brief Returns the chord error to trace the sections made into polylines,
+ * which is the tolerance itself.
+ */
+template<typename Vector>
+typename vector_traits<Vector>::value_type section_tolerance(
+		const typename vector_traits<Vector>::value_type& tolerance,
+		const polyline<Vector>*) {
+	return tolerance;
+}
+
+/**
+ * @brief Returns the chord error to trace the sections made into
+ * B-splines. The positions are traced about four times denser than for
+ * polylines, so that fit() has enough positions in a knot span to refine
+ * it down to the tolerance.
+ */
+template<typename Vector, typename Parameter>
+typename vector_traits<Vector>::value_type section_tolerance(
+		const typename vector_traits<Vector>::value_type& tolerance,
+		const bspline<Vector, Parameter>*) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	return tolerance / value_type(16);
+}
+
+/**
+ * @brief Makes a polyline of a section.
+ * @return Zero; the polyline passes the traced positions.
+ */
+template<typename Vector>
+typename vector_traits<Vector>::value_type assign_section(const Vector* first,
+		const Vector* last,
+		const typename vector_traits<Vector>::value_type&,
+		polyline<Vector>& x) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	x = polyline<Vector>(first, last);
+	return value_type(GK_FLOAT_ZERO);
+}
+
+/**
+ * @brief Makes a B-spline of a section by fit(), cubic if the section has
+ * enough positions.
+ *
+ * A section that cannot be fitted is made of degree 1 on the chord length
+ * parameters, passing the traced positions.
+ *
+ * @return The maximum distance from the traced positions to the B-spline
+ * at their parameters, an upper bound of the distance to the curve.
+ */
+template<typename Vector, typename Parameter>
+typename vector_traits<Vector>::value_type assign_section(const Vector* first,
+		const Vector* last,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		bspline<Vector, Parameter>& x) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::size_t SectionDegree = 3;
+
+	const std::size_t n = last - first;
+	if (n > 1) {
+		const value_type error = fit(first, last,
+				std::min(SectionDegree, n - 1), tolerance, x);
+		if (error < std::numeric_limits<value_type>::max()) {
+			return error;
+		}
+	}
+
+	std::vector<Parameter> T;
+	T.reserve(n + 2);
+	T.push_back(Parameter(GK_FLOAT_ZERO));
+	T.push_back(Parameter(GK_FLOAT_ZERO));
+	for (std::size_t i = 1; i < n; ++i) {
+		T.push_back(T.back() + Parameter(norm(first[i] - first[i - 1])));
+	}
+	T.push_back(T.back());
+
+	const Parameter length = T.back();
+	if (length > Parameter(GK_FLOAT_ZERO)) {
+		for (std::size_t i = 0; i < T.size(); ++i) {
+			T[i] /= length;
+		}
+	}
+
+	x = bspline<Vector, Parameter>(T.begin(), T.end(), first, last);
+	return value_type(GK_FLOAT_ZERO);
+}
+
+}  // namespace impl
+
+/**
+ * @brief Computes the sections of a 3D B-spline surface by a plane as
+ * polylines.
+ *
+ * A closed section ends with its first position. A section which does not
+ * cross any grid edge, such as a loop smaller than a grid cell, is missed;
+ * a denser grid finds it.
+ *
+ * @param G The grid of the surface.
+ * @param x The plane.
+ * @param tolerance The chord error of the polylines.
+ * @param result The beginning of the polylines.
+ * @return The end of the polylines.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator intersect(const bsurface_grid<Vector, Parameter, Allocator>& G,
+		const plane<Vector>& x,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		OutputIterator result) {
+	impl::bsurface_section_kernel<Vector, Parameter, Allocator> kernel(G);
+	const std::size_t n = kernel(x.reference(), impl::plane_normal(x),
+			tolerance);
+	for (std::size_t k = 0; k < n; ++k) {
+		*result = polyline<Vector>(kernel.begin(k), kernel.end(k));
+		++result;
+	}
+
+	return result;
+}
+
+/**
+ * @brief Computes the sections of a 3D B-spline surface by a plane as
+ * polylines.
+ *
+ * @param x The surface.
+ * @param y The plane.
+ * @param tolerance The chord error of the polylines.
+ * @param result The beginning of the polylines.
+ * @return The end of the polylines.
+ *
+ * @related bsurface
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename OutputIterator>
+OutputIterator intersect(const bsurface<Vector, Parameter, Allocator>& x,
+		const plane<Vector>& y,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		OutputIterator result) {
+	return intersect(bsurface_grid<Vector, Parameter, Allocator>(x), y,
+			tolerance, result);
+}
+
+/**
+ * @brief Computes the sections of a 3D B-spline surface by planes in
+ * [first, last), with the errors of the curves.
+ *
+ * All the planes share the grid, and they are processed in parallel when
+ * OpenMP is enabled. The sections by the @a i th plane are appended to
+ * <tt>result[i]</tt>, a container such as @c std::vector of @c polyline,
+ * or of @c bspline to obtain curves fitted to the traced positions by fit()
+ * within the tolerance. The positions for B-splines are traced denser, so
+ * that the fitting has positions to refine its knots.
+ *
+ * @param G The grid of the surface.
+ * @param first The beginning of the planes.
+ * @param last The end of the planes.
+ * @param tolerance The chord error of the sections, and the tolerance of
+ * fitting the B-splines.
+ * @param result The beginning of the containers of the sections.
+ * @param errors <tt>errors[i]</tt> receives the maximum error of the
+ * curves of the @a i th plane, as returned by fit(), which is zero for
+ * polylines.
+ * @return The end of the containers.
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename PlaneRandomAccessIterator, typename OutputRandomAccessIterator,
+		typename ErrorRandomAccessIterator>
+OutputRandomAccessIterator intersect(
+		const bsurface_grid<Vector, Parameter, Allocator>& G,
+		PlaneRandomAccessIterator first, PlaneRandomAccessIterator last,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		OutputRandomAccessIterator result, ErrorRandomAccessIterator errors) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename std::iterator_traits<OutputRandomAccessIterator>::value_type container_type;
+	typedef typename container_type::value_type curve_type;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	const value_type chord = impl::section_tolerance(tolerance,
+			static_cast<const curve_type*>(0));
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::bsurface_section_kernel<Vector, Parameter, Allocator> kernel(G);
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			const std::size_t m = kernel(first[i].reference(),
+					impl::plane_normal(first[i]), chord);
+			value_type error = value_type(GK_FLOAT_ZERO);
+			for (std::size_t k = 0; k < m; ++k) {
+				result[i].push_back(curve_type());
+				error = std::max(error,
+						impl::assign_section(kernel.begin(k), kernel.end(k),
+								tolerance, result[i].back()));
+			}
+			errors[i] = error;
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Computes the sections of a 3D B-spline surface by planes in
+ * [first, last).
+ *
+ * @param G The grid of the surface.
+ * @param first The beginning of the planes.
+ * @param last The end of the planes.
+ * @param tolerance The chord error of the sections.
+ * @param result The beginning of the containers of the sections.
+ * @return The end of the containers.
+ * @see intersect(const bsurface_grid<Vector, Parameter, Allocator>&, PlaneRandomAccessIterator, PlaneRandomAccessIterator, const typename vector_traits<Vector>::value_type&, OutputRandomAccessIterator, ErrorRandomAccessIterator)
+ */
+template<typename Vector, typename Parameter, typename Allocator,
+		typename PlaneRandomAccessIterator, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator intersect(
+		const bsurface_grid<Vector, Parameter, Allocator>& G,
+		PlaneRandomAccessIterator first, PlaneRandomAccessIterator last,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		OutputRandomAccessIterator result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	std::vector<value_type> errors(std::distance(first, last));
+	return intersect(G, first, last, tolerance, result, errors.begin());
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_BSURFACE_SECTION_H_ */
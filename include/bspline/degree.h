@@ -0,0 +1,680 @@
+/*
+ * degree.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_DEGREE_H_
+#define BSPLINE_DEGREE_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+
+#include "../gkvector.h"
+#include "basis.h"
+#include "bspline.h"
+
+namespace gk {
+
+namespace bspl {
+
+/**
+ * @brief Returns the number of the distinct interior knots of a clamped
+ * knot vector.
+ *
+ * @param degree
+ * @param first The beginning of the knot vector.
+ * @param last The end of the knot vector.
+ */
+template<typename RandomAccessIterator>
+std::size_t interior_knots_count(std::size_t degree,
+		RandomAccessIterator first, RandomAccessIterator last) {
+	const std::size_t n = std::distance(first, last) - degree - 1;
+
+	std::size_t s = 0;
+	for (std::size_t i = degree + 1; i < n; ++i) {
+		if (first[i] != first[i - 1]) {
+			++s;
+		}
+	}
+	return s;
+}
+
+}  // namespace bspl
+
+namespace impl {
+
+/**
+ * @brief Elevates the degree of B-splines on their knot vectors and control
+ * points (The NURBS Book, A5.9).
+ *
+ * The curve is decomposed into Bézier segments by inserting knots, the
+ * degree of each segment is elevated, and the unnecessary knots are removed
+ * again, in one pass along the knot vector. The outputs are written to
+ * arrays allocated once for the sizes given by bspl::interior_knots_count().
+ * An instance keeps its buffers, so it is made once for each thread.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter>
+class degree_elevation_kernel {
+public:
+	degree_elevation_kernel() :
+			p_(0), t_(0), A_(), B_(), E_(), R_(), alpha_() {
+	}
+
+	~degree_elevation_kernel() {
+	}
+
+	/**
+	 * @brief Elevates the degree of a B-spline @a t times.
+	 *
+	 * @param p Degree, at least 1.
+	 * @param U The beginning of the clamped knot vector of @a n + @a p + 1
+	 * knots, whose interior knots have multiplicities at most @a p.
+	 * @param n The number of the control points.
+	 * @param P The beginning of the control points.
+	 * @param t The number of the elevations.
+	 * @param Uh The beginning of the elevated knot vector, of
+	 * @f$n + (s + 1)t + p + t + 1@f$ knots for the number @f$s@f$ of the
+	 * distinct interior knots.
+	 * @param Q The beginning of the elevated control points, of
+	 * @f$n + (s + 1)t@f$ points.
+	 * @return The number of the elevated control points.
+	 */
+	template<typename KnotRandomAccessIterator,
+			typename VectorRandomAccessIterator,
+			typename KnotOutputRandomAccessIterator,
+			typename VectorOutputRandomAccessIterator>
+	std::size_t operator()(std::size_t p, KnotRandomAccessIterator U,
+			std::size_t n, VectorRandomAccessIterator P, std::size_t t,
+			KnotOutputRandomAccessIterator Uh,
+			VectorOutputRandomAccessIterator Q) {
+		const Parameter One(GK_FLOAT_ONE);
+		const std::size_t m = n + p;
+		const std::size_t ph = p + t;
+
+		this->coefficients_(p, t);
+		this->B_.resize(p + 1);
+		this->E_.resize(ph + 1);
+		this->R_.resize(p);
+		this->alpha_.resize(p);
+
+		std::size_t kind = ph + 1;
+		std::ptrdiff_t r = -1;
+		std::size_t a = p;
+		std::size_t b = p + 1;
+		std::size_t cind = 1;
+		Parameter ua = U[0];
+
+		Q[0] = P[0];
+		for (std::size_t i = 0; i <= ph; ++i) {
+			Uh[i] = ua;
+		}
+		for (std::size_t i = 0; i <= p; ++i) {
+			this->B_[i] = P[i];
+		}
+
+		while (b < m) {
+			const std::size_t i0 = b;
+			while (b < m && U[b] == U[b + 1]) {
+				++b;
+			}
+			const std::size_t mul = b - i0 + 1;
+			const Parameter ub = U[b];
+			const std::ptrdiff_t oldr = r;
+			r = std::ptrdiff_t(p) - std::ptrdiff_t(mul);
+			const std::size_t lbz = (oldr > 0) ? (oldr + 2) / 2 : 1;
+			const std::size_t rbz = (r > 0) ? ph - (r + 1) / 2 : ph;
+
+			// Inserts ub to extract the Bezier segment of [ua, ub].
+			if (r > 0) {
+				this->insert_(p, U, a, ua, ub, mul, r);
+			}
+
+			for (std::size_t i = lbz; i <= ph; ++i) {
+				const std::size_t j0 = (i > t) ? i - t : 0;
+				const std::size_t j1 = std::min(p, i);
+
+				Vector e = this->A_[i * (p + 1) + j0] * this->B_[j0];
+				for (std::size_t j = j0 + 1; j <= j1; ++j) {
+					e += this->A_[i * (p + 1) + j] * this->B_[j];
+				}
+				this->E_[i] = e;
+			}
+
+			// Removes ua, which has been inserted to the previous segment.
+			if (oldr > 1) {
+				std::size_t first = kind - 2;
+				std::size_t last = kind;
+				const Parameter den = ub - ua;
+				const Parameter bet = (ub - Uh[kind - 1]) / den;
+
+				for (std::size_t tr = 1; tr < std::size_t(oldr); ++tr) {
+					std::size_t i = first;
+					std::size_t j = last;
+					std::size_t kj = j - kind + 1;
+
+					while (j - i > tr) {
+						if (i < cind) {
+							const Parameter alf = (ub - Uh[i]) / (ua - Uh[i]);
+							Q[i] = alf * Q[i] + (One - alf) * Q[i - 1];
+						}
+						if (j >= lbz) {
+							const Parameter gam =
+									(j - tr <= kind - ph + oldr) ?
+											(ub - Uh[j - tr]) / den : bet;
+							this->E_[kj] = gam * this->E_[kj]
+									+ (One - gam) * this->E_[kj + 1];
+						}
+						++i;
+						--j;
+						--kj;
+					}
+					--first;
+					++last;
+				}
+			}
+
+			if (a != p) {
+				for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(ph) - oldr; ++i) {
+					Uh[kind] = ua;
+					++kind;
+				}
+			}
+			for (std::size_t j = lbz; j <= rbz; ++j) {
+				Q[cind] = this->E_[j];
+				++cind;
+			}
+
+			if (b < m) {
+				this->next_(p, P, b, r);
+				a = b;
+				++b;
+				ua = ub;
+			} else {
+				for (std::size_t i = 0; i <= ph; ++i) {
+					Uh[kind + i] = ub;
+				}
+			}
+		}
+
+		return cind;
+	}
+
+private:
+	std::size_t p_;
+	std::size_t t_;
+	std::vector<Parameter> A_; ///< The coefficients of the elevation of a Bezier segment.
+	std::vector<Vector> B_; ///< The Bezier segment.
+	std::vector<Vector> E_; ///< The elevated Bezier segment.
+	std::vector<Vector> R_; ///< The beginning of the next Bezier segment.
+	std::vector<Parameter> alpha_;
+
+private:
+	degree_elevation_kernel(const degree_elevation_kernel&);
+	degree_elevation_kernel& operator=(const degree_elevation_kernel&);
+
+	/**
+	 * @brief Computes the coefficients of the elevation of a Bezier segment
+	 * of a degree @a p by @a t, unless they are of the previous call.
+	 */
+	void coefficients_(std::size_t p, std::size_t t) {
+		if (!this->A_.empty() && p == this->p_ && t == this->t_) {
+			return;
+		}
+
+		const std::size_t ph = p + t;
+		this->p_ = p;
+		this->t_ = t;
+		this->A_.assign((ph + 1) * (p + 1), Parameter(GK_FLOAT_ZERO));
+
+		this->A_[0] = Parameter(GK_FLOAT_ONE);
+		this->A_[ph * (p + 1) + p] = Parameter(GK_FLOAT_ONE);
+		for (std::size_t i = 1; i <= ph / 2; ++i) {
+			const Parameter inverse = Parameter(GK_FLOAT_ONE)
+					/ bspl::binomial<Parameter>(ph, i);
+			for (std::size_t j = (i > t) ? i - t : 0; j <= std::min(p, i);
+					++j) {
+				this->A_[i * (p + 1) + j] = inverse
+						* bspl::binomial<Parameter>(p, j)
+						* bspl::binomial<Parameter>(t, i - j);
+			}
+		}
+		for (std::size_t i = ph / 2 + 1; i < ph; ++i) {
+			for (std::size_t j = (i > t) ? i - t : 0; j <= std::min(p, i);
+					++j) {
+				this->A_[i * (p + 1) + j] = this->A_[(ph - i) * (p + 1) + p - j];
+			}
+		}
+	}
+
+	/**
+	 * @brief Inserts @a ub @a r times into the Bezier segment from @a ua,
+	 * keeping the points of the next segment.
+	 */
+	template<typename KnotRandomAccessIterator>
+	void insert_(std::size_t p, KnotRandomAccessIterator U, std::size_t a,
+			const Parameter& ua, const Parameter& ub, std::size_t mul,
+			std::ptrdiff_t r) {
+		const Parameter One(GK_FLOAT_ONE);
+		const Parameter numer = ub - ua;
+		for (std::size_t k = p; k > mul; --k) {
+			this->alpha_[k - mul - 1] = numer / (U[a + k] - ua);
+		}
+		for (std::size_t j = 1; j <= std::size_t(r); ++j) {
+			const std::size_t s = mul + j;
+			for (std::size_t k = p; k >= s; --k) {
+				this->B_[k] = this->alpha_[k - s] * this->B_[k]
+						+ (One - this->alpha_[k - s]) * this->B_[k - 1];
+			}
+			this->R_[r - j] = this->B_[p];
+		}
+	}
+
+	/**
+	 * @brief Loads the Bezier segment starting at the knot @a b.
+	 */
+	template<typename VectorRandomAccessIterator>
+	void next_(std::size_t p, VectorRandomAccessIterator P, std::size_t b,
+			std::ptrdiff_t r) {
+		const std::size_t k = (r > 0) ? r : 0;
+		for (std::size_t j = 0; j < k; ++j) {
+			this->B_[j] = this->R_[j];
+		}
+		for (std::size_t j = k; j <= p; ++j) {
+			this->B_[j] = P[b - p + j];
+		}
+	}
+};
+
+/**
+ * @brief Reduces the degree of B-splines on their knot vectors and control
+ * points by one (The NURBS Book, A5.11).
+ *
+ * Each Bézier segment is reduced with the bound of its error, and the knots
+ * are removed with the bounds of their errors, which are accumulated for
+ * each knot span. The reduction stops as soon as a bound exceeds the
+ * tolerance. An instance keeps its buffers, so it is made once for each
+ * thread.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter>
+class degree_reduction_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	degree_reduction_kernel() :
+			B_(), E_(), R_(), alpha_(), e_() {
+	}
+
+	~degree_reduction_kernel() {
+	}
+
+	/**
+	 * @brief Reduces the degree of a B-spline by one.
+	 *
+	 * @param p Degree, at least 2.
+	 * @param U The beginning of the clamped knot vector of @a n + @a p + 1
+	 * knots, whose interior knots have multiplicities at most @a p.
+	 * @param n The number of the control points.
+	 * @param P The beginning of the control points.
+	 * @param tolerance The maximum error.
+	 * @param Uh The beginning of the reduced knot vector, of
+	 * @f$n - s + p - 1@f$ knots for the number @f$s@f$ of the distinct
+	 * interior knots.
+	 * @param Q The beginning of the reduced control points, of
+	 * @f$n - s - 1@f$ points.
+	 * @param error The bound of the error.
+	 * @return The number of the reduced control points, or 0 if the bound
+	 * exceeds @a tolerance.
+	 */
+	template<typename KnotRandomAccessIterator,
+			typename VectorRandomAccessIterator,
+			typename KnotOutputRandomAccessIterator,
+			typename VectorOutputRandomAccessIterator>
+	std::size_t operator()(std::size_t p, KnotRandomAccessIterator U,
+			std::size_t n, VectorRandomAccessIterator P,
+			const value_type& tolerance, KnotOutputRandomAccessIterator Uh,
+			VectorOutputRandomAccessIterator Q, value_type& error) {
+		const Parameter One(GK_FLOAT_ONE);
+		const std::size_t m = n + p;
+		const std::size_t ph = p - 1;
+
+		this->B_.resize(p + 1);
+		this->E_.resize(p);
+		this->R_.resize(p);
+		this->alpha_.resize(p);
+		this->e_.assign(m + 1, value_type(GK_FLOAT_ZERO));
+		error = value_type(GK_FLOAT_ZERO);
+
+		std::size_t kind = ph + 1;
+		std::ptrdiff_t r = -1;
+		std::size_t a = p;
+		std::size_t b = p + 1;
+		std::size_t cind = 1;
+
+		Q[0] = P[0];
+		for (std::size_t i = 0; i <= ph; ++i) {
+			Uh[i] = U[0];
+		}
+		for (std::size_t i = 0; i <= p; ++i) {
+			this->B_[i] = P[i];
+		}
+
+		while (b < m) {
+			const std::size_t i0 = b;
+			while (b < m && U[b] == U[b + 1]) {
+				++b;
+			}
+			const std::size_t mult = b - i0 + 1;
+			const std::ptrdiff_t oldr = r;
+			r = std::ptrdiff_t(p) - std::ptrdiff_t(mult);
+			const std::size_t lbz = (oldr > 0) ? (oldr + 2) / 2 : 1;
+
+			// Inserts U[b] to extract the Bezier segment of [U[a], U[b]].
+			if (r > 0) {
+				const Parameter numer = U[b] - U[a];
+				for (std::size_t k = p; k > mult; --k) {
+					this->alpha_[k - mult - 1] = numer / (U[a + k] - U[a]);
+				}
+				for (std::size_t j = 1; j <= std::size_t(r); ++j) {
+					const std::size_t s = mult + j;
+					for (std::size_t k = p; k >= s; --k) {
+						this->B_[k] = this->alpha_[k - s] * this->B_[k]
+								+ (One - this->alpha_[k - s]) * this->B_[k - 1];
+					}
+					this->R_[r - j] = this->B_[p];
+				}
+			}
+
+			this->e_[a] += this->reduce_bezier_(p);
+			if (this->e_[a] > tolerance) {
+				return 0;
+			}
+
+			// Removes U[a], which has been inserted to the previous segment.
+			if (oldr > 0) {
+				std::size_t first = kind;
+				std::size_t last = kind;
+				std::size_t i = first;
+
+				for (std::size_t k = 0; k < std::size_t(oldr); ++k) {
+					i = first;
+					std::size_t j = last;
+					std::size_t kj = j - kind;
+
+					while (j - i > k) {
+						const Parameter alf = (U[a] - Uh[i - 1])
+								/ (U[b] - Uh[i - 1]);
+						const Parameter bet = (U[a] - Uh[j - k - 1])
+								/ (U[b] - Uh[j - k - 1]);
+						Q[i - 1] = (One / alf)
+								* (Vector(Q[i - 1]) - (One - alf) * Vector(Q[i - 2]));
+						this->E_[kj] = (One / (One - bet))
+								* (this->E_[kj] - bet * this->E_[kj + 1]);
+						++i;
+						--j;
+						--kj;
+					}
+
+					value_type br;
+					if (j - i < k) {
+						br = norm(Vector(Q[i - 2]) - this->E_[kj + 1]);
+					} else {
+						const Parameter delta = (U[a] - Uh[i - 1])
+								/ (U[b] - Uh[i - 1]);
+						const Vector A = delta * this->E_[kj + 1]
+								+ (One - delta) * Vector(Q[i - 2]);
+						br = norm(Vector(Q[i - 1]) - A);
+					}
+
+					const std::size_t K = a + oldr - k;
+					const std::size_t q = (2 * p - k + 1) / 2;
+					for (std::size_t l = K - q; l <= a; ++l) {
+						this->e_[l] += br;
+						if (this->e_[l] > tolerance) {
+							return 0;
+						}
+					}
+					--first;
+					++last;
+				}
+				cind = i - 1;
+			}
+
+			if (a != p) {
+				for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(ph) - oldr; ++i) {
+					Uh[kind] = U[a];
+					++kind;
+				}
+			}
+			for (std::size_t i = lbz; i <= ph; ++i) {
+				Q[cind] = this->E_[i];
+				++cind;
+			}
+
+			if (b < m) {
+				const std::size_t k = (r > 0) ? r : 0;
+				for (std::size_t j = 0; j < k; ++j) {
+					this->B_[j] = this->R_[j];
+				}
+				for (std::size_t j = k; j <= p; ++j) {
+					this->B_[j] = P[b - p + j];
+				}
+				a = b;
+				++b;
+			} else {
+				for (std::size_t i = 0; i <= ph; ++i) {
+					Uh[kind + i] = U[b];
+				}
+			}
+		}
+
+		error = *std::max_element(this->e_.begin(), this->e_.end());
+		return cind;
+	}
+
+private:
+	std::vector<Vector> B_; ///< The Bezier segment.
+	std::vector<Vector> E_; ///< The reduced Bezier segment.
+	std::vector<Vector> R_; ///< The beginning of the next Bezier segment.
+	std::vector<Parameter> alpha_;
+	std::vector<value_type> e_; ///< The bounds of the errors of the knot spans.
+
+private:
+	degree_reduction_kernel(const degree_reduction_kernel&);
+	degree_reduction_kernel& operator=(const degree_reduction_kernel&);
+
+	/**
+	 * @brief Reduces the degree of the Bezier segment of a degree @a p from
+	 * both ends (The NURBS Book, (5.41)-(5.46)).
+	 * @return The bound of the error.
+	 */
+	value_type reduce_bezier_(std::size_t p) {
+		const Parameter One(GK_FLOAT_ONE);
+		const Parameter Half(0.5);
+		const std::size_t r = (p - 1) / 2;
+
+		this->E_[0] = this->B_[0];
+		this->E_[p - 1] = this->B_[p];
+
+		const std::size_t left = (p % 2 == 0) ? r + 1 : r;
+		for (std::size_t i = 1; i < left; ++i) {
+			const Parameter alpha = Parameter(i) / Parameter(p);
+			this->E_[i] = (One / (One - alpha))
+					* (this->B_[i] - alpha * this->E_[i - 1]);
+		}
+		for (std::size_t i = p - 2; i > r; --i) {
+			const Parameter alpha = Parameter(i + 1) / Parameter(p);
+			this->E_[i] = (One / alpha)
+					* (this->B_[i + 1] - (One - alpha) * this->E_[i + 1]);
+		}
+
+		if (p % 2 == 0) {
+			return norm(
+					Vector(this->B_[r + 1]
+							- Half * (this->E_[r] + this->E_[r + 1])));
+		}
+
+		const Parameter alpha_l = Parameter(r) / Parameter(p);
+		const Parameter alpha_r = Parameter(r + 1) / Parameter(p);
+		const Vector L = (One / (One - alpha_l))
+				* (this->B_[r] - alpha_l * this->E_[r - 1]);
+		const Vector R = (One / alpha_r)
+				* (this->B_[r + 1] - (One - alpha_r) * this->E_[r + 1]);
+		this->E_[r] = Half * (L + R);
+		return Half * (One - alpha_l) * norm(Vector(L - R));
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Elevates the degree of a B-spline without changing its shape.
+ *
+ * @param x The B-spline of a clamped knot vector.
+ * @param t The number of the elevations.
+ * @return The B-spline of the degree elevated by @a t.
+ */
+template<typename Vector, typename Parameter>
+bspline<Vector, Parameter> elevate_degree(const bspline<Vector, Parameter>& x,
+		std::size_t t) {
+	const std::size_t p = x.degree();
+	if (t == 0 || p == 0) {
+		return x;
+	}
+
+	const std::vector<Parameter> U(x.knot_vector().begin(),
+			x.knot_vector().end());
+	const std::size_t n = x.controls().size();
+	const std::size_t s = bspl::interior_knots_count(p, U.begin(), U.end());
+
+	std::vector<Parameter> Uh(n + (s + 1) * t + p + t + 1);
+	std::vector<Vector> Q(n + (s + 1) * t);
+
+	impl::degree_elevation_kernel<Vector, Parameter> kernel;
+	kernel(p, U.begin(), n, x.controls().begin(), t, Uh.begin(), Q.begin());
+	return bspline<Vector, Parameter>(Uh.begin(), Uh.end(), Q.begin(),
+			Q.end());
+}
+
+/**
+ * @brief Elevates the degrees of B-splines in [first, last) to a common
+ * @a degree.
+ *
+ * The B-splines of the degree or higher are copied as they are. They are
+ * processed in parallel when OpenMP is enabled.
+ *
+ * @param first The beginning of the B-splines.
+ * @param last The end of the B-splines.
+ * @param degree The degree.
+ * @param result The beginning of the elevated B-splines.
+ * @return The end of the elevated B-splines.
+ */
+template<typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator elevate_degree(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, std::size_t degree,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type bspline_type;
+	typedef typename bspline_type::vector_type vector_type;
+	typedef typename bspline_type::knotvector_type::value_type parameter_type;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::degree_elevation_kernel<vector_type, parameter_type> kernel;
+		std::vector<parameter_type> U;
+		std::vector<parameter_type> Uh;
+		std::vector<vector_type> Q;
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			const bspline_type& x = first[i];
+			const std::size_t p = x.degree();
+			if (p >= degree || p == 0) {
+				result[i] = x;
+				continue;
+			}
+
+			const std::size_t t = degree - p;
+			const std::size_t m = x.controls().size();
+			U.assign(x.knot_vector().begin(), x.knot_vector().end());
+			const std::size_t s = bspl::interior_knots_count(p, U.begin(),
+					U.end());
+
+			Uh.resize(m + (s + 1) * t + degree + 1);
+			Q.resize(m + (s + 1) * t);
+			kernel(p, U.begin(), m, x.controls().begin(), t, Uh.begin(),
+					Q.begin());
+			result[i] = bspline_type(Uh.begin(), Uh.end(), Q.begin(), Q.end());
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Reduces the degree of a B-spline by one within a @a tolerance.
+ *
+ * @param x The B-spline of a clamped knot vector of a degree at least 2.
+ * @param tolerance The maximum distance from @a x.
+ * @param result The B-spline of the reduced degree.
+ * @return The bound of the distance of @a result from @a x accumulated for
+ * the knot spans, or the maximum of the type leaving @a result unchanged if
+ * it exceeds @a tolerance. The bounds of the knot removals do not include
+ * the errors of the control points that are moved again by later removals,
+ * so it is an estimate for curves of many knots of degree 2.
+ */
+template<typename Vector, typename Parameter>
+typename vector_traits<Vector>::value_type reduce_degree(
+		const bspline<Vector, Parameter>& x,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		bspline<Vector, Parameter>& result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::size_t p = x.degree();
+	if (p < 2) {
+		return std::numeric_limits<value_type>::max();
+	}
+
+	const std::vector<Parameter> U(x.knot_vector().begin(),
+			x.knot_vector().end());
+	const std::size_t n = x.controls().size();
+	const std::size_t s = bspl::interior_knots_count(p, U.begin(), U.end());
+
+	std::vector<Parameter> Uh(n - s + p - 1);
+	std::vector<Vector> Q(n - s - 1);
+
+	impl::degree_reduction_kernel<Vector, Parameter> kernel;
+	value_type error;
+	if (kernel(p, U.begin(), n, x.controls().begin(), tolerance, Uh.begin(),
+			Q.begin(), error) == 0) {
+		return std::numeric_limits<value_type>::max();
+	}
+
+	result = bspline<Vector, Parameter>(Uh.begin(), Uh.end(), Q.begin(),
+			Q.end());
+	return error;
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_DEGREE_H_ */
@@ -0,0 +1,381 @@
+/*
+ * fitting.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_FITTING_H_
+#define BSPLINE_FITTING_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../algorithm/banded.h"
+#include "basis.h"
+#include "bspline.h"
+
+namespace gk {
+
+namespace bspl {
+
+/**
+ * @brief Computes the parameters of positions in [first, last) from the
+ * distances between them, @f$u_k - u_{k-1} \propto |Q_k - Q_{k-1}|^e@f$,
+ * normalized to [0, 1].
+ *
+ * The exponent 1 gives the chord length parameters and 0.5 the centripetal
+ * ones, which follow sharp turns better. Coincident positions are spread
+ * evenly.
+ *
+ * @param first The beginning of the positions.
+ * @param last The end of the positions.
+ * @param exponent The exponent @f$e@f$.
+ * @param result The beginning of the parameters.
+ * @return The end of the parameters.
+ */
+template<typename InputRandomAccessIterator, typename Parameter,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator parameterize(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, const Parameter& exponent,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+	const Parameter Zero = Parameter(GK_FLOAT_ZERO);
+
+	const std::size_t n = std::distance(first, last);
+	if (n == 0) {
+		return result;
+	}
+
+	result[0] = Zero;
+	for (std::size_t k = 1; k < n; ++k) {
+		const vector_type d = first[k] - first[k - 1];
+		result[k] = result[k - 1]
+				+ Parameter(std::pow(norm(d), exponent));
+	}
+
+	const Parameter length = result[n - 1];
+	for (std::size_t k = 1; k < n; ++k) {
+		result[k] =
+				(length > Zero) ?
+						result[k] / length : Parameter(k) / Parameter(n - 1);
+	}
+
+	return result + n;
+}
+
+}  // namespace bspl
+
+namespace impl {
+
+/**
+ * @brief Fits B-splines to positions by least squares.
+ *
+ * The end control points interpolate the end positions and the others
+ * minimize the square distances at the parameters of the positions. The
+ * normal equations are banded, of @f$p@f$ sub-diagonals for a degree
+ * @f$p@f$, and solved by the banded Cholesky factorization, so that a fit
+ * costs @f$O(mp^2)@f$ for @a m positions.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter>
+class bspline_fitting_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	bspline_fitting_kernel() :
+			p_(), T_(), P_(), A_(), b_(), N_() {
+	}
+
+	~bspline_fitting_kernel() {
+	}
+
+	const std::vector<Parameter>& knots() const {
+		return this->T_;
+	}
+
+	const std::vector<Vector>& controls() const {
+		return this->P_;
+	}
+
+	/**
+	 * @brief Sets the knots to a Bezier curve of a @a degree on [0, 1].
+	 */
+	void reset(std::size_t degree) {
+		this->p_ = degree;
+		this->T_.assign(degree + 1, Parameter(GK_FLOAT_ZERO));
+		this->T_.resize(2 * (degree + 1), Parameter(GK_FLOAT_ONE));
+	}
+
+	/**
+	 * @brief Computes the control points fitting positions @a Q at
+	 * parameters @a t.
+	 *
+	 * @return false if the knots leave the normal equations singular.
+	 */
+	bool solve(const std::vector<Vector>& Q, const std::vector<Parameter>& t) {
+		const std::size_t p = this->p_;
+		const std::size_t n = this->T_.size() - p - 1;
+		const std::size_t m = Q.size();
+
+		this->P_.resize(n);
+		this->P_.front() = Q.front();
+		this->P_.back() = Q.back();
+		if (n == 2) {
+			return true;
+		}
+
+		// The unknowns are the control points from 1 to n - 2.
+		this->A_.reset(n - 2, p, 0);
+		this->b_.assign(n - 2, value_type(GK_FLOAT_ZERO) * Q.front());
+
+		for (std::size_t k = 0; k < m; ++k) {
+			const std::size_t s = this->N_.compute(p, this->T_.begin(),
+					this->T_.end(), t[k], 0);
+			const std::size_t i0 = s - p;
+
+			Vector r = Q[k];
+			if (i0 == 0) {
+				r = r - this->N_(0, 0) * Q.front();
+			}
+			if (s == n - 1) {
+				r = r - this->N_(0, p) * Q.back();
+			}
+
+			for (std::size_t j = 0; j <= p; ++j) {
+				const std::size_t i = i0 + j;
+				if (i == 0 || i == n - 1) {
+					continue;
+				}
+
+				const Parameter w = this->N_(0, j);
+				this->b_[i - 1] = this->b_[i - 1] + w * r;
+				for (std::size_t jj = 0; jj <= j; ++jj) {
+					const std::size_t ii = i0 + jj;
+					if (ii > 0) {
+						this->A_(i - 1, ii - 1) += w * this->N_(0, jj);
+					}
+				}
+			}
+		}
+
+		if (!alg::cholesky(this->A_)) {
+			return false;
+		}
+		alg::cholesky_solve(this->A_, this->b_.begin());
+		std::copy(this->b_.begin(), this->b_.end(), this->P_.begin() + 1);
+		return true;
+	}
+
+	/**
+	 * @brief Computes the square distance of a position @a q at a parameter
+	 * @a t, and the parameter @a u moved toward the nearest position on the
+	 * curve by a Newton step within [lower, upper].
+	 *
+	 * @param q
+	 * @param t
+	 * @param lower
+	 * @param upper
+	 * @param u The corrected parameter.
+	 * @param N The table of the basis functions of the calling thread.
+	 * @return The square distance at @a t.
+	 */
+	value_type correct(const Vector& q, const Parameter& t,
+			const Parameter& lower, const Parameter& upper, Parameter& u,
+			bspl::basis_table<Parameter>& N) const {
+		const std::size_t p = this->p_;
+		const std::size_t s = N.compute(p, this->T_.begin(), this->T_.end(),
+				t, 2);
+
+		Vector d[3];
+		for (std::size_t k = 0; k < 3; ++k) {
+			d[k] = N(k, 0) * this->P_[s - p];
+			for (std::size_t j = 1; j <= p; ++j) {
+				d[k] = d[k] + N(k, j) * this->P_[s - p + j];
+			}
+		}
+
+		const Vector r = d[0] - q;
+		const value_type f = dot(r, d[1]);
+		const value_type df = dot(d[1], d[1]) + dot(r, d[2]);
+		u = (df > value_type(GK_FLOAT_ZERO)) ?
+				std::min(std::max(t - Parameter(f / df), lower), upper) : t;
+
+		return dot(r, r);
+	}
+
+	/**
+	 * @brief Inserts a knot into each span having a square error @a E over
+	 * a square @a tolerance, at the mean parameter of its positions.
+	 *
+	 * A span is split only if it has more than @f$p@f$ positions, not all at
+	 * one parameter, so that the halves keep positions to fit.
+	 *
+	 * @return false if no knot is inserted.
+	 */
+	bool refine(const std::vector<Parameter>& t,
+			const std::vector<value_type>& E, const value_type& tolerance) {
+		const std::size_t p = this->p_;
+		const std::size_t n = this->T_.size() - p - 1;
+
+		std::vector<std::size_t> count(n, 0);
+		std::vector<Parameter> sum(n, Parameter(GK_FLOAT_ZERO));
+		std::vector<Parameter> lower(n, Parameter(GK_FLOAT_ONE));
+		std::vector<Parameter> upper(n, Parameter(GK_FLOAT_ZERO));
+		std::vector<unsigned char> over(n, 0);
+
+		for (std::size_t k = 0; k < t.size(); ++k) {
+			const std::size_t s = std::distance(this->T_.begin(),
+					bspl::segment_of(p, this->T_.begin(), this->T_.end(),
+							t[k]));
+			++count[s];
+			sum[s] += t[k];
+			lower[s] = std::min(lower[s], t[k]);
+			upper[s] = std::max(upper[s], t[k]);
+			if (E[k] > tolerance) {
+				over[s] = 1;
+			}
+		}
+
+		std::vector<Parameter> U;
+		for (std::size_t s = p; s < n; ++s) {
+			if (over[s] && count[s] > p && lower[s] < upper[s]) {
+				U.push_back(sum[s] / Parameter(count[s]));
+			}
+		}
+		if (U.empty()) {
+			return false;
+		}
+
+		this->T_.insert(this->T_.end() - (p + 1), U.begin(), U.end());
+		std::sort(this->T_.begin(), this->T_.end());
+		return true;
+	}
+
+	/**
+	 * @brief Restores knots @a T and control points @a P of a previous fit.
+	 */
+	void assign(const std::vector<Parameter>& T, const std::vector<Vector>& P) {
+		this->T_ = T;
+		this->P_ = P;
+	}
+
+private:
+	std::size_t p_; ///< The degree.
+	std::vector<Parameter> T_; ///< The knots.
+	std::vector<Vector> P_; ///< The control points.
+	banded_matrix<Parameter> A_; ///< The normal matrix of the inner control points.
+	std::vector<Vector> b_;
+	bspl::basis_table<Parameter> N_;
+
+private:
+	bspline_fitting_kernel(const bspline_fitting_kernel&);
+	bspline_fitting_kernel& operator=(const bspline_fitting_kernel&);
+};
+
+}  // namespace impl
+
+/**
+ * @brief Fits a B-spline to positions in [first, last) within a
+ * @a tolerance.
+ *
+ * The positions are parameterized by bspl::parameterize() and fitted by
+ * least squares, the end control points interpolating the end positions.
+ * Each round moves the parameters toward the nearest positions on the
+ * curve, keeping their order, and inserts knots into the spans whose errors are over the
+ * tolerance, starting from a Bezier curve. The rounds end when the errors
+ * are within the tolerance or no span can be split.
+ *
+ * @param first The beginning of the positions.
+ * @param last The end of the positions, at least @a degree + 1 positions
+ * from @a first.
+ * @param degree The degree, at least 1.
+ * @param tolerance
+ * @param result The fitted B-spline.
+ * @param exponent The exponent of the parameterization, 0.5 for the
+ * centripetal and 1 for the chord length.
+ * @return The maximum distance from the positions to the curve at their
+ * parameters, or the maximum value leaving @a result unchanged if they
+ * cannot be fitted.
+ */
+template<typename InputRandomAccessIterator, typename Vector,
+		typename Parameter>
+typename vector_traits<Vector>::value_type fit(
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		std::size_t degree,
+		const typename vector_traits<Vector>::value_type& tolerance,
+		bspline<Vector, Parameter>& result,
+		const Parameter& exponent = Parameter(0.5)) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::vector<Vector> Q(first, last);
+	const std::ptrdiff_t m = Q.size();
+
+	std::vector<Parameter> t(m);
+	bspl::parameterize(Q.begin(), Q.end(), exponent, t.begin());
+	std::vector<Parameter> u(t);
+
+	const value_type tolerance2 = tolerance * tolerance;
+	std::vector<value_type> E(m);
+
+	impl::bspline_fitting_kernel<Vector, Parameter> kernel;
+	kernel.reset(degree);
+	if (!kernel.solve(Q, t)) {
+		return std::numeric_limits<value_type>::max();
+	}
+
+	value_type error = value_type(GK_FLOAT_ZERO);
+	while (true) {
+		E.front() = value_type(GK_FLOAT_ZERO);
+		E.back() = value_type(GK_FLOAT_ZERO);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+		{
+			bspl::basis_table<Parameter> N;
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(static)
+#endif
+			for (std::ptrdiff_t k = 1; k < m - 1; ++k) {
+				// The parameters stay in order between the middles of the
+				// neighbors.
+				const Parameter lower = Parameter(0.5) * (t[k - 1] + t[k]);
+				const Parameter upper = Parameter(0.5) * (t[k] + t[k + 1]);
+				E[k] = kernel.correct(Q[k], t[k], lower, upper, u[k], N);
+			}
+		}
+		t.swap(u);
+
+		error = *std::max_element(E.begin(), E.end());
+		if (!(error > tolerance2)) {
+			break;
+		}
+
+		const std::vector<Parameter> T = kernel.knots();
+		const std::vector<Vector> P = kernel.controls();
+		if (!kernel.refine(t, E, tolerance2)) {
+			break;
+		}
+		if (!kernel.solve(Q, t)) {
+			kernel.assign(T, P);
+			break;
+		}
+	}
+
+	result = bspline<Vector, Parameter>(kernel.knots().begin(),
+			kernel.knots().end(), kernel.controls().begin(),
+			kernel.controls().end());
+	return std::sqrt(error);
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_FITTING_H_ */
@@ -0,0 +1,482 @@
+/*
+ * interpolation.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_INTERPOLATION_H_
+#define BSPLINE_INTERPOLATION_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../algorithm/banded.h"
+#include "basis.h"
+#include "bspline.h"
+#include "fitting.h"
+
+namespace gk {
+
+namespace bspl {
+
+/**
+ * @brief Factorized collocation matrix of the global interpolation by
+ * B-splines at given parameters.
+ *
+ * The knots are the averages of the parameters (The NURBS Book, 9.8), and
+ * each row of the matrix holds the non-zero basis functions at a parameter,
+ * so that the matrix is banded and factorized by the banded LU in
+ * @f$O(np^2)@f$. An end derivative adds a row of the first derivatives of
+ * the basis functions after the first position or before the last one
+ * (The NURBS Book, 9.2.2). The matrix is factorized without pivoting. The
+ * derivative rows break the total positivity of the collocation matrix, but
+ * next to the rows of the end positions, whose only nonzero is on the
+ * diagonal, their pivots are the nonzero derivatives of the second and the
+ * second last basis functions at the ends.
+ *
+ * The matrix depends only on the parameters; the table is made once and
+ * solves the control points of any number of curves through positions at
+ * the same parameters, each by a back substitution. The table is read only
+ * while it solves, so that it is shared by threads.
+ *
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename Parameter>
+class interpolation_table {
+public:
+	typedef Parameter value_type;
+
+public:
+	interpolation_table() :
+			p_(0), m_(0), start_(false), end_(false), T_(), A_(), factorized_(
+					false) {
+	}
+
+	interpolation_table(const interpolation_table& other) :
+			p_(other.p_), m_(other.m_), start_(other.start_), end_(
+					other.end_), T_(other.T_), A_(other.A_), factorized_(
+					other.factorized_) {
+	}
+
+	/**
+	 * @brief Makes the table of a @a degree at parameters in [first, last).
+	 *
+	 * @param degree The degree, at least 2 with end derivatives.
+	 * @param first The beginning of the increasing parameters.
+	 * @param last The end of the parameters.
+	 * @param start_derivative true to constrain the first derivative at the
+	 * start.
+	 * @param end_derivative true to constrain the first derivative at the
+	 * end.
+	 */
+	template<typename InputRandomAccessIterator>
+	interpolation_table(std::size_t degree, InputRandomAccessIterator first,
+			InputRandomAccessIterator last, bool start_derivative = false,
+			bool end_derivative = false) :
+			p_(0), m_(0), start_(false), end_(false), T_(), A_(), factorized_(
+					false) {
+		this->reset(degree, first, last, start_derivative, end_derivative);
+	}
+
+	~interpolation_table() {
+	}
+
+	/**
+	 * @brief Returns true if the matrix is factorized, false if the
+	 * parameters are too few for the degree or the matrix is singular.
+	 */
+	bool is_factorized() const {
+		return this->factorized_;
+	}
+
+	std::size_t degree() const {
+		return this->p_;
+	}
+
+	/**
+	 * @brief Returns the number of the positions.
+	 */
+	std::size_t size() const {
+		return this->m_;
+	}
+
+	/**
+	 * @brief Returns the number of the control points, the positions and
+	 * the end derivatives.
+	 */
+	std::size_t control_size() const {
+		return this->A_.size();
+	}
+
+	const std::vector<Parameter>& knots() const {
+		return this->T_;
+	}
+
+	/**
+	 * @brief Returns true if the derivative at the start is constrained.
+	 */
+	bool has_start_derivative() const {
+		return this->start_;
+	}
+
+	/**
+	 * @brief Returns true if the derivative at the end is constrained.
+	 */
+	bool has_end_derivative() const {
+		return this->end_;
+	}
+
+	/**
+	 * @brief Makes the table of a @a degree at parameters in [first, last).
+	 *
+	 * @return is_factorized().
+	 */
+	template<typename InputRandomAccessIterator>
+	bool reset(std::size_t degree, InputRandomAccessIterator first,
+			InputRandomAccessIterator last, bool start_derivative = false,
+			bool end_derivative = false) {
+		const std::size_t p = degree;
+		const std::size_t m = std::distance(first, last);
+		const std::size_t n = m + start_derivative + end_derivative;
+
+		this->p_ = p;
+		this->m_ = m;
+		this->start_ = start_derivative;
+		this->end_ = end_derivative;
+		this->factorized_ = false;
+		this->T_.clear();
+		this->A_.reset(0, 0, 0);
+
+		if (m < 2 || p == 0 || n < p + 1
+				|| ((start_derivative || end_derivative) && p < 2)) {
+			return false;
+		}
+
+		// The parameters of the rows, each end repeated for its derivative.
+		std::vector<Parameter> t;
+		t.reserve(n);
+		if (start_derivative) {
+			t.push_back(first[0]);
+		}
+		t.insert(t.end(), first, last);
+		if (end_derivative) {
+			t.push_back(first[m - 1]);
+		}
+
+		this->T_.reserve(n + p + 1);
+		this->T_.assign(p + 1, t.front());
+		for (std::size_t j = 1; j < n - p; ++j) {
+			Parameter u = Parameter(GK_FLOAT_ZERO);
+			for (std::size_t i = j; i < j + p; ++i) {
+				u += t[i];
+			}
+			this->T_.push_back(u / Parameter(p));
+		}
+		this->T_.resize(n + p + 1, t.back());
+
+		// The rows of the derivatives are the second and the second last.
+		std::vector<std::size_t> S(n);
+		std::vector<std::size_t> D(n, 0);
+		if (start_derivative) {
+			D[1] = 1;
+		}
+		if (end_derivative) {
+			D[n - 2] = 1;
+		}
+
+		std::size_t l = 0;
+		std::size_t u = 0;
+		for (std::size_t r = 0; r < n; ++r) {
+			S[r] = std::distance(this->T_.begin(),
+					segment_of(p, this->T_.begin(), this->T_.end(), t[r]));
+			if (r + p > S[r]) {
+				l = std::max(l, r + p - S[r]);
+			}
+			if (S[r] > r) {
+				u = std::max(u, S[r] - r);
+			}
+		}
+
+		basis_table<Parameter> N;
+		this->A_.reset(n, l, u);
+		for (std::size_t r = 0; r < n; ++r) {
+			N.compute(p, this->T_.begin(), S[r], t[r], D[r]);
+			for (std::size_t j = 0; j <= p; ++j) {
+				this->A_(r, S[r] - p + j) = N(D[r], j);
+			}
+		}
+
+		this->factorized_ = alg::lu(this->A_);
+		return this->factorized_;
+	}
+
+	/**
+	 * @brief Solves the control points of a curve through positions without
+	 * end derivatives.
+	 *
+	 * @param first The beginning of the positions, size().
+	 * @param result The beginning of the control points, control_size().
+	 * @return The end of the control points.
+	 */
+	template<typename InputRandomAccessIterator,
+			typename OutputRandomAccessIterator>
+	OutputRandomAccessIterator operator()(InputRandomAccessIterator first,
+			OutputRandomAccessIterator result) const {
+		typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+		return this->operator()(first, vector_type(first[0]),
+				vector_type(first[0]), result);
+	}
+
+	/**
+	 * @brief Solves the control points of a curve through positions with
+	 * end derivatives.
+	 *
+	 * @param first The beginning of the positions, size().
+	 * @param start_derivative The derivative at the start, used if the
+	 * table constrains it.
+	 * @param end_derivative The derivative at the end, used if the table
+	 * constrains it.
+	 * @param result The beginning of the control points, control_size().
+	 * @return The end of the control points.
+	 */
+	template<typename InputRandomAccessIterator, typename Vector,
+			typename OutputRandomAccessIterator>
+	OutputRandomAccessIterator operator()(InputRandomAccessIterator first,
+			const Vector& start_derivative, const Vector& end_derivative,
+			OutputRandomAccessIterator result) const {
+		const std::size_t n = this->A_.size();
+
+		std::size_t r = 0;
+		result[r++] = first[0];
+		if (this->start_) {
+			result[r++] = start_derivative;
+		}
+		for (std::size_t k = 1; k + 1 < this->m_; ++k) {
+			result[r++] = first[k];
+		}
+		if (this->end_) {
+			result[r++] = end_derivative;
+		}
+		result[r++] = first[this->m_ - 1];
+
+		alg::lu_solve(this->A_, result);
+		return result + n;
+	}
+
+	interpolation_table& operator=(const interpolation_table& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->p_ = rhs.p_;
+		this->m_ = rhs.m_;
+		this->start_ = rhs.start_;
+		this->end_ = rhs.end_;
+		this->T_ = rhs.T_;
+		this->A_ = rhs.A_;
+		this->factorized_ = rhs.factorized_;
+		return *this;
+	}
+
+private:
+	std::size_t p_; ///< The degree.
+	std::size_t m_; ///< The number of the positions.
+	bool start_; ///< Whether the start derivative is constrained.
+	bool end_; ///< Whether the end derivative is constrained.
+	std::vector<Parameter> T_; ///< The knots.
+	banded_matrix<Parameter> A_; ///< The LU factors of the collocation matrix.
+	bool factorized_;
+};
+
+}  // namespace bspl
+
+/**
+ * @brief Interpolates positions in [first, last) by a B-spline.
+ *
+ * @param first The beginning of the positions.
+ * @param last The end of the positions, at least @a degree + 1 positions
+ * from @a first.
+ * @param degree
+ * @param result The B-spline through the positions on [0, 1].
+ * @param exponent The exponent of the parameterization, 0.5 for the
+ * centripetal and 1 for the chord length.
+ * @return false leaving @a result unchanged if the positions cannot be
+ * interpolated.
+ *
+ * @see bspl::parameterize()
+ */
+template<typename InputRandomAccessIterator, typename Vector,
+		typename Parameter>
+bool interpolate(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, std::size_t degree,
+		bspline<Vector, Parameter>& result,
+		const Parameter& exponent = Parameter(0.5)) {
+	std::vector<Parameter> t(std::distance(first, last));
+	bspl::parameterize(first, last, exponent, t.begin());
+
+	const bspl::interpolation_table<Parameter> X(degree, t.begin(), t.end());
+	if (!X.is_factorized()) {
+		return false;
+	}
+
+	std::vector<Vector> P(X.control_size());
+	X(first, P.begin());
+	result = bspline<Vector, Parameter>(X.knots().begin(), X.knots().end(),
+			P.begin(), P.end());
+	return true;
+}
+
+/**
+ * @brief Interpolates positions in [first, last) by a B-spline with its
+ * first derivatives at the ends.
+ *
+ * @param first The beginning of the positions.
+ * @param last The end of the positions.
+ * @param degree The degree, at least 2.
+ * @param start_derivative The derivative at the start by the parameter on
+ * [0, 1].
+ * @param end_derivative The derivative at the end.
+ * @param result The B-spline through the positions on [0, 1].
+ * @param exponent The exponent of the parameterization.
+ * @return false leaving @a result unchanged if the positions cannot be
+ * interpolated.
+ */
+template<typename InputRandomAccessIterator, typename Vector,
+		typename Parameter>
+bool interpolate(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, std::size_t degree,
+		const Vector& start_derivative, const Vector& end_derivative,
+		bspline<Vector, Parameter>& result,
+		const Parameter& exponent = Parameter(0.5)) {
+	std::vector<Parameter> t(std::distance(first, last));
+	bspl::parameterize(first, last, exponent, t.begin());
+
+	const bspl::interpolation_table<Parameter> X(degree, t.begin(), t.end(),
+			true, true);
+	if (!X.is_factorized()) {
+		return false;
+	}
+
+	std::vector<Vector> P(X.control_size());
+	X(first, start_derivative, end_derivative, P.begin());
+	result = bspline<Vector, Parameter>(X.knots().begin(), X.knots().end(),
+			P.begin(), P.end());
+	return true;
+}
+
+/**
+ * @brief Interpolates the curves of positions in [first, last) by
+ * B-splines sharing a table, without end derivatives.
+ *
+ * The matrix is factorized once in the table and each curve costs a back
+ * substitution. The curves are processed in parallel when OpenMP is
+ * enabled.
+ *
+ * @param X The table, factorized without end derivatives.
+ * @param first The beginning of the containers of the positions, each of
+ * X.size() positions.
+ * @param last The end of the containers.
+ * @param result The beginning of the B-splines.
+ * @return The end of the B-splines, or @a result without writing any if
+ * the table is not factorized or constrains end derivatives.
+ */
+template<typename Parameter, typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator interpolate(
+		const bspl::interpolation_table<Parameter>& X,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type container_type;
+	typedef typename container_type::value_type vector_type;
+	typedef bspline<vector_type, Parameter> bspline_type;
+
+	if (!X.is_factorized() || X.has_start_derivative()
+			|| X.has_end_derivative()) {
+		return result;
+	}
+
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		std::vector<vector_type> P(X.control_size());
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(static)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			X(first[i].begin(), P.begin());
+			result[i] = bspline_type(X.knots().begin(), X.knots().end(),
+					P.begin(), P.end());
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Interpolates the curves of positions in [first, last) by
+ * B-splines sharing a table, with their first derivatives at the ends.
+ *
+ * @param X The table, factorized.
+ * @param first The beginning of the containers of the positions, each of
+ * X.size() positions.
+ * @param last The end of the containers.
+ * @param start_derivatives The beginning of the derivatives at the starts
+ * of the curves, used if the table constrains them.
+ * @param end_derivatives The beginning of the derivatives at the ends of
+ * the curves, used if the table constrains them.
+ * @param result The beginning of the B-splines.
+ * @return The end of the B-splines, or @a result without writing any if
+ * the table is not factorized.
+ * @see interpolate(const bspl::interpolation_table<Parameter>&, InputRandomAccessIterator, InputRandomAccessIterator, OutputRandomAccessIterator)
+ */
+template<typename Parameter, typename InputRandomAccessIterator,
+		typename DerivativeRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator interpolate(
+		const bspl::interpolation_table<Parameter>& X,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		DerivativeRandomAccessIterator start_derivatives,
+		DerivativeRandomAccessIterator end_derivatives,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type container_type;
+	typedef typename container_type::value_type vector_type;
+	typedef bspline<vector_type, Parameter> bspline_type;
+
+	if (!X.is_factorized()) {
+		return result;
+	}
+
+	const std::ptrdiff_t n = std::distance(first, last);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		std::vector<vector_type> P(X.control_size());
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(static)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			X(first[i].begin(), vector_type(start_derivatives[i]),
+					vector_type(end_derivatives[i]), P.begin());
+			result[i] = bspline_type(X.knots().begin(), X.knots().end(),
+					P.begin(), P.end());
+		}
+	}
+
+	return result + n;
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_INTERPOLATION_H_ */
@@ -0,0 +1,452 @@
+/*
+ * knot_removal.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_KNOT_REMOVAL_H_
+#define BSPLINE_KNOT_REMOVAL_H_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "basis.h"
+#include "bspline.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Removes knots of B-splines within a tolerance (The NURBS Book,
+ * A5.8).
+ *
+ * The bounds of the errors of the removals are accumulated for each knot
+ * span, so that the distance of the result from the original curve is
+ * bounded by the tolerance over the whole curve, however many knots are
+ * removed around a span.
+ *
+ * The knots and the control points are kept in two arrays each, the
+ * processed ones and the rest, which are joined at the position of the knot
+ * being removed. A removal only drops elements at the end of the processed
+ * ones, and moving the position along the curve moves a few elements
+ * between the arrays, so that removing all the removable knots of a curve
+ * takes a time linear in its size. An instance keeps its buffers, so it is
+ * made once for each thread.
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter>
+class knot_removal_kernel {
+public:
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	knot_removal_kernel() :
+			U_(), V_(), E_(), F_(), P_(), Q_(), temp_(), ku_(0), kp_(0), nk_(
+					0), np_(0) {
+	}
+
+	~knot_removal_kernel() {
+	}
+
+	/**
+	 * @brief Removes all the removable interior knots of a B-spline.
+	 *
+	 * The knots are examined once from the beginning, each as many times as
+	 * its multiplicity.
+	 *
+	 * @param p Degree.
+	 * @param U_first The beginning of the clamped knot vector.
+	 * @param U_last The end of the knot vector.
+	 * @param P The beginning of the control points.
+	 * @param tolerance The maximum distance from the original curve.
+	 * @return The number of the removed knots. The result is given by
+	 * knots() and controls().
+	 */
+	template<typename KnotRandomAccessIterator,
+			typename VectorRandomAccessIterator>
+	std::size_t compress(std::size_t p, KnotRandomAccessIterator U_first,
+			KnotRandomAccessIterator U_last, VectorRandomAccessIterator P,
+			const value_type& tolerance) {
+		this->load_(p, U_first, U_last, P);
+
+		std::size_t removed = 0;
+		std::size_t r = p + 1;
+		while (r < this->np_) {
+			const Parameter u = this->knot_(r);
+			std::size_t s = 1;
+			while (r + 1 < this->np_ && this->knot_(r + 1) == u) {
+				++r;
+				++s;
+			}
+
+			const std::size_t t =
+					(s <= p) ? this->remove_(p, r, s, s, tolerance) : 0;
+			removed += t;
+			r = r - t + 1;
+		}
+
+		this->seek_knots_(this->nk_);
+		this->seek_points_(this->np_);
+		return removed;
+	}
+
+	/**
+	 * @brief Removes an interior knot @a u of a B-spline at most @a num
+	 * times.
+	 *
+	 * @param p Degree.
+	 * @param U_first The beginning of the clamped knot vector.
+	 * @param U_last The end of the knot vector.
+	 * @param P The beginning of the control points.
+	 * @param u The knot.
+	 * @param num The maximum number of the removals.
+	 * @param tolerance The maximum distance from the original curve.
+	 * @return The number of the removals. The result is given by knots()
+	 * and controls().
+	 */
+	template<typename KnotRandomAccessIterator,
+			typename VectorRandomAccessIterator>
+	std::size_t remove(std::size_t p, KnotRandomAccessIterator U_first,
+			KnotRandomAccessIterator U_last, VectorRandomAccessIterator P,
+			const Parameter& u, std::size_t num, const value_type& tolerance) {
+		this->load_(p, U_first, U_last, P);
+
+		std::size_t t = 0;
+		const typename std::vector<Parameter>::const_iterator q =
+				std::upper_bound(this->V_.begin() + p + 1,
+						this->V_.begin() + this->np_, u);
+		const std::size_t r = (q - this->V_.begin()) - 1;
+		if (r > p && this->V_[r] == u) {
+			std::size_t s = 1;
+			while (s < r && this->V_[r - s] == u) {
+				++s;
+			}
+			if (s <= p) {
+				t = this->remove_(p, r, s, std::min(num, s), tolerance);
+			}
+		}
+
+		this->seek_knots_(this->nk_);
+		this->seek_points_(this->np_);
+		return t;
+	}
+
+	/**
+	 * @brief Returns the knots of the result.
+	 */
+	const std::vector<Parameter>& knots() const {
+		return this->U_;
+	}
+
+	/**
+	 * @brief Returns the control points of the result.
+	 */
+	const std::vector<Vector>& controls() const {
+		return this->P_;
+	}
+
+private:
+	std::vector<Parameter> U_; ///< The processed knots.
+	std::vector<Parameter> V_; ///< The rest of the knots from ku_.
+	std::vector<value_type> E_; ///< The error bounds of the processed knot spans.
+	std::vector<value_type> F_; ///< The error bounds of the rest of the knot spans.
+	std::vector<Vector> P_; ///< The processed control points.
+	std::vector<Vector> Q_; ///< The rest of the control points from kp_.
+	std::vector<Vector> temp_;
+	std::size_t ku_;
+	std::size_t kp_;
+	std::size_t nk_; ///< The number of the knots.
+	std::size_t np_; ///< The number of the control points.
+
+private:
+	knot_removal_kernel(const knot_removal_kernel&);
+	knot_removal_kernel& operator=(const knot_removal_kernel&);
+
+	template<typename KnotRandomAccessIterator,
+			typename VectorRandomAccessIterator>
+	void load_(std::size_t p, KnotRandomAccessIterator U_first,
+			KnotRandomAccessIterator U_last, VectorRandomAccessIterator P) {
+		this->nk_ = std::distance(U_first, U_last);
+		this->np_ = this->nk_ - p - 1;
+
+		this->V_.assign(U_first, U_last);
+		this->F_.assign(this->nk_, value_type(GK_FLOAT_ZERO));
+		this->Q_.assign(P, P + this->np_);
+		this->U_.clear();
+		this->E_.clear();
+		this->P_.clear();
+		this->U_.reserve(this->nk_);
+		this->E_.reserve(this->nk_);
+		this->P_.reserve(this->np_);
+		this->ku_ = 0;
+		this->kp_ = 0;
+		this->temp_.resize(2 * p + 2);
+	}
+
+	Parameter knot_(std::size_t k) const {
+		return (k < this->U_.size()) ?
+				this->U_[k] : this->V_[this->ku_ + k - this->U_.size()];
+	}
+
+	value_type& error_(std::size_t k) {
+		return (k < this->E_.size()) ?
+				this->E_[k] : this->F_[this->ku_ + k - this->E_.size()];
+	}
+
+	Vector& point_(std::size_t k) {
+		return (k < this->P_.size()) ?
+				this->P_[k] : this->Q_[this->kp_ + k - this->P_.size()];
+	}
+
+	/**
+	 * @brief Moves the joint of the knots to an index @a k.
+	 */
+	void seek_knots_(std::size_t k) {
+		while (this->U_.size() < k) {
+			this->U_.push_back(this->V_[this->ku_]);
+			this->E_.push_back(this->F_[this->ku_]);
+			++this->ku_;
+		}
+		while (this->U_.size() > k) {
+			--this->ku_;
+			this->V_[this->ku_] = this->U_.back();
+			this->F_[this->ku_] = this->E_.back();
+			this->U_.pop_back();
+			this->E_.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Moves the joint of the control points to an index @a k.
+	 */
+	void seek_points_(std::size_t k) {
+		while (this->P_.size() < k) {
+			this->P_.push_back(this->Q_[this->kp_]);
+			++this->kp_;
+		}
+		while (this->P_.size() > k) {
+			--this->kp_;
+			this->Q_[this->kp_] = this->P_.back();
+			this->P_.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Removes the knot at an index @a r of a multiplicity @a s at
+	 * most @a num times.
+	 * @return The number of the removals.
+	 */
+	std::size_t remove_(std::size_t p, std::size_t r, std::size_t s,
+			std::size_t num, const value_type& tolerance) {
+		const Parameter One(GK_FLOAT_ONE);
+		const Parameter u = this->knot_(r);
+		const std::ptrdiff_t ord = p + 1;
+
+		std::ptrdiff_t first = r - p;
+		std::ptrdiff_t last = r - s;
+		std::size_t t = 0;
+		for (; t < num && first > 0; ++t) {
+			const std::ptrdiff_t tt = t;
+			const std::ptrdiff_t off = first - 1;
+			this->temp_[0] = this->point_(off);
+			this->temp_[last + 1 - off] = this->point_(last + 1);
+
+			std::ptrdiff_t i = first;
+			std::ptrdiff_t j = last;
+			std::ptrdiff_t ii = 1;
+			std::ptrdiff_t jj = last - off;
+			while (j - i > tt) {
+				const Parameter alfi = (u - this->knot_(i))
+						/ (this->knot_(i + ord + tt) - this->knot_(i));
+				const Parameter alfj = (u - this->knot_(j - tt))
+						/ (this->knot_(j + ord) - this->knot_(j - tt));
+				this->temp_[ii] = (One / alfi)
+						* (this->point_(i) - (One - alfi) * this->temp_[ii - 1]);
+				this->temp_[jj] = (One / (One - alfj))
+						* (this->point_(j) - alfj * this->temp_[jj + 1]);
+				++i;
+				++ii;
+				--j;
+				--jj;
+			}
+
+			value_type br;
+			if (j - i < tt) {
+				br = norm(Vector(this->temp_[ii - 1] - this->temp_[jj + 1]));
+			} else {
+				const Parameter alfi = (u - this->knot_(i))
+						/ (this->knot_(i + ord + tt) - this->knot_(i));
+				br = norm(
+						Vector(
+								this->point_(i)
+										- (alfi * this->temp_[ii + tt + 1]
+												+ (One - alfi)
+														* this->temp_[ii - 1])));
+			}
+
+			// The moved points change the curve on their knot spans.
+			const std::size_t k0 = first;
+			const std::size_t k1 = std::min(std::size_t(last) + p,
+					this->nk_ - 2);
+			value_type e = br;
+			for (std::size_t k = k0; k <= k1; ++k) {
+				e = std::max(e, this->error_(k) + br);
+			}
+			if (!(e <= tolerance)) {
+				break;
+			}
+			for (std::size_t k = k0; k <= k1; ++k) {
+				this->error_(k) += br;
+			}
+
+			i = first;
+			j = last;
+			while (j - i > tt) {
+				this->point_(i) = this->temp_[i - off];
+				this->point_(j) = this->temp_[j - off];
+				++i;
+				--j;
+			}
+			--first;
+			++last;
+		}
+
+		if (t == 0) {
+			return 0;
+		}
+
+		// Drops the knots r - t + 1, ..., r, merging the spans around them.
+		this->seek_knots_(r + 1);
+		for (std::size_t k = 0; k < t; ++k) {
+			const std::size_t b = this->E_.size() - 1;
+			this->E_[b - 1] = std::max(this->E_[b - 1], this->E_[b]);
+			this->U_.pop_back();
+			this->E_.pop_back();
+		}
+
+		// Drops the control points j, ..., i around the middle of the ones
+		// moved.
+		std::size_t i = (2 * r - s - p) / 2;
+		for (std::size_t k = 1; k < t; ++k) {
+			if (k % 2 == 1) {
+				++i;
+			}
+		}
+		this->seek_points_(i + 1);
+		for (std::size_t k = 0; k < t; ++k) {
+			this->P_.pop_back();
+		}
+
+		this->nk_ -= t;
+		this->np_ -= t;
+		return t;
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Removes an interior knot of a B-spline within a tolerance.
+ *
+ * @param x The B-spline of a clamped knot vector, replaced with the result.
+ * @param u The knot.
+ * @param num The maximum number of the removals.
+ * @param tolerance The maximum distance from the original curve.
+ * @return The number of the removals.
+ */
+template<typename Vector, typename Parameter>
+std::size_t remove_knot(bspline<Vector, Parameter>& x, const Parameter& u,
+		std::size_t num,
+		const typename vector_traits<Vector>::value_type& tolerance) {
+	impl::knot_removal_kernel<Vector, Parameter> kernel;
+
+	const std::size_t t = kernel.remove(x.degree(), x.knot_vector().begin(),
+			x.knot_vector().end(), x.controls().begin(), u, num, tolerance);
+	if (t > 0) {
+		x = bspline<Vector, Parameter>(kernel.knots().begin(),
+				kernel.knots().end(), kernel.controls().begin(),
+				kernel.controls().end());
+	}
+	return t;
+}
+
+/**
+ * @brief Removes all the removable interior knots of a B-spline within a
+ * tolerance.
+ *
+ * @param x The B-spline of a clamped knot vector, replaced with the result.
+ * @param tolerance The maximum distance from the original curve.
+ * @return The number of the removed knots.
+ */
+template<typename Vector, typename Parameter>
+std::size_t compress(bspline<Vector, Parameter>& x,
+		const typename vector_traits<Vector>::value_type& tolerance) {
+	impl::knot_removal_kernel<Vector, Parameter> kernel;
+
+	const std::size_t t = kernel.compress(x.degree(), x.knot_vector().begin(),
+			x.knot_vector().end(), x.controls().begin(), tolerance);
+	if (t > 0) {
+		x = bspline<Vector, Parameter>(kernel.knots().begin(),
+				kernel.knots().end(), kernel.controls().begin(),
+				kernel.controls().end());
+	}
+	return t;
+}
+
+/**
+ * @brief Removes all the removable interior knots of B-splines in
+ * [first, last) within a tolerance.
+ *
+ * The B-splines are processed in parallel when OpenMP is enabled.
+ *
+ * @param first The beginning of the B-splines, replaced with the results.
+ * @param last The end of the B-splines.
+ * @param tolerance The maximum distance from the original curves.
+ * @return The number of the removed knots.
+ */
+template<typename RandomAccessIterator, typename T>
+std::size_t compress(RandomAccessIterator first, RandomAccessIterator last,
+		const T& tolerance) {
+	typedef typename std::iterator_traits<RandomAccessIterator>::value_type bspline_type;
+	typedef typename bspline_type::vector_type vector_type;
+	typedef typename bspline_type::knotvector_type::value_type parameter_type;
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	std::size_t removed = 0;
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::knot_removal_kernel<vector_type, parameter_type> kernel;
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic) reduction(+:removed)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			bspline_type& x = first[i];
+			const std::size_t t = kernel.compress(x.degree(),
+					x.knot_vector().begin(), x.knot_vector().end(),
+					x.controls().begin(), tolerance);
+			if (t > 0) {
+				x = bspline_type(kernel.knots().begin(), kernel.knots().end(),
+						kernel.controls().begin(), kernel.controls().end());
+			}
+			removed += t;
+		}
+	}
+
+	return removed;
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_KNOT_REMOVAL_H_ */
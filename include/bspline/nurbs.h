@@ -0,0 +1,603 @@
+/*
+ * nurbs.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef BSPLINE_NURBS_H_
+#define BSPLINE_NURBS_H_
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "basis.h"
+#include "bspline.h"
+#include "bsurface.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Returns the homogeneous vector of a position @a v of a weight
+ * @a w, @f$(w\mathbf{v}, w)@f$.
+ */
+template<typename Homogeneous, typename Vector>
+Homogeneous to_homogeneous(const Vector& v,
+		const typename vector_traits<Vector>::value_type& w) {
+	const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+	Homogeneous h;
+	for (std::size_t i = 0; i < Dimension; ++i) {
+		h[i] = w * v[i];
+	}
+	h[Dimension] = w;
+	return h;
+}
+
+/**
+ * @brief Returns the first components of a homogeneous vector @a h scaled
+ * by @a scale, without the weight.
+ */
+template<typename Vector, typename Homogeneous>
+Vector project_homogeneous(const Homogeneous& h,
+		const typename vector_traits<Vector>::value_type& scale) {
+	const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+	Vector v;
+	for (std::size_t i = 0; i < Dimension; ++i) {
+		v[i] = scale * h[i];
+	}
+	return v;
+}
+
+}  // namespace impl
+
+/**
+ * @brief NURBS (Non-Uniform Rational B-spline) curve.
+ *
+ * The control points are stored contiguously as homogeneous vectors
+ * @f$(w_i\mathbf{P}_i, w_i)@f$ in a B-spline of one more dimension, so
+ * that the knot insertion and the subdivision of the B-spline apply to
+ * this as they are. A position and its derivatives are evaluated from the
+ * non-zero basis functions of the span and divided by the weight once
+ * (The NURBS Book, A4.2).
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter>
+class nurbs: public geometry<free_curve_tag, Vector> {
+public:
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename homogeneous_vector<Vector>::type homogeneous_type;
+	typedef bspline<homogeneous_type, Parameter> homogeneous_bspline;
+	typedef typename homogeneous_bspline::knotvector_type knotvector_type;
+
+	static const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+public:
+	nurbs() :
+			X_() {
+	}
+
+	nurbs(const nurbs& other) :
+			X_(other.X_) {
+	}
+
+	/**
+	 * @brief Constructs the curve of the homogeneous control points of a
+	 * B-spline @a x.
+	 */
+	explicit nurbs(const homogeneous_bspline& x) :
+			X_(x) {
+	}
+
+	/**
+	 * @brief Constructs the curve of a B-spline @a x with the weights 1.
+	 */
+	explicit nurbs(const bspline<Vector, Parameter>& x) :
+			X_() {
+		const typename bspline<Vector, Parameter>::control_points& Q =
+				x.controls();
+
+		std::vector<homogeneous_type> P(Q.size());
+		for (std::size_t i = 0; i < Q.size(); ++i) {
+			P[i] = impl::to_homogeneous<homogeneous_type>(Q[i],
+					value_type(GK_FLOAT_ONE));
+		}
+		this->X_ = homogeneous_bspline(x.knot_vector().begin(),
+				x.knot_vector().end(), P.begin(), P.end());
+	}
+
+	/**
+	 * @brief Constructs the curve of control points and their weights.
+	 * @param T_first The beginning of the knot vector.
+	 * @param T_last The end of the knot vector.
+	 * @param Q_first The beginning of the control points.
+	 * @param Q_last The end of the control points.
+	 * @param W_first The beginning of the weights, positive.
+	 */
+	template<typename KnotInputIterator, typename VectorInputIterator,
+			typename WeightInputIterator>
+	nurbs(KnotInputIterator T_first, KnotInputIterator T_last,
+			VectorInputIterator Q_first, VectorInputIterator Q_last,
+			WeightInputIterator W_first) :
+			X_() {
+		std::vector<homogeneous_type> P;
+		for (; Q_first != Q_last; ++Q_first, ++W_first) {
+			P.push_back(
+					impl::to_homogeneous<homogeneous_type>(
+							Vector(*Q_first), value_type(*W_first)));
+		}
+		this->X_ = homogeneous_bspline(T_first, T_last, P.begin(), P.end());
+	}
+
+	~nurbs() {
+	}
+
+	std::size_t degree() const {
+		return this->X_.degree();
+	}
+
+	const knotvector_type& knot_vector() const {
+		return this->X_.knot_vector();
+	}
+
+	std::pair<Parameter, Parameter> domain() const {
+		return this->X_.domain();
+	}
+
+	/**
+	 * @brief Returns the number of the control points.
+	 */
+	std::size_t size() const {
+		return this->X_.controls().size();
+	}
+
+	/**
+	 * @brief Returns the B-spline of the homogeneous control points.
+	 */
+	const homogeneous_bspline& homogeneous() const {
+		return this->X_;
+	}
+
+	homogeneous_bspline& homogeneous() {
+		return this->X_;
+	}
+
+	/**
+	 * @brief Returns the control point of an index @a i.
+	 */
+	Vector control(std::size_t i) const {
+		const homogeneous_type& h = this->X_.controls()[i];
+		return impl::project_homogeneous<Vector>(h,
+				value_type(GK_FLOAT_ONE) / h[Dimension]);
+	}
+
+	/**
+	 * @brief Returns the weight of the control point of an index @a i.
+	 */
+	value_type weight(std::size_t i) const {
+		return this->X_.controls()[i][Dimension];
+	}
+
+	void insert(const Parameter& t) {
+		this->X_.insert(t);
+	}
+
+	/**
+	 * @brief Subdivides this at a parameter @a t.
+	 * @see bspline::subdivide()
+	 */
+	nurbs subdivide(const Parameter& t, gkselection selection = GK::Upper) {
+		return nurbs(this->X_.subdivide(t, selection));
+	}
+
+	/**
+	 * @brief Computes the derivatives @f$\mathbf{C}^{(k)}@f$ for all
+	 * @f$k \le d@f$ at a parameter @a t.
+	 *
+	 * @param t
+	 * @param d The maximum derivative order.
+	 * @param out The beginning of @f$d + 1@f$ vectors, the position first.
+	 * @return The end of the output.
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& t, std::size_t d,
+			RandomAccessIterator out) const {
+		bspl::basis_table<Parameter> N;
+		return this->derivatives(t, d, out, N);
+	}
+
+	/**
+	 * @brief Computes the derivatives with a table given by a caller, which
+	 * keeps its buffers between calls.
+	 * @see derivatives(const Parameter&, std::size_t, RandomAccessIterator) const
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& t, std::size_t d,
+			RandomAccessIterator out, bspl::basis_table<Parameter>& N) const {
+		const std::vector<homogeneous_type>& P = this->X_.controls();
+		const std::size_t p = this->X_.degree();
+		const std::size_t i0 = N.compute(p, this->X_.knot_vector().begin(),
+				this->X_.knot_vector().end(), t, d) - p;
+
+		value_type w[1] = { value_type(GK_FLOAT_ZERO) };
+		for (std::size_t j = 0; j <= p; ++j) {
+			w[0] += N(0, j) * P[i0 + j][Dimension];
+		}
+		const value_type inverse = value_type(GK_FLOAT_ONE) / w[0];
+
+		for (std::size_t k = 0; k <= d; ++k) {
+			homogeneous_type a = N(k, 0) * P[i0];
+			for (std::size_t j = 1; j <= p; ++j) {
+				a += N(k, j) * P[i0 + j];
+			}
+
+			// C(k) = (A(k) - sum binomial(k, i) w(i) C(k - i)) / w.
+			Vector c = impl::project_homogeneous<Vector>(a, inverse);
+			for (std::size_t i = 1; i <= k; ++i) {
+				value_type wi = value_type(GK_FLOAT_ZERO);
+				for (std::size_t j = 0; j <= p; ++j) {
+					wi += N(i, j) * P[i0 + j][Dimension];
+				}
+				c = c
+						- (bspl::binomial<value_type>(k, i) * wi * inverse)
+								* Vector(out[k - i]);
+			}
+			out[k] = c;
+		}
+
+		return out + (d + 1);
+	}
+
+	/**
+	 * @brief Computes the position at a parameter @a t.
+	 */
+	Vector operator()(const Parameter& t) const {
+		Vector r;
+		this->derivatives(t, 0, &r);
+		return r;
+	}
+
+	nurbs& operator=(const nurbs& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		return *this;
+	}
+
+private:
+	homogeneous_bspline X_; ///< The B-spline of the homogeneous control points.
+};
+
+/**
+ * @brief Converts a NURBS curve of equal weights into a B-spline.
+ *
+ * @param x
+ * @param result The B-spline of the same shape.
+ * @return false leaving @a result unchanged if the weights are not equal,
+ * since the curve is not polynomial.
+ */
+template<typename Vector, typename Parameter>
+bool to_bspline(const nurbs<Vector, Parameter>& x,
+		bspline<Vector, Parameter>& result) {
+	for (std::size_t i = 1; i < x.size(); ++i) {
+		if (x.weight(i) != x.weight(0)) {
+			return false;
+		}
+	}
+
+	std::vector<Vector> Q(x.size());
+	for (std::size_t i = 0; i < Q.size(); ++i) {
+		Q[i] = x.control(i);
+	}
+	result = bspline<Vector, Parameter>(x.knot_vector().begin(),
+			x.knot_vector().end(), Q.begin(), Q.end());
+	return true;
+}
+
+/**
+ * @brief NURBS surface.
+ *
+ * The control points are stored as homogeneous vectors in a B-spline
+ * surface of one more dimension, as nurbs does. The partial derivatives are
+ * evaluated by bsurface::derivatives() on the homogeneous network and
+ * divided by the weight once (The NURBS Book, A4.4).
+ *
+ * @tparam Vector Type of a control point.
+ * @tparam Parameter Type of a parameter.
+ * @tparam Allocator Type of an allocator, rebound for the homogeneous
+ * control points.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector, typename Parameter,
+		typename Allocator = std::allocator<Vector> >
+class nurbs_surface {
+public:
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename homogeneous_vector<Vector>::type homogeneous_type;
+	typedef typename rebind_allocator<Allocator, homogeneous_type>::type homogeneous_allocator_type;
+	typedef bsurface<homogeneous_type, Parameter, homogeneous_allocator_type> homogeneous_bsurface;
+	typedef typename homogeneous_bsurface::knotvector_type knotvector_type;
+	typedef typename homogeneous_bsurface::network_type network_type;
+
+	static const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+public:
+	nurbs_surface() :
+			X_() {
+	}
+
+	nurbs_surface(const nurbs_surface& other) :
+			X_(other.X_) {
+	}
+
+	/**
+	 * @brief Constructs the surface of the homogeneous control points of a
+	 * B-spline surface @a x.
+	 */
+	explicit nurbs_surface(const homogeneous_bsurface& x) :
+			X_(x) {
+	}
+
+	/**
+	 * @brief Constructs the surface of a B-spline surface @a x with the
+	 * weights 1.
+	 */
+	template<typename OtherAllocator>
+	explicit nurbs_surface(const bsurface<Vector, Parameter, OtherAllocator>& x) :
+			X_() {
+		const network<Vector, OtherAllocator>& Q = x.controls();
+
+		network_type P(Q.major_size(), Q.minor_size());
+		for (std::size_t j = 0; j < Q.minor_size(); ++j) {
+			for (std::size_t i = 0; i < Q.major_size(); ++i) {
+				P(i, j) = impl::to_homogeneous<homogeneous_type>(Q(i, j),
+						value_type(GK_FLOAT_ONE));
+			}
+		}
+		this->X_ = homogeneous_bsurface(x.major_knot_vector().begin(),
+				x.major_knot_vector().end(), x.minor_knot_vector().begin(),
+				x.minor_knot_vector().end(), P);
+	}
+
+	/**
+	 * @brief Constructs the surface of control points and their weights.
+	 * @param S_first The beginning of the knot vector in major order.
+	 * @param S_last The end of the knot vector in major order.
+	 * @param T_first The beginning of the knot vector in minor order.
+	 * @param T_last The end of the knot vector in minor order.
+	 * @param Q_first The beginning of the control points, major index first.
+	 * @param Q_last The end of the control points.
+	 * @param W_first The beginning of the weights in the same order.
+	 * @param major_size The number of the control points in major order.
+	 */
+	template<typename KnotInputIterator1, typename KnotInputIterator2,
+			typename VectorInputIterator, typename WeightInputIterator>
+	nurbs_surface(KnotInputIterator1 S_first, KnotInputIterator1 S_last,
+			KnotInputIterator2 T_first, KnotInputIterator2 T_last,
+			VectorInputIterator Q_first, VectorInputIterator Q_last,
+			WeightInputIterator W_first, std::size_t major_size) :
+			X_() {
+		std::vector<homogeneous_type, homogeneous_allocator_type> P;
+		for (; Q_first != Q_last; ++Q_first, ++W_first) {
+			P.push_back(
+					impl::to_homogeneous<homogeneous_type>(
+							Vector(*Q_first), value_type(*W_first)));
+		}
+		this->X_ = homogeneous_bsurface(S_first, S_last, T_first, T_last,
+				P.begin(), P.end(), major_size);
+	}
+
+	~nurbs_surface() {
+	}
+
+	std::size_t major_degree() const {
+		return this->X_.major_degree();
+	}
+
+	std::size_t minor_degree() const {
+		return this->X_.minor_degree();
+	}
+
+	const knotvector_type& major_knot_vector() const {
+		return this->X_.major_knot_vector();
+	}
+
+	const knotvector_type& minor_knot_vector() const {
+		return this->X_.minor_knot_vector();
+	}
+
+	std::pair<Parameter, Parameter> major_domain() const {
+		return this->X_.major_domain();
+	}
+
+	std::pair<Parameter, Parameter> minor_domain() const {
+		return this->X_.minor_domain();
+	}
+
+	/**
+	 * @brief Returns the B-spline surface of the homogeneous control points.
+	 */
+	const homogeneous_bsurface& homogeneous() const {
+		return this->X_;
+	}
+
+	homogeneous_bsurface& homogeneous() {
+		return this->X_;
+	}
+
+	/**
+	 * @brief Returns the control point at @a i in major order and @a j in
+	 * minor order.
+	 */
+	Vector control(std::size_t i, std::size_t j) const {
+		const homogeneous_type& h = this->X_.controls()(i, j);
+		return impl::project_homogeneous<Vector>(h,
+				value_type(GK_FLOAT_ONE) / h[Dimension]);
+	}
+
+	value_type weight(std::size_t i, std::size_t j) const {
+		return this->X_.controls()(i, j)[Dimension];
+	}
+
+	/**
+	 * @brief Computes the partial derivatives
+	 * @f$\mathbf{S}_{s^k t^l}@f$ for all @f$k + l \le d@f$ at
+	 * @f$(s, t)@f$.
+	 *
+	 * @param s Parameter in major order.
+	 * @param t Parameter in minor order.
+	 * @param d The maximum total derivative order.
+	 * @param out The beginning of @f$(d + 1)^2@f$ vectors, the derivative
+	 * @f$\mathbf{S}_{s^k t^l}@f$ at <tt>out[k * (d + 1) + l]</tt>. The
+	 * elements of @f$k + l > d@f$ are not written.
+	 * @return The end of the output.
+	 *
+	 * @see bsurface::derivatives()
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& s, const Parameter& t,
+			std::size_t d, RandomAccessIterator out) const {
+		bspl::basis_table<Parameter> M;
+		bspl::basis_table<Parameter> N;
+		return this->derivatives(s, t, d, out, M, N);
+	}
+
+	/**
+	 * @brief Computes the partial derivatives with tables given by a caller.
+	 * @see derivatives(const Parameter&, const Parameter&, std::size_t, RandomAccessIterator) const
+	 */
+	template<typename RandomAccessIterator>
+	RandomAccessIterator derivatives(const Parameter& s, const Parameter& t,
+			std::size_t d, RandomAccessIterator out,
+			bspl::basis_table<Parameter>& M,
+			bspl::basis_table<Parameter>& N) const {
+		const std::size_t Size = 9; // The derivatives up to the second order.
+		const std::size_t e = d + 1;
+
+		homogeneous_type buffer[Size];
+		std::vector<homogeneous_type> work;
+		homogeneous_type* A = buffer;
+		if (e * e > Size) {
+			work.resize(e * e);
+			A = &work[0];
+		}
+		this->X_.derivatives(s, t, d, A, M, N);
+
+		const value_type inverse = value_type(GK_FLOAT_ONE) / A[0][Dimension];
+		for (std::size_t k = 0; k <= d; ++k) {
+			for (std::size_t l = 0; k + l <= d; ++l) {
+				// S(k, l) = (A(k, l) - sum of the weight derivatives times
+				// the lower derivatives) / w.
+				Vector v = impl::project_homogeneous<Vector>(A[k * e + l],
+						inverse);
+				for (std::size_t j = 1; j <= l; ++j) {
+					v = v
+							- (bspl::binomial<value_type>(l, j)
+									* A[j][Dimension] * inverse)
+									* Vector(out[k * e + l - j]);
+				}
+				for (std::size_t i = 1; i <= k; ++i) {
+					const value_type b = bspl::binomial<value_type>(k, i)
+							* inverse;
+					v = v - (b * A[i * e][Dimension]) * Vector(out[(k - i) * e + l]);
+					for (std::size_t j = 1; j <= l; ++j) {
+						v = v
+								- (b * bspl::binomial<value_type>(l, j)
+										* A[i * e + j][Dimension])
+										* Vector(out[(k - i) * e + l - j]);
+					}
+				}
+				out[k * e + l] = v;
+			}
+		}
+
+		return out + e * e;
+	}
+
+	/**
+	 * @brief Computes the unit normal vector at @f$(s, t)@f$.
+	 */
+	direction<vector_traits<Vector>::Dimension> normal(const Parameter& s,
+			const Parameter& t) const {
+		const std::size_t d = 1;
+		Vector D[(d + 1) * (d + 1)];
+		this->derivatives(s, t, d, D);
+		return normal_direction(D[1 * (d + 1) + 0], D[0 * (d + 1) + 1]);
+	}
+
+	/**
+	 * @brief Computes the position at @f$(s, t)@f$.
+	 */
+	Vector operator()(const Parameter& s, const Parameter& t) const {
+		Vector r;
+		this->derivatives(s, t, 0, &r);
+		return r;
+	}
+
+	nurbs_surface& operator=(const nurbs_surface& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		return *this;
+	}
+
+private:
+	homogeneous_bsurface X_; ///< The B-spline surface of the homogeneous control points.
+};
+
+/**
+ * @brief Converts a NURBS surface of equal weights into a B-spline surface.
+ *
+ * @param x
+ * @param result The B-spline surface of the same shape.
+ * @return false leaving @a result unchanged if the weights are not equal.
+ */
+template<typename Vector, typename Parameter, typename Allocator>
+bool to_bsurface(const nurbs_surface<Vector, Parameter, Allocator>& x,
+		bsurface<Vector, Parameter, Allocator>& result) {
+	const typename nurbs_surface<Vector, Parameter, Allocator>::network_type& P =
+			x.homogeneous().controls();
+	const std::size_t m = P.major_size();
+	const std::size_t n = P.minor_size();
+
+	for (std::size_t j = 0; j < n; ++j) {
+		for (std::size_t i = 0; i < m; ++i) {
+			if (x.weight(i, j) != x.weight(0, 0)) {
+				return false;
+			}
+		}
+	}
+
+	network<Vector, Allocator> Q(m, n);
+	for (std::size_t j = 0; j < n; ++j) {
+		for (std::size_t i = 0; i < m; ++i) {
+			Q(i, j) = x.control(i, j);
+		}
+	}
+	result = bsurface<Vector, Parameter, Allocator>(
+			x.major_knot_vector().begin(), x.major_knot_vector().end(),
+			x.minor_knot_vector().begin(), x.minor_knot_vector().end(), Q);
+	return true;
+}
+
+}  // namespace gk
+
+#endif /* BSPLINE_NURBS_H_ */
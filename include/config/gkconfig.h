@@ -26,11 +26,56 @@
 
 /*
  * Floating Type
+ *
+ * GK_SIZEOF_FLOAT selects float_type, 4 for float or 8 for double. It is
+ * the default scalar of direction, basic_quaternion (quaternion), basis
+ * and the transforms, each of which takes its scalar as a template
+ * parameter, so that float and double instances are mixed in a build.
+ *
+ * The batched kernels compute in the scalar of their operands; the ray
+ * traversal and the box tests in that of the vectors, rotate() in that of
+ * the quaternion and the transforms in their own. The following paths
+ * promote float to double by refinement_traits or by their parameter type:
+ * - The Newton iteration of the point inversion of a B-spline surface
+ *   solves its system in double precision.
+ * - The parameters of B-spline curves and surfaces are of their Parameter
+ *   type apart from the control points; with double parameters over float
+ *   control points, the root refinement in nearest, ray and section keeps
+ *   the knots and the steps in double precision, and the basis values are
+ *   rounded to float where they weight the control points.
  */
 #ifndef GK_SIZEOF_FLOAT
 #	define GK_SIZEOF_FLOAT 8
 #endif
 
+/*
+ * Parallelization
+ *
+ * Batched algorithms run their loops with OpenMP when the compiler enables
+ * it. Define GK_NO_OPENMP to keep them serial.
+ */
+#if defined(_OPENMP) && !defined(GK_NO_OPENMP) && !defined(GK_OPENMP)
+#	define GK_OPENMP
+#endif
+
+/*
+ * Vector
+ *
+ * Define GK_VECTOR_BUILTIN to make vector_type<T, Dimension>::type the
+ * built-in gk::vec instead of the Eigen row vector, so that the kernel
+ * compiles without Eigen. gk::vec runs on SSE2 or AVX registers when the
+ * compiler targets them; define GK_NO_SIMD to keep it scalar.
+ */
+#if !defined(GK_NO_SIMD)
+#	if defined(__AVX__) && !defined(GK_AVX)
+#		define GK_AVX
+#	endif
+#	if (defined(__SSE2__) || defined(_M_X64) \
+			|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(GK_SSE2)
+#		define GK_SSE2
+#	endif
+#endif
+
 #ifndef GK_FUNCTION_NAME
 #	if defined(__PRETTY_FUNCTION__)
 #		define __PRETTY_FUNCTION__ GK_FUNCTION_NAME
@@ -117,6 +117,23 @@ struct vector_traits<Eigen::Matrix<Scalar, 1, DimensionSize, Options> > {
 	}
 };
 
+/**
+ * @brief The homogeneous vectors of Eigen are not aligned, so that the
+ * standard containers hold them without an aligned allocator.
+ * @date 2026/10/19
+ */
+template<typename Scalar, int DimensionSize, int Options>
+struct homogeneous_vector<Eigen::Matrix<Scalar, DimensionSize, 1, Options> > {
+	typedef Eigen::Matrix<Scalar, DimensionSize + 1, 1,
+			Options | Eigen::DontAlign> type;
+};
+
+template<typename Scalar, int DimensionSize, int Options>
+struct homogeneous_vector<Eigen::Matrix<Scalar, 1, DimensionSize, Options> > {
+	typedef Eigen::Matrix<Scalar, 1, DimensionSize + 1,
+			Options | Eigen::DontAlign> type;
+};
+
 /*
  * Traits and functions about a column vector in Eigen.
  */
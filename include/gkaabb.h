@@ -127,8 +127,8 @@ private:
 		set_(u, v, dimension_tag<GK::GK_2D>());
 
 		(u[GK::Z] < v[GK::Z]) ?
-				this->min_[GK::Z] = u[GK::Z], this->max_[GK::Z] = v[GK::Z] :
-				this->min_[GK::Z] = v[GK::Z], this->max_[GK::Z] = u[GK::Z];
+				(this->min_[GK::Z] = u[GK::Z], this->max_[GK::Z] = v[GK::Z]) :
+				(this->min_[GK::Z] = v[GK::Z], this->max_[GK::Z] = u[GK::Z]);
 	}
 };
 
@@ -140,8 +140,83 @@ bool is_include(const aabb<Vector>& box, const Vector& v) {
 template<typename Vector>
 aabb<Vector> operator&(const aabb<Vector>& a, const aabb<Vector>& b);
 
+/**
+ * @brief Computes the smallest box enclosing both @a a and @a b.
+ * @param a
+ * @param b
+ * @return
+ */
+template<typename Vector>
+aabb<Vector> operator|(const aabb<Vector>& a, const aabb<Vector>& b) {
+	Vector u = a.min();
+	Vector v = a.max();
+	for (std::size_t i = 0; i < vector_traits<Vector>::Dimension; ++i) {
+		u[i] = std::min(u[i], b.min()[i]);
+		v[i] = std::max(v[i], b.max()[i]);
+	}
+
+	return aabb<Vector>(u, v);
+}
+
+/**
+ * @brief Computes the square of the distance from a position @a v to
+ * a box. The distance is zero when @a v is in the box.
+ * @param box
+ * @param v
+ * @return
+ */
+template<typename Vector>
+typename vector_traits<Vector>::value_type square_distance(
+		const aabb<Vector>& box, const Vector& v) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	value_type d2 = Zero;
+	for (std::size_t i = 0; i < vector_traits<Vector>::Dimension; ++i) {
+		const value_type d = std::max(
+				std::max(box.min()[i] - v[i], v[i] - box.max()[i]), Zero);
+		d2 += d * d;
+	}
+
+	return d2;
+}
+
+/**
+ * @brief Clips the parameter interval of a ray
+ * @f$\mathbf{o} + r\mathbf{d}@f$ by a box (slab method).
+ *
+ * @param box
+ * @param origin The origin @f$\mathbf{o}@f$ of the ray.
+ * @param inverse The reciprocals of the components of the direction
+ * @f$\mathbf{d}@f$. A zero component gives an infinity.
+ * @param r_min The lower bound of the interval, replaced with the entry.
+ * @param r_max The upper bound of the interval, replaced with the exit.
+ * @return true if the clipped interval is not empty.
+ */
 template<typename Vector>
-aabb<Vector> operator|(const aabb<Vector>& a, const aabb<Vector>& b);
+bool clip_ray(const aabb<Vector>& box, const Vector& origin,
+		const Vector& inverse, typename vector_traits<Vector>::value_type& r_min,
+		typename vector_traits<Vector>::value_type& r_max) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	for (std::size_t i = 0; i < vector_traits<Vector>::Dimension; ++i) {
+		value_type r0 = (box.min()[i] - origin[i]) * inverse[i];
+		value_type r1 = (box.max()[i] - origin[i]) * inverse[i];
+		if (r1 < r0) {
+			std::swap(r0, r1);
+		}
+
+		// NaN, from an origin on a face parallel to the ray, clips nothing.
+		if (r0 > r_min) {
+			r_min = r0;
+		}
+		if (r1 < r_max) {
+			r_max = r1;
+		}
+	}
+
+	return !(r_min > r_max);
+}
 
 namespace impl {
 
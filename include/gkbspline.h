@@ -9,6 +9,14 @@
 #define GKBSPLINE_H_
 
 #include "bspline/bspline.h"
+#include "bspline/bsurface.h"
+#include "bspline/bsurface_algorithm.h"
+#include "bspline/bsurface_section.h"
 #include "bspline/algorithm.h"
+#include "bspline/fitting.h"
+#include "bspline/interpolation.h"
+#include "bspline/nurbs.h"
+#include "bspline/degree.h"
+#include "bspline/knot_removal.h"
 
 #endif /* GKBSPLINE_H_ */
@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include <stdint.h>
 #include <limits>
+#include <memory>
 
 #include "config/gkconfig.h"
 
@@ -117,6 +118,35 @@ struct float_traits<16> {
 	typedef long double value_type;
 };
 
+/**
+ * @brief Traits of the type in which a root over a @a Scalar is refined by
+ * Newton iteration. Single precision is promoted to double precision, so
+ * that the iteration converges below a tolerance near the resolution of
+ * single precision.
+ */
+template<typename Scalar>
+struct refinement_traits {
+	typedef Scalar value_type;
+};
+
+template<>
+struct refinement_traits<float> {
+	typedef double value_type;
+};
+
+/**
+ * @brief Rebinds an allocator to objects of @a T. Allocator::rebind was
+ * removed in C++20, so std::allocator_traits is used where it exists.
+ */
+template<typename Allocator, typename T>
+struct rebind_allocator {
+#if __cplusplus >= 201103L
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> type;
+#else
+	typedef typename Allocator::template rebind<T>::other type;
+#endif
+};
+
 /**
  * @brief Struct of constant objects.
  */
@@ -9,7 +9,9 @@
 #define GKGEOMETRY_H_
 
 #include "gkdef.h"
+#ifndef GK_VECTOR_BUILTIN
 #include <Eigen/Core>
+#endif
 
 /**
  * @defgroup geometry_tags Geometry Tags
@@ -86,7 +88,7 @@ struct plane_tag: public surface_tag, public direction_tag {
 struct sphere_tag: public surface_tag {
 };
 
-template<typename Category, typename T, std::size_t Dimension>
+template<typename Category, typename T, std::size_t Dimension = 0>
 struct geometry;
 
 #define GK_GEOMETRY_BASE_TEMPLATE_CLASS(Category) \
@@ -9,6 +9,8 @@
 #define GKINTERSECT_H_
 
 #include "gkgeometry.h"
+#include "primitive/line.h"
+#include "algorithm/ray_triangle.h"
 #include "algorithm/kernel.h"
 
 namespace gk {
@@ -128,6 +130,40 @@ OutputIterator intersect(const Geometry1& a, const Geometry2& b,
 			typename geometry_traits<Geometry2>::geometry_category());
 }
 
+/**
+ * @brief Computes an intersection of 2 segments by their cached
+ * directions.
+ */
+template<typename T, std::size_t Dimension, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect(const segment<T, Dimension>& a,
+		const segment<T, Dimension>& b, const Tolerance& epsilon,
+		OutputIterator result) {
+	return alg::intersect_2segments(a.start(), a.end(), a.dir(), b.start(),
+			b.end(), b.dir(), epsilon, result);
+}
+
+/**
+ * @brief Computes an intersection of a line and a segment by the cached
+ * direction and length of the segment.
+ */
+template<typename T, std::size_t Dimension, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect(const line<T, Dimension>& a,
+		const segment<T, Dimension>& b, const Tolerance& epsilon,
+		OutputIterator result) {
+	return alg::intersect_line_segment(a.reference(), a.dir(), b.start(),
+			b.dir(), b.length(), epsilon, result);
+}
+
+template<typename T, std::size_t Dimension, typename Tolerance,
+		typename OutputIterator>
+OutputIterator intersect(const segment<T, Dimension>& a,
+		const line<T, Dimension>& b, const Tolerance& epsilon,
+		OutputIterator result) {
+	return intersect(b, a, epsilon, result);
+}
+
 }  // namespace gk
 
 #endif /* GKINTERSECT_H_ */
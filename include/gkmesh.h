@@ -0,0 +1,16 @@
+/*
+ * gkmesh.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef INCLUDE_GKMESH_H_
+#define INCLUDE_GKMESH_H_
+
+#include "mesh/trimesh.h"
+#include "mesh/self_intersections.h"
+#include "mesh/mesh_nearest.h"
+#include "mesh/sdf.h"
+
+#endif /* INCLUDE_GKMESH_H_ */
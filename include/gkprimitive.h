@@ -12,5 +12,6 @@
 #include "primitive/plane.h"
 #include "primitive/triangle.h"
 #include "primitive/hyperplane.h"
+#include "algorithm/simplify.h"
 
 #endif /* INCLUDE_GKPRIMITIVE_H_ */
@@ -11,6 +11,7 @@
 #include "gkdef.h"
 
 #include <cmath>
+#include <iterator>
 #include <algorithm>
 
 namespace gk {
@@ -21,12 +22,15 @@ namespace gk {
  * \mathbf{\tilde{Q}} = w + x\mathbf{I} + y\mathbf{J} + z\mathbf{K}
  * @f]
  *
+ * @tparam T Type of the components.
+ *
  * @author Takuya Makimoto
  * @date 2016/01/25
  */
-class quaternion {
+template<typename T>
+class basic_quaternion {
 public:
-	typedef float_type value_type;
+	typedef T value_type;
 
 	/**
 	 * @brief The enum of component numbers.
@@ -36,14 +40,14 @@ public:
 		Y, ///< Imaginary @f$y@f$-component number.
 		Z, ///< Imaginary @f$z@f$-component number.
 		W, ///< Real component number.
-		Size, ///< The number of quaternion component.
+		Size, ///< The number of basic_quaternion component.
 	};
 
 public:
 	/**
 	 * @brief The default constructor.
 	 */
-	quaternion() :
+	basic_quaternion() :
 			x_() {
 		this->x_[X] = value_type(GK_FLOAT_ZERO);
 		this->x_[Y] = value_type(GK_FLOAT_ZERO);
@@ -51,7 +55,7 @@ public:
 		this->x_[W] = value_type(GK_FLOAT_ONE);
 	}
 
-	quaternion(const quaternion& other) :
+	basic_quaternion(const basic_quaternion& other) :
 			x_() {
 		this->x_[X] = other.x_[X];
 		this->x_[Y] = other.x_[Y];
@@ -60,7 +64,7 @@ public:
 	}
 
 	template<typename Vector>
-	quaternion(const Vector& v, value_type w) :
+	basic_quaternion(const Vector& v, value_type w) :
 			x_() {
 		this->x_[X] = v[X];
 		this->x_[Y] = v[Y];
@@ -68,7 +72,7 @@ public:
 		this->x_[W] = w;
 	}
 
-	quaternion(value_type x, value_type y, value_type z, value_type w) :
+	basic_quaternion(value_type x, value_type y, value_type z, value_type w) :
 			x_() {
 		this->x_[X] = x;
 		this->x_[Y] = y;
@@ -76,7 +80,7 @@ public:
 		this->x_[W] = w;
 	}
 
-	~quaternion() {
+	~basic_quaternion() {
 	}
 
 	const value_type& x() const {
@@ -145,7 +149,7 @@ public:
 		return this->x_[n];
 	}
 
-	quaternion& operator=(const quaternion& rhs) {
+	basic_quaternion& operator=(const basic_quaternion& rhs) {
 		if (&rhs == this) {
 			return *this;
 		}
@@ -158,7 +162,7 @@ public:
 		return *this;
 	}
 
-	quaternion& operator+=(const quaternion& rhs) {
+	basic_quaternion& operator+=(const basic_quaternion& rhs) {
 		this->x_[X] += rhs.x_[X];
 		this->x_[Y] += rhs.x_[Y];
 		this->x_[Z] += rhs.x_[Z];
@@ -167,7 +171,7 @@ public:
 		return *this;
 	}
 
-	quaternion& operator-=(const quaternion& rhs) {
+	basic_quaternion& operator-=(const basic_quaternion& rhs) {
 		this->x_[X] -= rhs.x_[X];
 		this->x_[Y] -= rhs.x_[Y];
 		this->x_[Z] -= rhs.x_[Z];
@@ -176,7 +180,7 @@ public:
 		return *this;
 	}
 
-	quaternion& operator*=(const quaternion& rhs) {
+	basic_quaternion& operator*=(const basic_quaternion& rhs) {
 		value_type f[] = { this->x_[X], this->x_[Y], this->x_[Z], this->x_[W] };
 		this->x_[W] = -f[X] * rhs.x_[X] - f[Y] * rhs.x_[Y] - f[Z] * rhs.x_[Z]
 				+ f[W] * rhs.x_[W];
@@ -200,7 +204,7 @@ public:
 		return *this;
 	}
 
-	quaternion& operator*=(value_type rhs) {
+	basic_quaternion& operator*=(value_type rhs) {
 		this->x_[X] *= rhs;
 		this->x_[Y] *= rhs;
 		this->x_[Z] *= rhs;
@@ -208,62 +212,407 @@ public:
 		return *this;
 	}
 
-	quaternion& operator/=(value_type rhs) {
+	basic_quaternion& operator/=(value_type rhs) {
 		const value_type inv_rhs = value_type(GK_FLOAT_ONE) / rhs;
 		return this->operator *=(inv_rhs);
 	}
 
 private:
 	value_type x_[Size];
-}
-;
+};
+
+/**
+ * @brief Quaternion of the default precision.
+ */
+typedef basic_quaternion<float_type> quaternion;
 
-quaternion conj(const quaternion& q) {
-	quaternion dst = q;
+template<typename T>
+basic_quaternion<T> conj(const basic_quaternion<T>& q) {
+	basic_quaternion<T> dst = q;
 	dst.conjugate();
 	return dst;
 }
 
-quaternion operator-(const quaternion& q) {
-	quaternion dst = q;
+template<typename T>
+basic_quaternion<T> operator-(const basic_quaternion<T>& q) {
+	basic_quaternion<T> dst = q;
 	dst.negative();
 	return dst;
 }
 
-quaternion operator+(const quaternion& lhs, const quaternion& rhs) {
-	quaternion dst(lhs);
+template<typename T>
+basic_quaternion<T> operator+(const basic_quaternion<T>& lhs,
+		const basic_quaternion<T>& rhs) {
+	basic_quaternion<T> dst(lhs);
 	dst += rhs;
 	return dst;
 }
 
-quaternion operator-(const quaternion& lhs, const quaternion& rhs) {
-	quaternion dst = lhs;
+template<typename T>
+basic_quaternion<T> operator-(const basic_quaternion<T>& lhs,
+		const basic_quaternion<T>& rhs) {
+	basic_quaternion<T> dst = lhs;
 	dst -= rhs;
 	return dst;
 }
 
-quaternion operator*(const quaternion& lhs, float_type rhs) {
-	quaternion dst = lhs;
+template<typename T>
+basic_quaternion<T> operator*(const basic_quaternion<T>& lhs,
+		typename basic_quaternion<T>::value_type rhs) {
+	basic_quaternion<T> dst = lhs;
 	dst *= rhs;
 	return dst;
 }
 
-quaternion operator*(float_type lhs, const quaternion& rhs) {
+template<typename T>
+basic_quaternion<T> operator*(typename basic_quaternion<T>::value_type lhs,
+		const basic_quaternion<T>& rhs) {
 	return rhs * lhs;
 }
 
-quaternion operator*(const quaternion& lhs, const quaternion& rhs) {
-	quaternion dst = lhs;
+template<typename T>
+basic_quaternion<T> operator*(const basic_quaternion<T>& lhs,
+		const basic_quaternion<T>& rhs) {
+	basic_quaternion<T> dst = lhs;
 	dst *= rhs;
 	return dst;
 }
 
-quaternion operator/(const quaternion& lhs, float_type rhs) {
-	quaternion dst = lhs;
+template<typename T>
+basic_quaternion<T> operator/(const basic_quaternion<T>& lhs,
+		typename basic_quaternion<T>::value_type rhs) {
+	basic_quaternion<T> dst = lhs;
 	dst /= rhs;
 	return dst;
 }
 
+template<typename T>
+T dot(const basic_quaternion<T>& lhs, const basic_quaternion<T>& rhs) {
+	typedef basic_quaternion<T> quaternion_type;
+	return lhs[quaternion_type::X] * rhs[quaternion_type::X]
+			+ lhs[quaternion_type::Y] * rhs[quaternion_type::Y]
+			+ lhs[quaternion_type::Z] * rhs[quaternion_type::Z]
+			+ lhs[quaternion_type::W] * rhs[quaternion_type::W];
+}
+
+/**
+ * @brief Computes the logarithm of a unit quaternion, whose real part is
+ * zero.
+ */
+template<typename T>
+basic_quaternion<T> log(const basic_quaternion<T>& q) {
+	typedef basic_quaternion<T> quaternion_type;
+	typedef T value_type;
+	const value_type s = std::sqrt(
+			q[quaternion_type::X] * q[quaternion_type::X]
+					+ q[quaternion_type::Y] * q[quaternion_type::Y]
+					+ q[quaternion_type::Z] * q[quaternion_type::Z]);
+	const value_type theta = std::atan2(s, q[quaternion_type::W]);
+	const value_type f =
+			(s > value_type(GK_FLOAT_ZERO)) ? theta / s : value_type(GK_FLOAT_ONE);
+	return quaternion_type(f * q[quaternion_type::X],
+			f * q[quaternion_type::Y], f * q[quaternion_type::Z],
+			value_type(GK_FLOAT_ZERO));
+}
+
+/**
+ * @brief Computes the exponential of a quaternion whose real part is zero,
+ * which is a unit quaternion.
+ */
+template<typename T>
+basic_quaternion<T> exp(const basic_quaternion<T>& q) {
+	typedef basic_quaternion<T> quaternion_type;
+	typedef T value_type;
+	const value_type theta = std::sqrt(
+			q[quaternion_type::X] * q[quaternion_type::X]
+					+ q[quaternion_type::Y] * q[quaternion_type::Y]
+					+ q[quaternion_type::Z] * q[quaternion_type::Z]);
+	const value_type f =
+			(theta > value_type(GK_FLOAT_ZERO)) ?
+					std::sin(theta) / theta : value_type(GK_FLOAT_ONE);
+	return quaternion_type(f * q[quaternion_type::X],
+			f * q[quaternion_type::Y], f * q[quaternion_type::Z],
+			std::cos(theta));
+}
+
+namespace impl {
+
+/**
+ * @brief Kernel interpolating unit quaternions on the shorter arc.
+ *
+ * The weights of slerp are computed from the angle between the
+ * quaternions, except for the quaternions closer than NearCosine where they
+ * are the weights of the linear interpolation; the result is normalized in
+ * both cases, so that the two paths join continuously.
+ *
+ * @tparam T Type of the components of the quaternions.
+ *
+ * @date 2026/10/18
+ */
+template<typename T>
+struct slerp_kernel {
+	static const std::size_t BlockSize = 256; ///< The number of quaternions in a block.
+	static const std::ptrdiff_t ParallelSize = 1 << 13; ///< The minimum number of quaternions to interpolate in parallel.
+
+	typedef basic_quaternion<T> quaternion_type;
+	typedef T value_type;
+
+	/**
+	 * @brief Returns the cosine over which slerp interpolates linearly.
+	 */
+	static value_type NearCosine() {
+		return value_type(0.9995);
+	}
+
+	/**
+	 * @brief Computes the weights of slerp for the cosine @a c of the angle
+	 * and a parameter @a t. A negative @a c gives the weights along the
+	 * longer arc, which is undefined for the opposite quaternions.
+	 */
+	static void weights(value_type c, value_type t, value_type& a,
+			value_type& b) {
+		if (c > NearCosine()) {
+			a = value_type(GK_FLOAT_ONE) - t;
+			b = t;
+			return;
+		}
+
+		const value_type theta = std::acos(c);
+		const value_type f = value_type(GK_FLOAT_ONE) / std::sin(theta);
+		a = std::sin((value_type(GK_FLOAT_ONE) - t) * theta) * f;
+		b = std::sin(t * theta) * f;
+	}
+
+	/**
+	 * @brief Interpolates @a n pairs of quaternions, at most BlockSize,
+	 * from @a first1 and @a first2 to @a result at a parameter @a t.
+	 *
+	 * The components are gathered into separate arrays, so that the dots
+	 * and the blends run over contiguous arrays which the compiler
+	 * vectorizes; only the weights of the distant pairs are computed one
+	 * by one.
+	 */
+	template<typename InputRandomAccessIterator1,
+			typename InputRandomAccessIterator2,
+			typename OutputRandomAccessIterator>
+	void operator()(InputRandomAccessIterator1 first1,
+			InputRandomAccessIterator2 first2, std::size_t n, value_type t,
+			OutputRandomAccessIterator result) const {
+		static const std::size_t X = quaternion_type::X;
+		static const std::size_t Y = quaternion_type::Y;
+		static const std::size_t Z = quaternion_type::Z;
+		static const std::size_t W = quaternion_type::W;
+		static const std::size_t Size = quaternion_type::Size;
+
+		value_type P[Size][BlockSize];
+		value_type Q[Size][BlockSize];
+		value_type a[BlockSize];
+		value_type b[BlockSize];
+
+		for (std::size_t i = 0; i < n; ++i) {
+			const quaternion_type& p = first1[i];
+			const quaternion_type& q = first2[i];
+			for (std::size_t k = 0; k < Size; ++k) {
+				P[k][i] = p[k];
+				Q[k][i] = q[k];
+			}
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			a[i] = P[X][i] * Q[X][i] + P[Y][i] * Q[Y][i] + P[Z][i] * Q[Z][i]
+					+ P[W][i] * Q[W][i];
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			const value_type c = std::abs(a[i]);
+			const value_type sign =
+					(a[i] < value_type(GK_FLOAT_ZERO)) ?
+							value_type(GK_FLOAT_NEGATIVE_ONE) :
+							value_type(GK_FLOAT_ONE);
+			weights(c, t, a[i], b[i]);
+			b[i] *= sign;
+		}
+
+		for (std::size_t k = 0; k < Size; ++k) {
+			for (std::size_t i = 0; i < n; ++i) {
+				P[k][i] = a[i] * P[k][i] + b[i] * Q[k][i];
+			}
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			a[i] = value_type(GK_FLOAT_ONE)
+					/ std::sqrt(
+							P[X][i] * P[X][i] + P[Y][i] * P[Y][i]
+									+ P[Z][i] * P[Z][i] + P[W][i] * P[W][i]);
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			result[i] = quaternion_type(a[i] * P[X][i], a[i] * P[Y][i],
+					a[i] * P[Z][i], a[i] * P[W][i]);
+		}
+	}
+};
+
+/**
+ * @brief Interpolates unit quaternions spherically on the arc from @a q to
+ * @a r, which is the longer one if their dot is negative.
+ */
+template<typename T>
+basic_quaternion<T> slerp_arc(const basic_quaternion<T>& q,
+		const basic_quaternion<T>& r, T t) {
+	T a;
+	T b;
+	slerp_kernel<T>::weights(dot(q, r), t, a, b);
+
+	basic_quaternion<T> x = a * q + b * r;
+	x /= x.norm();
+	return x;
+}
+
+} // namespace impl
+
+/**
+ * @brief Interpolates unit quaternions linearly and normalizes the result,
+ * on the shorter arc.
+ *
+ * The rotation is not at a constant angular velocity, but is close to slerp
+ * for the near quaternions.
+ *
+ * @param q The quaternion at @f$t = 0@f$.
+ * @param r The quaternion at @f$t = 1@f$.
+ * @param t
+ */
+template<typename T>
+basic_quaternion<T> nlerp(const basic_quaternion<T>& q,
+		const basic_quaternion<T>& r,
+		typename basic_quaternion<T>::value_type t) {
+	typedef T value_type;
+	const value_type a = value_type(GK_FLOAT_ONE) - t;
+	const value_type b = (dot(q, r) < value_type(GK_FLOAT_ZERO)) ? -t : t;
+
+	basic_quaternion<T> x = a * q + b * r;
+	x /= x.norm();
+	return x;
+}
+
+/**
+ * @brief Interpolates unit quaternions spherically, on the shorter arc.
+ *
+ * The near quaternions are interpolated by nlerp() without computing
+ * trigonometric functions.
+ *
+ * @param q The quaternion at @f$t = 0@f$.
+ * @param r The quaternion at @f$t = 1@f$.
+ * @param t
+ */
+template<typename T>
+basic_quaternion<T> slerp(const basic_quaternion<T>& q,
+		const basic_quaternion<T>& r,
+		typename basic_quaternion<T>::value_type t) {
+	typedef T value_type;
+	const value_type c = dot(q, r);
+
+	value_type a;
+	value_type b;
+	impl::slerp_kernel<T>::weights(std::abs(c), t, a, b);
+	if (c < value_type(GK_FLOAT_ZERO)) {
+		b = -b;
+	}
+
+	basic_quaternion<T> x = a * q + b * r;
+	x /= x.norm();
+	return x;
+}
+
+/**
+ * @brief Computes the inner control quaternion of squad at @a q between
+ * @a prev and @a next.
+ * @f[
+ * \mathbf{s} = \mathbf{q}\exp\left(-\frac{\log(\mathbf{q}^{-1}\mathbf{p})
+ * + \log(\mathbf{q}^{-1}\mathbf{n})}{4}\right)
+ * @f]
+ */
+template<typename T>
+basic_quaternion<T> squad_control(const basic_quaternion<T>& prev,
+		const basic_quaternion<T>& q, const basic_quaternion<T>& next) {
+	typedef T value_type;
+	const basic_quaternion<T> p =
+			(dot(prev, q) < value_type(GK_FLOAT_ZERO)) ? -prev : prev;
+	const basic_quaternion<T> n =
+			(dot(next, q) < value_type(GK_FLOAT_ZERO)) ? -next : next;
+
+	const basic_quaternion<T> inv = conj(q);
+	const basic_quaternion<T> x = log(inv * p) + log(inv * n);
+	return q * exp(x * value_type(-0.25));
+}
+
+/**
+ * @brief Interpolates unit quaternions by the spherical cubic of squad,
+ * which has a continuous angular velocity over a sequence of quaternions.
+ * @param q The quaternion at @f$t = 0@f$.
+ * @param r The quaternion at @f$t = 1@f$.
+ * @param a The control of @a q by squad_control().
+ * @param b The control of @a r by squad_control().
+ * @param t
+ */
+template<typename T>
+basic_quaternion<T> squad(const basic_quaternion<T>& q,
+		const basic_quaternion<T>& r, const basic_quaternion<T>& a,
+		const basic_quaternion<T>& b,
+		typename basic_quaternion<T>::value_type t) {
+	typedef T value_type;
+	const value_type h = value_type(2) * t * (value_type(GK_FLOAT_ONE) - t);
+
+	// The key at 1 and its control are turned to the side of the key at 0
+	// together. The interpolations then do not take the shorter arc, so
+	// that the controls stay on the side of their keys.
+	const bool opposite = dot(q, r) < value_type(GK_FLOAT_ZERO);
+	const basic_quaternion<T> x = impl::slerp_arc(q, (opposite) ? -r : r, t);
+	const basic_quaternion<T> y = impl::slerp_arc(a, (opposite) ? -b : b, t);
+	return impl::slerp_arc(x, y, h);
+}
+
+/**
+ * @brief Interpolates pairs of unit quaternions spherically at
+ * a parameter @a t.
+ *
+ * The quaternions are processed in blocks, in parallel for a large range
+ * when OpenMP is enabled. The result may be @a first1 or @a first2.
+ *
+ * @param first1 The beginning of the quaternions at @f$t = 0@f$.
+ * @param last1 The end of the quaternions at @f$t = 0@f$.
+ * @param first2 The beginning of the quaternions at @f$t = 1@f$.
+ * @param t
+ * @param result The beginning of the interpolated quaternions.
+ * @return The end of the interpolated quaternions.
+ */
+template<typename InputRandomAccessIterator1,
+		typename InputRandomAccessIterator2, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator slerp(InputRandomAccessIterator1 first1,
+		InputRandomAccessIterator1 last1, InputRandomAccessIterator2 first2,
+		typename std::iterator_traits<InputRandomAccessIterator1>::value_type::value_type t,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator1>::value_type::value_type value_type;
+	typedef impl::slerp_kernel<value_type> kernel_type;
+
+	const kernel_type kernel = kernel_type();
+
+	const std::ptrdiff_t n = std::distance(first1, last1);
+	const std::ptrdiff_t block = kernel_type::BlockSize;
+	const std::ptrdiff_t blocks = (n + block - 1) / block;
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (n >= kernel_type::ParallelSize)
+#endif
+	for (std::ptrdiff_t i = 0; i < blocks; ++i) {
+		const std::ptrdiff_t k = i * block;
+		kernel(first1 + k, first2 + k, std::size_t(std::min(block, n - k)), t,
+				result + k);
+	}
+
+	return result + n;
+}
+
 } // namespace gk
 
 #endif /* GKQUATERNION_H_ */
@@ -0,0 +1,703 @@
+/*
+ * gktransform.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef GKTRANSFORM_H_
+#define GKTRANSFORM_H_
+
+#include "gkdef.h"
+#include "gkvector.h"
+#include "gkquaternion.h"
+#include "gkaabb.h"
+#include "primitive/line.h"
+#include "primitive/plane.h"
+#include "primitive/triangle.h"
+#include "bspline/bspline.h"
+#include "bspline/bsurface.h"
+
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Base of the transforms in a 3D space, @f$\mathbf{A}\mathbf{v} +
+ * \mathbf{t}@f$, which keeps the matrix so that applying a transform
+ * computes no trigonometric function.
+ *
+ * @tparam Vector Type of the translation.
+ * @tparam T Type of the components of the matrix, in which the transform
+ * is computed.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename T>
+class transform_base {
+public:
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef T scalar_type;
+	typedef direction<GK::GK_3D, T> direction_type;
+
+public:
+	/**
+	 * @brief Returns the component of the linear part at a @a row and
+	 * a @a column.
+	 */
+	T matrix(std::size_t row, std::size_t column) const {
+		return this->A_[row * GK::GK_3D + column];
+	}
+
+	/**
+	 * @brief Returns the translation.
+	 */
+	const vector_type& translation() const {
+		return this->t_;
+	}
+
+	/**
+	 * @brief Applies the linear part to a vector @a v, as a difference of
+	 * positions.
+	 */
+	template<typename V>
+	V linear(const V& v) const {
+		typedef typename vector_traits<V>::value_type unit_type;
+		const unit_type unit = unit_type(GK_FLOAT_ONE);
+
+		const T x[] = { v[GK::X] / unit, v[GK::Y] / unit, v[GK::Z] / unit };
+		T y[GK::GK_3D];
+		this->multiply_(this->A_, x, y);
+
+		V r;
+		r[GK::X] = y[GK::X] * unit;
+		r[GK::Y] = y[GK::Y] * unit;
+		r[GK::Z] = y[GK::Z] * unit;
+		return r;
+	}
+
+	/**
+	 * @brief Applies the linear part to a direction @a d, and normalizes it.
+	 */
+	direction_type linear(const direction_type& d) const {
+		return this->direction_(this->A_, d);
+	}
+
+	/**
+	 * @brief Applies the transform to a position @a v.
+	 */
+	template<typename V>
+	V operator()(const V& v) const {
+		typedef typename vector_traits<V>::value_type unit_type;
+		const unit_type unit = unit_type(GK_FLOAT_ONE);
+
+		const T x[] = { v[GK::X] / unit, v[GK::Y] / unit, v[GK::Z] / unit };
+		T y[GK::GK_3D];
+		this->multiply_(this->A_, x, y);
+
+		V r;
+		r[GK::X] = (y[GK::X] + this->t_[GK::X] / value_type(GK_FLOAT_ONE)) * unit;
+		r[GK::Y] = (y[GK::Y] + this->t_[GK::Y] / value_type(GK_FLOAT_ONE)) * unit;
+		r[GK::Z] = (y[GK::Z] + this->t_[GK::Z] / value_type(GK_FLOAT_ONE)) * unit;
+		return r;
+	}
+
+protected:
+	T A_[GK::GK_3D * GK::GK_3D]; ///< The linear part in row-major order.
+	vector_type t_; ///< The translation.
+
+protected:
+	transform_base() :
+			A_(), t_() {
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			this->A_[i * GK::GK_3D + i] = T(GK_FLOAT_ONE);
+		}
+	}
+
+	transform_base(const transform_base& other) :
+			A_(), t_(other.t_) {
+		std::copy(other.A_, other.A_ + GK::GK_3D * GK::GK_3D, this->A_);
+	}
+
+	explicit transform_base(const vector_type& t) :
+			A_(), t_(t) {
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			this->A_[i * GK::GK_3D + i] = T(GK_FLOAT_ONE);
+		}
+	}
+
+	~transform_base() {
+	}
+
+	transform_base& operator=(const transform_base& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		std::copy(rhs.A_, rhs.A_ + GK::GK_3D * GK::GK_3D, this->A_);
+		this->t_ = rhs.t_;
+		return *this;
+	}
+
+	static void multiply_(const T* A, const T* x, T* y) {
+		y[GK::X] = A[0] * x[GK::X] + A[1] * x[GK::Y] + A[2] * x[GK::Z];
+		y[GK::Y] = A[3] * x[GK::X] + A[4] * x[GK::Y] + A[5] * x[GK::Z];
+		y[GK::Z] = A[6] * x[GK::X] + A[7] * x[GK::Y] + A[8] * x[GK::Z];
+	}
+
+	static direction_type direction_(const T* A, const direction_type& d) {
+		const T x[] = { d[GK::X], d[GK::Y], d[GK::Z] };
+		T y[GK::GK_3D];
+		multiply_(A, x, y);
+		return direction_type(y);
+	}
+
+	/**
+	 * @brief Sets @f$\mathbf{A}_f \mathbf{A}_g@f$ and
+	 * @f$\mathbf{A}_f \mathbf{t}_g + \mathbf{t}_f@f$ to this, which is
+	 * neither @a f nor @a g.
+	 */
+	void compose_(const transform_base& f, const transform_base& g) {
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			for (std::size_t j = 0; j < GK::GK_3D; ++j) {
+				T a = T(GK_FLOAT_ZERO);
+				for (std::size_t k = 0; k < GK::GK_3D; ++k) {
+					a += f.A_[i * GK::GK_3D + k] * g.A_[k * GK::GK_3D + j];
+				}
+				this->A_[i * GK::GK_3D + j] = a;
+			}
+		}
+		this->t_ = f(g.t_);
+	}
+};
+
+} // namespace impl
+
+/**
+ * @brief Rigid transform in a 3D space, a rotation by a quaternion followed
+ * by a translation.
+ *
+ * @tparam Vector Type of the translation.
+ * @tparam T Type of the components of the matrix, in which the transform
+ * is computed.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename T = float_type>
+class rigid_transform: public impl::transform_base<Vector, T> {
+public:
+	typedef impl::transform_base<Vector, T> base_type;
+	typedef typename base_type::vector_type vector_type;
+	typedef typename base_type::direction_type direction_type;
+	typedef basic_quaternion<T> quaternion_type;
+
+public:
+	/**
+	 * @brief Constructs the identity.
+	 */
+	rigid_transform() :
+			base_type(), Q_() {
+	}
+
+	rigid_transform(const rigid_transform& other) :
+			base_type(other), Q_(other.Q_) {
+	}
+
+	/**
+	 * @brief Constructs the translation by @a t.
+	 */
+	explicit rigid_transform(const vector_type& t) :
+			base_type(t), Q_() {
+	}
+
+	/**
+	 * @brief Constructs the rotation by @a Q followed by the translation by
+	 * @a t.
+	 * @param Q The quaternion of the rotation, which is normalized.
+	 * @param t
+	 */
+	rigid_transform(const quaternion_type& Q, const vector_type& t) :
+			base_type(t), Q_(Q / Q.norm()) {
+		this->set_();
+	}
+
+	/**
+	 * @brief Constructs the rotation by an angle vector, whose direction is
+	 * the axis and whose norm is the angle, followed by the translation by
+	 * @a t.
+	 * @param angle
+	 * @param t
+	 */
+	rigid_transform(const typename gk::vector_type<T, GK::GK_3D>::type& angle,
+			const vector_type& t) :
+			base_type(t), Q_(impl::rotation_quaternion<T>(angle)) {
+		this->set_();
+	}
+
+	~rigid_transform() {
+	}
+
+	/**
+	 * @brief Returns the unit quaternion of the rotation.
+	 */
+	const quaternion_type& rotation() const {
+		return this->Q_;
+	}
+
+	/**
+	 * @brief Applies the transform to a normal direction @a n.
+	 */
+	direction_type normal(const direction_type& n) const {
+		return this->linear(n);
+	}
+
+	/**
+	 * @brief Computes the inverse transform.
+	 */
+	rigid_transform inverse() const {
+		rigid_transform r;
+		r.Q_ = conj(this->Q_);
+		r.set_();
+		r.t_ = -r.linear(this->t_);
+		return r;
+	}
+
+	rigid_transform& operator*=(const rigid_transform& rhs) {
+		const rigid_transform f(*this);
+		this->Q_ = f.Q_ * rhs.Q_;
+		this->compose_(f, rhs);
+		return *this;
+	}
+
+	rigid_transform& operator=(const rigid_transform& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		base_type::operator=(rhs);
+		this->Q_ = rhs.Q_;
+		return *this;
+	}
+
+private:
+	quaternion_type Q_; ///< The unit quaternion of the rotation.
+
+private:
+	void set_() {
+		const impl::rotation_kernel<T> R(this->Q_);
+		std::copy(R.R, R.R + GK::GK_3D * GK::GK_3D, this->A_);
+	}
+};
+
+/**
+ * @brief Affine transform in a 3D space, a linear map followed by
+ * a translation.
+ *
+ * @tparam Vector Type of the translation.
+ * @tparam T Type of the components of the matrix, in which the transform
+ * is computed.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector, typename T = float_type>
+class affine_transform: public impl::transform_base<Vector, T> {
+public:
+	typedef impl::transform_base<Vector, T> base_type;
+	typedef typename base_type::vector_type vector_type;
+	typedef typename base_type::direction_type direction_type;
+
+public:
+	/**
+	 * @brief Constructs the identity.
+	 */
+	affine_transform() :
+			base_type(), N_() {
+		this->set_();
+	}
+
+	affine_transform(const affine_transform& other) :
+			base_type(other), N_() {
+		std::copy(other.N_, other.N_ + GK::GK_3D * GK::GK_3D, this->N_);
+	}
+
+	/**
+	 * @brief Constructs the transform equal to a rigid transform @a f.
+	 */
+	affine_transform(const rigid_transform<Vector, T>& f) :
+			base_type(f), N_() {
+		std::copy(this->A_, this->A_ + GK::GK_3D * GK::GK_3D, this->N_);
+	}
+
+	/**
+	 * @brief Constructs the transform of the linear part in row-major order
+	 * from @a matrix_first, followed by the translation by @a t.
+	 * @param matrix_first The beginning of the 9 components of the matrix.
+	 * @param t
+	 */
+	template<typename InputIterator>
+	affine_transform(InputIterator matrix_first, const vector_type& t) :
+			base_type(t), N_() {
+		for (std::size_t i = 0; i < GK::GK_3D * GK::GK_3D;
+				++i, ++matrix_first) {
+			this->A_[i] = *matrix_first;
+		}
+		this->set_();
+	}
+
+	~affine_transform() {
+	}
+
+	/**
+	 * @brief Returns the determinant of the linear part.
+	 */
+	T determinant() const {
+		const T* const A = this->A_;
+		return A[0] * (A[4] * A[8] - A[5] * A[7])
+				- A[1] * (A[3] * A[8] - A[5] * A[6])
+				+ A[2] * (A[3] * A[7] - A[4] * A[6]);
+	}
+
+	/**
+	 * @brief Applies the transform to a normal direction @a n, by the
+	 * inverse transpose of the linear part.
+	 */
+	direction_type normal(const direction_type& n) const {
+		return this->direction_(this->N_, n);
+	}
+
+	/**
+	 * @brief Computes the inverse transform. The linear part must be
+	 * regular.
+	 */
+	affine_transform inverse() const {
+		affine_transform r;
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			for (std::size_t j = 0; j < GK::GK_3D; ++j) {
+				r.A_[i * GK::GK_3D + j] = this->N_[j * GK::GK_3D + i];
+			}
+		}
+		r.set_();
+		r.t_ = -r.linear(this->t_);
+		return r;
+	}
+
+	affine_transform& operator*=(const affine_transform& rhs) {
+		const affine_transform f(*this);
+		this->compose_(f, rhs);
+		this->set_();
+		return *this;
+	}
+
+	affine_transform& operator=(const affine_transform& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		base_type::operator=(rhs);
+		std::copy(rhs.N_, rhs.N_ + GK::GK_3D * GK::GK_3D, this->N_);
+		return *this;
+	}
+
+private:
+	T N_[GK::GK_3D * GK::GK_3D]; ///< The inverse transpose of the linear part.
+
+private:
+	/**
+	 * @brief Computes the inverse transpose of the linear part from the
+	 * cofactors.
+	 */
+	void set_() {
+		const T* const A = this->A_;
+		const T f = T(GK_FLOAT_ONE) / this->determinant();
+
+		this->N_[0] = f * (A[4] * A[8] - A[5] * A[7]);
+		this->N_[1] = f * (A[5] * A[6] - A[3] * A[8]);
+		this->N_[2] = f * (A[3] * A[7] - A[4] * A[6]);
+		this->N_[3] = f * (A[2] * A[7] - A[1] * A[8]);
+		this->N_[4] = f * (A[0] * A[8] - A[2] * A[6]);
+		this->N_[5] = f * (A[1] * A[6] - A[0] * A[7]);
+		this->N_[6] = f * (A[1] * A[5] - A[2] * A[4]);
+		this->N_[7] = f * (A[2] * A[3] - A[0] * A[5]);
+		this->N_[8] = f * (A[0] * A[4] - A[1] * A[3]);
+	}
+};
+
+/**
+ * @brief Composes two transforms; @a g is applied first.
+ */
+template<typename Vector, typename T>
+rigid_transform<Vector, T> operator*(const rigid_transform<Vector, T>& f,
+		const rigid_transform<Vector, T>& g) {
+	rigid_transform<Vector, T> r = f;
+	r *= g;
+	return r;
+}
+
+template<typename Vector, typename T>
+affine_transform<Vector, T> operator*(const affine_transform<Vector, T>& f,
+		const affine_transform<Vector, T>& g) {
+	affine_transform<Vector, T> r = f;
+	r *= g;
+	return r;
+}
+
+template<typename Vector, typename T>
+affine_transform<Vector, T> operator*(const affine_transform<Vector, T>& f,
+		const rigid_transform<Vector, T>& g) {
+	return f * affine_transform<Vector, T>(g);
+}
+
+template<typename Vector, typename T>
+affine_transform<Vector, T> operator*(const rigid_transform<Vector, T>& f,
+		const affine_transform<Vector, T>& g) {
+	return affine_transform<Vector, T>(f) * g;
+}
+
+/**
+ * @brief Transforms a position @a v.
+ * @param f A rigid or an affine transform.
+ * @param v
+ */
+template<typename Transform, typename Vector>
+Vector transform(const Transform& f, const Vector& v) {
+	return f(v);
+}
+
+/**
+ * @brief Transforms a direction @a d of a line.
+ */
+template<typename Transform, typename T>
+direction<GK::GK_3D, T> transform(const Transform& f,
+		const direction<GK::GK_3D, T>& d) {
+	return f.linear(d);
+}
+
+template<typename Transform, typename T>
+line<T, GK::GK_3D> transform(const Transform& f, const line<T, GK::GK_3D>& x) {
+	return line<T, GK::GK_3D>(f(x.reference()), transform(f, x.dir()));
+}
+
+template<typename Transform, typename T>
+segment<T, GK::GK_3D> transform(const Transform& f,
+		const segment<T, GK::GK_3D>& x) {
+	return segment<T, GK::GK_3D>(f(x.start()), f(x.end()));
+}
+
+template<typename Transform, typename Vector>
+polyline<Vector> transform(const Transform& f, const polyline<Vector>& x) {
+	std::vector<Vector> X;
+	X.reserve(x.size());
+	for (typename polyline<Vector>::const_iterator p = x.begin(); p != x.end();
+			++p) {
+		X.push_back(f(*p));
+	}
+	return polyline<Vector>(X.begin(), X.end());
+}
+
+/**
+ * @brief Transforms a plane, whose normal is transformed by
+ * Transform::normal().
+ */
+template<typename Transform, typename Vector>
+plane<Vector> transform(const Transform& f, const plane<Vector>& x) {
+	return plane<Vector>(f(x.reference()), f.normal(x.normal()));
+}
+
+template<typename Transform, typename Vector>
+triangle<Vector> transform(const Transform& f, const triangle<Vector>& x) {
+	triangle<Vector> r;
+	for (std::size_t i = 0; i < triangle<Vector>::ElementSize; ++i) {
+		r[i] = f(x[i]);
+	}
+	return r;
+}
+
+/**
+ * @brief Computes the box enclosing a transformed box, by the method of
+ * Arvo, which bounds each product of the matrix and the box separately.
+ */
+template<typename Transform, typename Vector>
+aabb<Vector> transform(const Transform& f, const aabb<Vector>& x) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename Transform::scalar_type scalar_type;
+	const value_type unit = value_type(GK_FLOAT_ONE);
+
+	Vector u;
+	Vector v;
+	for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+		scalar_type a = f.translation()[i] / unit;
+		scalar_type b = a;
+		for (std::size_t j = 0; j < GK::GK_3D; ++j) {
+			const scalar_type p = f.matrix(i, j) * (x.min()[j] / unit);
+			const scalar_type q = f.matrix(i, j) * (x.max()[j] / unit);
+			a += std::min(p, q);
+			b += std::max(p, q);
+		}
+		u[i] = a * unit;
+		v[i] = b * unit;
+	}
+
+	return aabb<Vector>(u, v);
+}
+
+/**
+ * @brief Transforms a B-spline curve by transforming its control points.
+ */
+template<typename Transform, typename Vector, typename Parameter>
+bspline<Vector, Parameter> transform(const Transform& f,
+		const bspline<Vector, Parameter>& x) {
+	bspline<Vector, Parameter> r(x);
+	typename bspline<Vector, Parameter>::control_points& Q = r.controls();
+	transform(f, Q.begin(), Q.end(), Q.begin());
+	return r;
+}
+
+/**
+ * @brief Transforms a B-spline surface by transforming its control points.
+ */
+template<typename Transform, typename Vector, typename Parameter,
+		typename Allocator>
+bsurface<Vector, Parameter, Allocator> transform(const Transform& f,
+		const bsurface<Vector, Parameter, Allocator>& x) {
+	bsurface<Vector, Parameter, Allocator> r(x);
+	typename bsurface<Vector, Parameter, Allocator>::network_type& Q =
+			r.controls();
+	transform(f, Q.begin(), Q.end(), Q.begin());
+	return r;
+}
+
+namespace impl {
+
+/**
+ * @brief Kernel applying a transform to blocks of elements.
+ *
+ * Positions are gathered into separate coordinate arrays, as in
+ * rotation_kernel; the other geometries are transformed one by one.
+ *
+ * @date 2026/10/18
+ */
+template<typename Transform>
+struct transform_kernel {
+	static const std::size_t BlockSize = rotation_kernel<typename Transform::scalar_type>::BlockSize; ///< The number of elements in a block.
+	static const std::ptrdiff_t ParallelSize = 1 << 12; ///< The minimum number of elements to transform in parallel.
+
+	typedef typename Transform::vector_type vector_type;
+	typedef typename vector_traits<vector_type>::value_type value_type;
+	typedef typename Transform::scalar_type scalar_type;
+
+	const Transform& f;
+
+	explicit transform_kernel(const Transform& transform) :
+			f(transform) {
+	}
+
+	/**
+	 * @brief Transforms @a n positions, at most BlockSize, from @a first
+	 * to @a result. The ranges may be the same.
+	 */
+	template<typename InputRandomAccessIterator,
+			typename OutputRandomAccessIterator>
+	void operator()(InputRandomAccessIterator first, std::size_t n,
+			OutputRandomAccessIterator result, const vector_type*) const {
+		const value_type unit = value_type(GK_FLOAT_ONE);
+
+		scalar_type A[GK::GK_3D * GK::GK_3D];
+		scalar_type t[GK::GK_3D];
+		for (std::size_t i = 0; i < GK::GK_3D; ++i) {
+			for (std::size_t j = 0; j < GK::GK_3D; ++j) {
+				A[i * GK::GK_3D + j] = this->f.matrix(i, j);
+			}
+			t[i] = this->f.translation()[i] / unit;
+		}
+
+		scalar_type x[BlockSize];
+		scalar_type y[BlockSize];
+		scalar_type z[BlockSize];
+		for (std::size_t i = 0; i < n; ++i) {
+			const vector_type& v = first[i];
+			x[i] = v[GK::X] / unit;
+			y[i] = v[GK::Y] / unit;
+			z[i] = v[GK::Z] / unit;
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			const scalar_type a = x[i];
+			const scalar_type b = y[i];
+			const scalar_type c = z[i];
+			x[i] = A[0] * a + A[1] * b + A[2] * c + t[GK::X];
+			y[i] = A[3] * a + A[4] * b + A[5] * c + t[GK::Y];
+			z[i] = A[6] * a + A[7] * b + A[8] * c + t[GK::Z];
+		}
+
+		for (std::size_t i = 0; i < n; ++i) {
+			vector_type r;
+			r[GK::X] = x[i] * unit;
+			r[GK::Y] = y[i] * unit;
+			r[GK::Z] = z[i] * unit;
+			result[i] = r;
+		}
+	}
+
+	/**
+	 * @brief Transforms @a n geometries from @a first to @a result.
+	 */
+	template<typename InputRandomAccessIterator,
+			typename OutputRandomAccessIterator, typename T>
+	void operator()(InputRandomAccessIterator first, std::size_t n,
+			OutputRandomAccessIterator result, const T*) const {
+		for (std::size_t i = 0; i < n; ++i) {
+			result[i] = transform(this->f, first[i]);
+		}
+	}
+};
+
+} // namespace impl
+
+/**
+ * @brief Transforms geometries in [first, last); positions, directions,
+ * lines, segments, polylines, planes, triangles, boxes, B-spline curves
+ * and surfaces.
+ *
+ * The geometries are processed in blocks, in parallel for a large range
+ * when OpenMP is enabled. The result may be @a first.
+ *
+ * @param f A rigid or an affine transform.
+ * @param first
+ * @param last
+ * @param result The beginning of the transformed geometries.
+ * @return The end of the transformed geometries.
+ */
+template<typename Transform, typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator transform(const Transform& f,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type geometry_type;
+	typedef impl::transform_kernel<Transform> kernel_type;
+
+	const kernel_type kernel(f);
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	const std::ptrdiff_t block = kernel_type::BlockSize;
+	const std::ptrdiff_t blocks = (n + block - 1) / block;
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(dynamic, 4) if (n >= kernel_type::ParallelSize)
+#endif
+	for (std::ptrdiff_t i = 0; i < blocks; ++i) {
+		const std::ptrdiff_t k = i * block;
+		kernel(first + k, std::size_t(std::min(block, n - k)), result + k,
+				static_cast<const geometry_type*>(0));
+	}
+
+	return result + n;
+}
+
+} // namespace gk
+
+#endif /* GKTRANSFORM_H_ */
@@ -12,6 +12,7 @@
 #include "gkfunctional.h"
 #include "gkgeometry.h"
 #include "gkquaternion.h"
+#include "vector/vec.h"
 
 #include <numeric>
 #include <cmath>
@@ -24,9 +25,27 @@
 
 namespace gk {
 
+/**
+ * @brief Type of a vector of @a Dimension components of @a T; the Eigen
+ * row vector, or gk::vec if GK_VECTOR_BUILTIN is defined.
+ */
 template<typename T, std::size_t Dimension>
 struct vector_type {
+#ifdef GK_VECTOR_BUILTIN
+	typedef vec<T, Dimension> type;
+#else
 	typedef Eigen::Matrix<T, 1, Dimension, Eigen::RowMajor> type;
+#endif
+};
+
+/**
+ * @brief Type of the homogeneous vector of a @a Vector, of one more
+ * component for the weight.
+ */
+template<typename Vector>
+struct homogeneous_vector {
+	typedef typename vector_type<typename vector_traits<Vector>::value_type,
+			vector_traits<Vector>::Dimension + 1>::type type;
 };
 
 /**
@@ -174,6 +193,29 @@ typename vector_traits<Vector>::value_type norm(const Vector& v) {
 	return std::sqrt(dot(v, v));
 }
 
+/**
+ * @brief Makes a vector of which all the components are zero.
+ *
+ * A default constructed vector is not always zero; the Eigen vector leaves
+ * its components uninitialized.
+ *
+ * @tparam Vector The vector type.
+ * @return The zero vector.
+ */
+template<typename Vector>
+Vector zero_vector() {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	const std::size_t Dimension = vector_traits<Vector>::Dimension;
+
+	Vector r;
+	for (std::size_t i = 0; i < Dimension; ++i) {
+		r[i] = value_type(GK_FLOAT_ZERO);
+	}
+
+	return r;
+}
+
 //namespace impl {
 //
 //template<typename Vector1, typename Vector2, typename Result>
@@ -212,17 +254,20 @@ struct cross {
 /**
  * @brief Direction.
  *
+ * @tparam Dimension Dimension of the space.
+ * @tparam T Type of the components, which are dimensionless.
+ *
  * @author Takuya Makimoto
  * @date 2016/01/25
  */
-template<std::size_t Dimension>
+template<std::size_t Dimension, typename T = float_type>
 class direction {
 public:
-	typedef float_type value_type;
+	typedef T value_type;
 	typedef const value_type* const_iterator;
 	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
-	typedef Eigen::Matrix<value_type, 1, Dimension> vector_type;
+	typedef typename gk::vector_type<value_type, Dimension>::type vector_type;
 
 //	static const std::size_t Dimension = DimensionSize;
 //	static const std::size_t ElementSize = DimensionSize;
@@ -247,10 +292,23 @@ public:
 		std::copy(other.x_, other.x_ + Dimension, this->x_);
 	}
 
+	/**
+	 * @brief Constructs the direction of a vector @a v.
+	 * @param v A vector, or an array of the components.
+	 */
 	template<typename Vector>
 	direction(const Vector& v) :
 			x_() {
+		value_type L2 = value_type(GK_FLOAT_ZERO);
+		for (std::size_t i = 0; i < Dimension; ++i) {
+			this->x_[i] = v[i];
+			L2 += this->x_[i] * this->x_[i];
+		}
 
+		const value_type F = value_type(GK_FLOAT_ONE) / std::sqrt(L2);
+		for (std::size_t i = 0; i < Dimension; ++i) {
+			this->x_[i] *= F;
+		}
 	}
 
 	template<typename Vector>
@@ -318,66 +376,68 @@ private:
  *
  * @date 2016/03/07
  */
-template<size_t DimensionSize>
-struct vector_traits<direction<DimensionSize> > {
-	typedef typename direction<DimensionSize>::value_type value_type; ///< Type of elements in a vector.
+template<size_t DimensionSize, typename T>
+struct vector_traits<direction<DimensionSize, T> > {
+	typedef typename direction<DimensionSize, T>::value_type value_type; ///< Type of elements in a vector.
 
 	static const size_t Dimension = DimensionSize; ///< A dimension size of a vector space.
 	static const bool IsHomogeneous = false;
 
-	typedef typename direction<DimensionSize>::const_iterator iterator;
-	typedef typename direction<DimensionSize>::const_iterator const_iterator;
-	typedef typename direction<DimensionSize>::const_reverse_iterator reverse_iterator;
-	typedef typename direction<DimensionSize>::const_reverse_iterator const_reverse_iterator;
+	typedef typename direction<DimensionSize, T>::const_iterator iterator;
+	typedef typename direction<DimensionSize, T>::const_iterator const_iterator;
+	typedef typename direction<DimensionSize, T>::const_reverse_iterator reverse_iterator;
+	typedef typename direction<DimensionSize, T>::const_reverse_iterator const_reverse_iterator;
 
-	static const_iterator begin(const direction<DimensionSize>& d) {
+	static const_iterator begin(const direction<DimensionSize, T>& d) {
 		return d.begin();
 	}
 
-	static iterator begin(direction<DimensionSize>& d) {
+	static iterator begin(direction<DimensionSize, T>& d) {
 		return d.begin();
 	}
 
-	static const_iterator end(const direction<DimensionSize>& d) {
+	static const_iterator end(const direction<DimensionSize, T>& d) {
 		return d.end();
 	}
 
-	static iterator end(direction<DimensionSize>& d) {
+	static iterator end(direction<DimensionSize, T>& d) {
 		return d.end();
 	}
 
-	static const_reverse_iterator rbegin(const direction<DimensionSize>& d) {
+	static const_reverse_iterator rbegin(const direction<DimensionSize, T>& d) {
 		return d.rbegin();
 	}
 
-	static reverse_iterator rbegin(direction<DimensionSize>& d) {
+	static reverse_iterator rbegin(direction<DimensionSize, T>& d) {
 		return d.rbegin();
 	}
 
-	static const_reverse_iterator rend(const direction<DimensionSize>& d) {
+	static const_reverse_iterator rend(const direction<DimensionSize, T>& d) {
 		return d.rend();
 	}
 
-	static reverse_iterator rend(direction<DimensionSize>& d) {
+	static reverse_iterator rend(direction<DimensionSize, T>& d) {
 		return d.rend();
 	}
 };
 
-template<size_t Dimension>
-bool operator==(const direction<Dimension>& u, const direction<Dimension>& v) {
+template<size_t Dimension, typename T>
+bool operator==(const direction<Dimension, T>& u,
+		const direction<Dimension, T>& v) {
 	return std::equal(u.begin(), u.end(), v.begin());
 }
 
-template<size_t Dimension>
-bool operator!=(const direction<Dimension>& u, const direction<Dimension>& v) {
+template<size_t Dimension, typename T>
+bool operator!=(const direction<Dimension, T>& u,
+		const direction<Dimension, T>& v) {
 	return !(u == v);
 }
 
-template<typename CharT, typename Traits, size_t Dimension>
+template<typename CharT, typename Traits, size_t Dimension, typename T>
 std::basic_ostream<CharT, Traits>& operator<<(
-		std::basic_ostream<CharT, Traits>& os, const direction<Dimension>& v) {
+		std::basic_ostream<CharT, Traits>& os, const direction<Dimension, T>& v) {
 	const std::streamsize n = os.width();
-	for (typename direction<Dimension>::const_iterator p = v.begin();
+	for (typename direction<Dimension, T>::const_iterator p = v.begin();
 			p != v.end(); ++p) {
 		os.width(n);
 		os << *p;
@@ -412,6 +472,25 @@ direction<vector_traits<Vector>::Dimension> normalize(const Vector& v) {
 			vector_traits<Vector>::begin(v));
 }
 
+/**
+ * @brief Makes a vector of the components of a direction, so that it can
+ * be scaled and added to positions.
+ * @tparam Vector The vector type.
+ * @param u The direction.
+ * @return
+ */
+template<typename Vector, std::size_t Dimension, typename T>
+Vector to_vector(const direction<Dimension, T>& u) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+	Vector r;
+	for (std::size_t i = 0; i < Dimension; ++i) {
+		r[i] = value_type(u[i]);
+	}
+
+	return r;
+}
+
 /**
  * @brief Computes a norm of a direction. This function always returns @b1
  * because a direction is a unit vector.
@@ -419,9 +498,148 @@ direction<vector_traits<Vector>::Dimension> normalize(const Vector& v) {
  * @param
  * @return Returns the magnitude of the direction, 1.
  */
-template<size_t Dimension>
-float_type norm(const direction<Dimension>&) {
-	return float_type(GK_FLOAT_ONE);
+template<size_t Dimension, typename T>
+T norm(const direction<Dimension, T>&) {
+	return T(GK_FLOAT_ONE);
+}
+
+namespace impl {
+
+/**
+ * @brief Replaces @a n values from @a x by their reciprocal square roots.
+ */
+template<typename T>
+void inverse_sqrt(T* x, std::size_t n) {
+	for (std::size_t i = 0; i < n; ++i) {
+		x[i] = T(GK_FLOAT_ONE) / std::sqrt(x[i]);
+	}
+}
+
+#if defined(GK_SSE2)
+
+/**
+ * @brief Replaces @a n single precision values from @a x by their
+ * reciprocal square roots, the estimates of the instruction refined by
+ * a Newton step, @f$y' = y(3 - xy^2)/2@f$.
+ *
+ * The estimate is within a relative error of @f$1.5 \cdot 2^{-12}@f$, and
+ * the step reduces it below @f$2^{-21}@f$.
+ */
+inline void inverse_sqrt(float* x, std::size_t n) {
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 three = _mm_set1_ps(3.0f);
+
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128 a = _mm_loadu_ps(x + i);
+		const __m128 y = _mm_rsqrt_ps(a);
+		const __m128 e = _mm_sub_ps(three, _mm_mul_ps(a, _mm_mul_ps(y, y)));
+		_mm_storeu_ps(x + i, _mm_mul_ps(_mm_mul_ps(half, y), e));
+	}
+	for (; i < n; ++i) {
+		x[i] = 1.0f / std::sqrt(x[i]);
+	}
+}
+
+#endif
+
+/**
+ * @brief Kernel normalizing vectors in blocks.
+ *
+ * The vectors are gathered into separate coordinate arrays as in
+ * rotation_kernel, and the reciprocal square roots of the squared norms are
+ * computed over a contiguous array by inverse_sqrt().
+ *
+ * @tparam T Type of the components, in which the norms are computed.
+ * @tparam Dimension Dimension of the space.
+ *
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t Dimension>
+struct normalize_kernel {
+	static const std::size_t BlockSize = 256; ///< The number of vectors in a block.
+	static const std::ptrdiff_t ParallelSize = 1 << 15; ///< The minimum number of vectors to normalize in parallel.
+
+	/**
+	 * @brief Normalizes @a n vectors, at most BlockSize, from @a first to
+	 * the vectors from @a result. The ranges may be the same.
+	 */
+	template<typename InputRandomAccessIterator,
+			typename OutputRandomAccessIterator>
+	void operator()(InputRandomAccessIterator first, std::size_t n,
+			OutputRandomAccessIterator result) const {
+		typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+		typedef typename vector_traits<vector_type>::value_type value_type;
+		const value_type unit = value_type(GK_FLOAT_ONE);
+
+		T x[Dimension][BlockSize];
+		T s[BlockSize];
+		for (std::size_t i = 0; i < n; ++i) {
+			const vector_type& v = first[i];
+			for (std::size_t d = 0; d < Dimension; ++d) {
+				x[d][i] = v[d] / unit;
+			}
+		}
+
+		std::fill(s, s + n, T(GK_FLOAT_ZERO));
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			for (std::size_t i = 0; i < n; ++i) {
+				s[i] += x[d][i] * x[d][i];
+			}
+		}
+
+		inverse_sqrt(s, n);
+
+		// Writes the components in place, since a vector stored component by
+		// component and copied at once stalls on the store forwarding.
+		for (std::size_t i = 0; i < n; ++i) {
+			for (std::size_t d = 0; d < Dimension; ++d) {
+				result[i][d] = (x[d][i] * s[i]) * unit;
+			}
+		}
+	}
+};
+
+} // namespace impl
+
+/**
+ * @brief Normalizes vectors in [first, last) to unit vectors.
+ *
+ * The vectors are processed in blocks, in parallel for a large range when
+ * OpenMP is enabled. The result may be @a first. Single precision vectors
+ * are normalized with the reciprocal square root estimate and a Newton
+ * step on SSE2, within a relative error of @f$2^{-21}@f$ in the norm;
+ * the others are divided by their norms. A zero vector results in NaN, as
+ * normalize(const Vector&) does.
+ *
+ * @param first
+ * @param last
+ * @param result The beginning of the vectors whose components are set to
+ * those of the unit vectors.
+ * @return The end of the unit vectors.
+ */
+template<typename InputRandomAccessIterator, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator normalize(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, OutputRandomAccessIterator result) {
+	typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+	typedef impl::normalize_kernel<typename vector_traits<vector_type>::value_type,
+			vector_traits<vector_type>::Dimension> kernel_type;
+
+	const kernel_type kernel = kernel_type();
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	const std::ptrdiff_t block = kernel_type::BlockSize;
+	const std::ptrdiff_t blocks = (n + block - 1) / block;
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (n >= kernel_type::ParallelSize)
+#endif
+	for (std::ptrdiff_t i = 0; i < blocks; ++i) {
+		const std::ptrdiff_t k = i * block;
+		kernel(first + k, std::size_t(std::min(block, n - k)), result + k);
+	}
+
+	return result + n;
 }
 
 namespace impl {
@@ -463,18 +681,20 @@ direction<vector_traits<Vector>::Dimension> normal_direction(const Vector& u,
 
 /**
  * @brief Basis in a vector space.
+ * @tparam DimensionSize Dimension of the space.
+ * @tparam T Type of the components of the directions.
  * @author Takuya Makimoto
  * @date 2015/12/09
  */
-template<size_t DimensionSize>
+template<size_t DimensionSize, typename T = float_type>
 class basis {
 public:
 	static const size_t Dimension = DimensionSize;
-	typedef direction<DimensionSize> direction_type;
+	typedef direction<DimensionSize, T> direction_type;
 
 private:
 	static direction_type Value_(std::size_t n) {
-		float_type x[DimensionSize] = { float_type(GK_FLOAT_ZERO) };
+		T x[DimensionSize] = { T(GK_FLOAT_ZERO) };
 		x[n] = GK_FLOAT_ONE;
 		return direction_type(x);
 	}
@@ -506,36 +726,228 @@ Vector rotate(const Vector& v, float_type angle) {
 	return r;
 }
 
-template<typename Vector>
-Vector rotate(const Vector& v,
-		const typename vector_type<float_type, GK::GK_3D>::type& angle) {
+namespace impl {
+
+/**
+ * @brief Computes the unit quaternion of the rotation by an angle vector,
+ * whose direction is the axis and whose norm is the angle.
+ * @param angle The angle vector.
+ */
+template<typename T>
+basic_quaternion<T> rotation_quaternion(
+		const typename vector_type<T, GK::GK_3D>::type& angle) {
+	typedef T value_type;
+	typedef basic_quaternion<T> quaternion_type;
+
+	const value_type theta = norm(angle);
+	if (!(theta > value_type(GK_FLOAT_ZERO))) {
+		return quaternion_type();
+	}
+
+	const value_type sin = std::sin(value_type(0.5) * theta) / theta;
+	const value_type cos = std::cos(value_type(0.5) * theta);
+
+	return quaternion_type(sin * angle[GK::X], sin * angle[GK::Y],
+			sin * angle[GK::Z], cos);
+}
+
+/**
+ * @brief Kernel rotating vectors by the 3x3 matrix of a quaternion.
+ *
+ * The vectors are gathered into blocks of separate coordinate arrays, so
+ * that the product with the matrix runs over contiguous arrays which the
+ * compiler vectorizes.
+ *
+ * @tparam T Type of the components of the quaternion, in which the
+ * rotation is computed.
+ *
+ * @date 2026/10/18
+ */
+template<typename T>
+struct rotation_kernel {
+	static const std::size_t BlockSize = 256; ///< The number of vectors in a block.
+	static const std::ptrdiff_t ParallelSize = 1 << 15; ///< The minimum number of vectors to rotate in parallel.
+
+	typedef basic_quaternion<T> quaternion_type;
+
+	T R[9]; ///< The rotation matrix in row-major order.
+
+	/**
+	 * @brief Constructs the kernel of a quaternion @a Q, which needs not
+	 * be normalized.
+	 */
+	explicit rotation_kernel(const quaternion_type& Q) :
+			R() {
+		const T s = T(2) / Q.square_norm();
+		const T x = Q[quaternion_type::X];
+		const T y = Q[quaternion_type::Y];
+		const T z = Q[quaternion_type::Z];
+		const T w = Q[quaternion_type::W];
+		const T One = T(GK_FLOAT_ONE);
+
+		this->R[0] = One - s * (y * y + z * z);
+		this->R[1] = s * (x * y - w * z);
+		this->R[2] = s * (x * z + w * y);
+		this->R[3] = s * (x * y + w * z);
+		this->R[4] = One - s * (x * x + z * z);
+		this->R[5] = s * (y * z - w * x);
+		this->R[6] = s * (x * z - w * y);
+		this->R[7] = s * (y * z + w * x);
+		this->R[8] = One - s * (x * x + y * y);
+	}
+
+	/**
+	 * @brief Rotates @a n vectors, at most BlockSize, from @a first to
+	 * @a result. The ranges may be the same.
+	 */
+	template<typename InputRandomAccessIterator,
+			typename OutputRandomAccessIterator>
+	void operator()(InputRandomAccessIterator first, std::size_t n,
+			OutputRandomAccessIterator result) const {
+		typedef typename std::iterator_traits<InputRandomAccessIterator>::value_type vector_type;
+		typedef typename vector_traits<vector_type>::value_type value_type;
+		const value_type unit = value_type(GK_FLOAT_ONE);
+
+		T x[BlockSize];
+		T y[BlockSize];
+		T z[BlockSize];
+		for (std::size_t i = 0; i < n; ++i) {
+			const vector_type& v = first[i];
+			x[i] = v[GK::X] / unit;
+			y[i] = v[GK::Y] / unit;
+			z[i] = v[GK::Z] / unit;
+		}
 
-	const float_type theta = norm(angle);
-	const direction<GK::GK_3D> axis(angle);
+		const T* const R = this->R;
+		for (std::size_t i = 0; i < n; ++i) {
+			const T a = x[i];
+			const T b = y[i];
+			const T c = z[i];
+			x[i] = R[0] * a + R[1] * b + R[2] * c;
+			y[i] = R[3] * a + R[4] * b + R[5] * c;
+			z[i] = R[6] * a + R[7] * b + R[8] * c;
+		}
 
-	const float_type sin = std::sin(0.5 * theta);
-	const float_type cos = std::cos(0.5 * theta);
+		for (std::size_t i = 0; i < n; ++i) {
+			vector_type r;
+			r[GK::X] = x[i] * unit;
+			r[GK::Y] = y[i] * unit;
+			r[GK::Z] = z[i] * unit;
+			result[i] = r;
+		}
+	}
+};
 
-	const quaternion Q(sin * axis[GK::X], sin * axis[GK::Y], sin * axis[GK::Z],
-			cos);
+} // namespace impl
 
+/**
+ * @brief Rotates a vector @a v in a 3D space by a unit quaternion @a Q.
+ *
+ * Computes @f$\mathbf{v} + w\mathbf{t} + \mathbf{q} \times \mathbf{t}@f$
+ * with @f$\mathbf{t} = 2\mathbf{q} \times \mathbf{v}@f$, where
+ * @f$\mathbf{q}@f$ and @f$w@f$ are the imaginary and the real part of
+ * @a Q, instead of the two products of quaternions. The rotation is
+ * computed in the type of the components of @a Q.
+ *
+ * @param v
+ * @param Q
+ * @return The rotated vector.
+ */
+template<typename Vector, typename T>
+Vector rotate(const Vector& v, const basic_quaternion<T>& Q) {
 	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef basic_quaternion<T> quaternion_type;
 	const value_type unit = value_type(GK_FLOAT_ONE);
 
-	const typename vector_type<float_type, GK::GK_3D>::type u = v / unit;
-	const quaternion P(u, quaternion::value_type(GK_FLOAT_ZERO));
+	const T x = v[GK::X] / unit;
+	const T y = v[GK::Y] / unit;
+	const T z = v[GK::Z] / unit;
 
-	//		const quaternion R = conj(Q) * P * Q;
-	const quaternion R = Q * P * conj(Q);
+	const T qx = Q[quaternion_type::X];
+	const T qy = Q[quaternion_type::Y];
+	const T qz = Q[quaternion_type::Z];
+	const T w = Q[quaternion_type::W];
+
+	const T tx = T(2) * (qy * z - qz * y);
+	const T ty = T(2) * (qz * x - qx * z);
+	const T tz = T(2) * (qx * y - qy * x);
 
 	Vector r;
-	r[GK::X] = R[quaternion::X] * unit;
-	r[GK::Y] = R[quaternion::Y] * unit;
-	r[GK::Z] = R[quaternion::Z] * unit;
+	r[GK::X] = (x + w * tx + qy * tz - qz * ty) * unit;
+	r[GK::Y] = (y + w * ty + qz * tx - qx * tz) * unit;
+	r[GK::Z] = (z + w * tz + qx * ty - qy * tx) * unit;
 
 	return r;
 }
 
+/**
+ * @brief Rotates a vector @a v in a 3D space by an angle vector, whose
+ * direction is the axis and whose norm is the angle.
+ * @param v
+ * @param angle
+ * @return The rotated vector.
+ */
+template<typename Vector>
+Vector rotate(const Vector& v,
+		const typename vector_type<float_type, GK::GK_3D>::type& angle) {
+	return rotate(v, impl::rotation_quaternion<float_type>(angle));
+}
+
+/**
+ * @brief Rotates vectors in [first, last) in a 3D space by a quaternion
+ * @a Q.
+ *
+ * The quaternion is converted to a matrix once, and the vectors are rotated
+ * in blocks, in parallel for a large range when OpenMP is enabled. The
+ * result may be @a first.
+ *
+ * @param first
+ * @param last
+ * @param Q The quaternion of the rotation, which needs not be normalized.
+ * @param result The beginning of the rotated vectors.
+ * @return The end of the rotated vectors.
+ */
+template<typename InputRandomAccessIterator, typename OutputRandomAccessIterator,
+		typename T>
+OutputRandomAccessIterator rotate(InputRandomAccessIterator first,
+		InputRandomAccessIterator last, const basic_quaternion<T>& Q,
+		OutputRandomAccessIterator result) {
+	typedef impl::rotation_kernel<T> kernel_type;
+
+	const kernel_type kernel(Q);
+
+	const std::ptrdiff_t n = std::distance(first, last);
+	const std::ptrdiff_t block = kernel_type::BlockSize;
+	const std::ptrdiff_t blocks = (n + block - 1) / block;
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (n >= kernel_type::ParallelSize)
+#endif
+	for (std::ptrdiff_t i = 0; i < blocks; ++i) {
+		const std::ptrdiff_t k = i * block;
+		kernel(first + k, std::size_t(std::min(block, n - k)), result + k);
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Rotates vectors in [first, last) in a 3D space by an angle vector,
+ * whose direction is the axis and whose norm is the angle.
+ * @param first
+ * @param last
+ * @param angle
+ * @param result The beginning of the rotated vectors.
+ * @return The end of the rotated vectors.
+ */
+template<typename InputRandomAccessIterator, typename OutputRandomAccessIterator>
+OutputRandomAccessIterator rotate(InputRandomAccessIterator first,
+		InputRandomAccessIterator last,
+		const typename vector_type<float_type, GK::GK_3D>::type& angle,
+		OutputRandomAccessIterator result) {
+	return rotate(first, last, impl::rotation_quaternion<float_type>(angle), result);
+}
+
 ///**
 // * @brief
 // * @tparam Vector
@@ -0,0 +1,241 @@
+/*
+ * mesh_nearest.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef MESH_MESH_NEAREST_H_
+#define MESH_MESH_NEAREST_H_
+
+#include <vector>
+#include <limits>
+#include <iterator>
+
+#include "trimesh.h"
+#include "../algorithm/aabbtree.h"
+#include "../algorithm/morton.h"
+#include "../algorithm/triangle_nearest.h"
+
+namespace gk {
+
+/**
+ * @brief Position on a face of a triangle mesh.
+ *
+ * @tparam Vector Type of a vector in 3D.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+struct mesh_point {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef typename trimesh<Vector>::index_type index_type;
+
+	index_type face; ///< The index of the face, trimesh::NoIndex of an empty mesh.
+	value_type s; ///< Barycentric coordinate of the second vertex of the face.
+	value_type t; ///< Barycentric coordinate of the third vertex of the face.
+	Vector position;
+	value_type square_distance; ///< The square of the distance from the query.
+
+	mesh_point() :
+			face(trimesh<Vector>::NoIndex), s(), t(), position(), square_distance(
+					std::numeric_limits<value_type>::max()) {
+	}
+};
+
+namespace impl {
+
+/**
+ * @brief Finds the nearest positions on a triangle mesh.
+ *
+ * The faces are visited nearest first and pruned by the square distance of
+ * their boxes against the best so far. The face nearest to the previous
+ * query bounds the search from the start, which prunes most of the tree
+ * when the queries are coherent. An instance keeps its stack and the last
+ * face, so it is made once for each thread.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class trimesh_nearest_kernel {
+public:
+	typedef trimesh<Vector> mesh_type;
+	typedef typename mesh_type::index_type index_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef aabbtree<index_type, Vector> tree_type;
+	typedef mesh_point<Vector> point_type;
+
+public:
+	trimesh_nearest_kernel(const mesh_type& a, const tree_type& X) :
+			a_(a), X_(X), stack_(), last_(mesh_type::NoIndex) {
+	}
+
+	~trimesh_nearest_kernel() {
+	}
+
+	point_type operator()(const Vector& v) {
+		point_type result;
+		if (this->X_.empty()) {
+			return result;
+		}
+
+		if (this->last_ != mesh_type::NoIndex) {
+			this->face_(this->last_, v, result);
+		}
+
+		this->stack_.clear();
+		this->stack_.push_back(0);
+
+		while (!this->stack_.empty()) {
+			const typename tree_type::node& x = this->X_.node_at(
+					this->stack_.back());
+			this->stack_.pop_back();
+
+			if (!(square_distance(x.box, v) < result.square_distance)) {
+				continue;
+			}
+
+			if (x.is_leaf()) {
+				for (std::size_t k = x.first; k < x.first + x.size; ++k) {
+					if (square_distance(this->X_.box(k), v)
+							< result.square_distance) {
+						this->face_(this->X_[k], v, result);
+					}
+				}
+
+			} else {
+				// Visits the nearer child first.
+				const value_type d0 = square_distance(
+						this->X_.node_at(x.first).box, v);
+				const value_type d1 = square_distance(
+						this->X_.node_at(x.first + 1).box, v);
+				if (d0 < d1) {
+					this->stack_.push_back(x.first + 1);
+					this->stack_.push_back(x.first);
+				} else {
+					this->stack_.push_back(x.first);
+					this->stack_.push_back(x.first + 1);
+				}
+			}
+		}
+
+		this->last_ = result.face;
+		return result;
+	}
+
+private:
+	const mesh_type& a_;
+	const tree_type& X_;
+	std::vector<std::size_t> stack_;
+	index_type last_; ///< The face nearest to the previous query.
+
+private:
+	trimesh_nearest_kernel(const trimesh_nearest_kernel&);
+	trimesh_nearest_kernel& operator=(const trimesh_nearest_kernel&);
+
+	/**
+	 * @brief Replaces @a result with the nearest position on a face @a f
+	 * if it is nearer.
+	 */
+	void face_(index_type f, const Vector& v, point_type& result) const {
+		value_type s;
+		value_type t;
+		const Vector x = alg::nearest_on_triangle(v,
+				this->a_.vertex(this->a_.index(f, 0)),
+				this->a_.vertex(this->a_.index(f, 1)),
+				this->a_.vertex(this->a_.index(f, 2)), s, t);
+		const Vector r = x - v;
+		const value_type d2 = dot(r, r);
+		if (d2 < result.square_distance) {
+			result.face = f;
+			result.s = s;
+			result.t = t;
+			result.position = x;
+			result.square_distance = d2;
+		}
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Computes the nearest position on a triangle mesh to a position
+ * @a v.
+ *
+ * @param a
+ * @param X The hierarchy of the faces made by face_tree().
+ * @param v
+ * @return The nearest position.
+ */
+template<typename Vector>
+mesh_point<Vector> nearest(const trimesh<Vector>& a,
+		const aabbtree<typename trimesh<Vector>::index_type, Vector>& X,
+		const Vector& v) {
+	impl::trimesh_nearest_kernel<Vector> kernel(a, X);
+	return kernel(v);
+}
+
+/**
+ * @brief Computes the nearest positions on a triangle mesh to positions in
+ * [first, last).
+ *
+ * The positions are visited along their Morton order, so that consecutive
+ * queries of a thread are near and bound each other. The positions are
+ * processed in parallel when OpenMP is enabled.
+ *
+ * @param a
+ * @param X The hierarchy of the faces made by face_tree().
+ * @param first
+ * @param last
+ * @param result The beginning of the nearest positions, mesh_point.
+ * @return The end of the nearest positions.
+ */
+template<typename Vector, typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator nearest(const trimesh<Vector>& a,
+		const aabbtree<typename trimesh<Vector>::index_type, Vector>& X,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	const std::ptrdiff_t n = std::distance(first, last);
+
+	std::vector<std::size_t> order;
+	morton_order(first, last, order);
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::trimesh_nearest_kernel<Vector> kernel(a, X);
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			result[order[i]] = kernel(first[order[i]]);
+		}
+	}
+
+	return result + n;
+}
+
+/**
+ * @brief Computes the nearest positions on a triangle mesh to positions in
+ * [first, last).
+ *
+ * @param a
+ * @param first
+ * @param last
+ * @param result The beginning of the nearest positions, mesh_point.
+ * @return The end of the nearest positions.
+ */
+template<typename Vector, typename InputRandomAccessIterator,
+		typename OutputRandomAccessIterator>
+OutputRandomAccessIterator nearest(const trimesh<Vector>& a,
+		InputRandomAccessIterator first, InputRandomAccessIterator last,
+		OutputRandomAccessIterator result) {
+	return nearest(a, face_tree(a), first, last, result);
+}
+
+}  // namespace gk
+
+#endif /* MESH_MESH_NEAREST_H_ */
@@ -0,0 +1,462 @@
+/*
+ * sdf.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef MESH_SDF_H_
+#define MESH_SDF_H_
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "trimesh.h"
+#include "mesh_nearest.h"
+#include "../algorithm/sparse_grid.h"
+
+namespace gk {
+
+/**
+ * @brief Signed distance field sampled on a sparse grid in 3D.
+ *
+ * The voxel at @f$(i, j, k)@f$ samples the position
+ * @f$\mathbf{o} + h(i, j, k)@f$. The distance is negative inside.
+ *
+ * @tparam Vector Type of a vector in 3D.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class sdf_grid {
+public:
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef sparse_grid<value_type> grid_type;
+
+public:
+	sdf_grid() :
+			origin_(), spacing_(), X_() {
+	}
+
+	sdf_grid(const sdf_grid& other) :
+			origin_(other.origin_), spacing_(other.spacing_), X_(other.X_) {
+	}
+
+	/**
+	 * @brief Constructs the grid of @a nx, @a ny and @a nz voxels of a
+	 * spacing @a h from an origin @a o.
+	 */
+	sdf_grid(const Vector& o, const value_type& h, std::size_t nx,
+			std::size_t ny, std::size_t nz) :
+			origin_(o), spacing_(h), X_(nx, ny, nz,
+					std::numeric_limits<value_type>::max()) {
+	}
+
+	~sdf_grid() {
+	}
+
+	const Vector& origin() const {
+		return this->origin_;
+	}
+
+	const value_type& spacing() const {
+		return this->spacing_;
+	}
+
+	const grid_type& grid() const {
+		return this->X_;
+	}
+
+	grid_type& grid() {
+		return this->X_;
+	}
+
+	/**
+	 * @brief Returns the position of the voxel at @a i, @a j and @a k.
+	 */
+	Vector position(std::size_t i, std::size_t j, std::size_t k) const {
+		Vector v = this->origin_;
+		v[GK::X] += this->spacing_ * value_type(i);
+		v[GK::Y] += this->spacing_ * value_type(j);
+		v[GK::Z] += this->spacing_ * value_type(k);
+		return v;
+	}
+
+	/**
+	 * @brief Returns the distance at the voxel at @a i, @a j and @a k.
+	 */
+	const value_type& operator()(std::size_t i, std::size_t j,
+			std::size_t k) const {
+		return this->X_(i, j, k);
+	}
+
+	/**
+	 * @brief Interpolates the distance at a position @a v trilinearly,
+	 * clamping @a v into the grid.
+	 */
+	value_type value(const Vector& v) const {
+		const value_type Zero = value_type(GK_FLOAT_ZERO);
+		const value_type One = value_type(GK_FLOAT_ONE);
+
+		std::size_t i[GK::GK_3D];
+		value_type w[GK::GK_3D];
+		for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+			const std::size_t n = this->X_.size(d);
+			const value_type u = std::min(
+					std::max((v[d] - this->origin_[d]) / this->spacing_, Zero),
+					value_type(n - 1));
+			i[d] = std::min(std::size_t(u), (n < 2) ? 0 : n - 2);
+			w[d] = (n < 2) ? Zero : u - value_type(i[d]);
+		}
+
+		value_type result = Zero;
+		for (std::size_t c = 0; c < 8; ++c) {
+			const std::size_t a = c & 1;
+			const std::size_t b = (c >> 1) & 1;
+			const std::size_t e = (c >> 2) & 1;
+			const value_type f = (a ? w[GK::X] : One - w[GK::X])
+					* (b ? w[GK::Y] : One - w[GK::Y])
+					* (e ? w[GK::Z] : One - w[GK::Z]);
+			if (f != Zero) {
+				result += f * this->X_(i[GK::X] + a, i[GK::Y] + b, i[GK::Z] + e);
+			}
+		}
+		return result;
+	}
+
+	sdf_grid& operator=(const sdf_grid& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->origin_ = rhs.origin_;
+		this->spacing_ = rhs.spacing_;
+		this->X_ = rhs.X_;
+		return *this;
+	}
+
+private:
+	Vector origin_;
+	value_type spacing_;
+	grid_type X_;
+};
+
+namespace impl {
+
+/**
+ * @brief Angle-weighted pseudo-normals of a closed triangle mesh
+ * (Bærentzen and Aanæs), which give the sign of the distance from the
+ * nearest position on any of the faces, edges or vertices.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class pseudo_normals {
+public:
+	typedef trimesh<Vector> mesh_type;
+	typedef typename mesh_type::index_type index_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+
+public:
+	/**
+	 * @brief Computes the normals of a mesh @a a with its adjacency.
+	 */
+	explicit pseudo_normals(const mesh_type& a) :
+			F_(a.face_size()), E_(mesh_type::VertexSize * a.face_size()), V_(
+					a.vertex_size(), zero_()) {
+		const std::size_t Size = mesh_type::VertexSize;
+		const std::ptrdiff_t n = a.face_size();
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+		for (std::ptrdiff_t f = 0; f < n; ++f) {
+			const Vector x0 = a.vertex(a.index(f, 0));
+			const Vector w = cross<Vector>()(a.vertex(a.index(f, 1)) - x0,
+					a.vertex(a.index(f, 2)) - x0);
+			const value_type l = std::sqrt(dot(w, w));
+			this->F_[f] = (l > value_type(GK_FLOAT_ZERO)) ? Vector(w / l) : w;
+		}
+
+		for (std::ptrdiff_t f = 0; f < n; ++f) {
+			for (std::size_t k = 0; k < Size; ++k) {
+				const std::size_t h = Size * f + k;
+				const index_type g = a.opposite(h);
+				this->E_[h] = (g == mesh_type::NoIndex) ?
+						this->F_[f] : Vector(this->F_[f] + this->F_[g / Size]);
+
+				const Vector x = a.vertex(a.index(f, k));
+				const Vector u = a.vertex(a.index(f, (k + 1) % Size)) - x;
+				const Vector v = a.vertex(a.index(f, (k + 2) % Size)) - x;
+				const Vector c = cross<Vector>()(u, v);
+				const value_type angle = std::atan2(std::sqrt(dot(c, c)),
+						dot(u, v));
+				this->V_[a.index(f, k)] += angle * this->F_[f];
+			}
+		}
+	}
+
+	~pseudo_normals() {
+	}
+
+	/**
+	 * @brief Returns the pseudo-normal at a position @a x on a mesh,
+	 * choosing the vertex, the edge or the face by its barycentric
+	 * coordinates.
+	 */
+	const Vector& operator()(const mesh_type& a, const mesh_point<Vector>& x) const {
+		const std::size_t Size = mesh_type::VertexSize;
+		const value_type Zero = value_type(GK_FLOAT_ZERO);
+		const value_type One = value_type(GK_FLOAT_ONE);
+		const value_type Epsilon = value_type(4)
+				* std::numeric_limits<value_type>::epsilon();
+
+		const index_type f = x.face;
+		const bool s0 = !(x.s > Zero);
+		const bool t0 = !(x.t > Zero);
+		const bool st1 = !(x.s + x.t < One - Epsilon);
+
+		if (s0 && t0) {
+			return this->V_[a.index(f, 0)];
+		}
+		if (t0 && !(x.s < One)) {
+			return this->V_[a.index(f, 1)];
+		}
+		if (s0 && !(x.t < One)) {
+			return this->V_[a.index(f, 2)];
+		}
+		if (t0) {
+			return this->E_[Size * f + 0];
+		}
+		if (st1) {
+			return this->E_[Size * f + 1];
+		}
+		if (s0) {
+			return this->E_[Size * f + 2];
+		}
+		return this->F_[f];
+	}
+
+private:
+	std::vector<Vector> F_; ///< The unit normals of the faces.
+	std::vector<Vector> E_; ///< The pseudo-normals of the half-edges.
+	std::vector<Vector> V_; ///< The pseudo-normals of the vertices.
+
+private:
+	static Vector zero_() {
+		Vector v;
+		for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+			v[d] = value_type(GK_FLOAT_ZERO);
+		}
+		return v;
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Samples the signed distance to a closed triangle mesh onto a
+ * sparse grid.
+ *
+ * The blocks that may have a voxel within a distance @a band of a face are
+ * allocated, so that their number follows the area of the mesh rather than
+ * the volume of the boxes of the faces. Their voxels are sampled in
+ * parallel over the blocks by nearest() queries on the hierarchy of the
+ * faces; the sign is that of the pseudo-normal at the nearest position. The distances are clamped to
+ * @f$\pm band@f$. The other blocks are tiles of @f$\pm band@f$, their signs
+ * swept along the rows of the blocks from the neighboring allocated ones
+ * and positive in a row of no allocated block, so the boundary of the grid
+ * should be outside the mesh. A @a band not less than the diagonal of the
+ * grid allocates all the blocks, which gives a dense field.
+ *
+ * @param a A closed mesh of faces counterclockwise seen from outside.
+ * @param band The width of the narrow band, at least the spacing.
+ * @param result The grid with its origin, spacing and size; the values
+ * are replaced.
+ */
+template<typename Vector>
+void bake_sdf(const trimesh<Vector>& a,
+		typename vector_traits<Vector>::value_type band,
+		sdf_grid<Vector>& result) {
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef sparse_grid<value_type> grid_type;
+	const std::size_t BlockSize = grid_type::BlockSize;
+	const value_type Zero = value_type(GK_FLOAT_ZERO);
+
+	grid_type& X = result.grid();
+	const value_type h = result.spacing();
+	band = std::max(band, h);
+
+	std::size_t M[GK::GK_3D];
+	std::size_t N[GK::GK_3D];
+	for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+		N[d] = X.size(d);
+		M[d] = X.block_size(d);
+	}
+	X.reset(N[GK::X], N[GK::Y], N[GK::Z], band);
+	if (a.empty() || X.block_count() == 0) {
+		return;
+	}
+
+	trimesh<Vector> b;
+	const trimesh<Vector>* mesh = &a;
+	if (!a.has_adjacency()) {
+		b = a;
+		b.build_adjacency();
+		mesh = &b;
+	}
+
+	// Activates the blocks near the faces.
+	std::vector<char> active(X.block_count(), 0);
+	const Vector extent = result.position(N[GK::X] - 1, N[GK::Y] - 1,
+			N[GK::Z] - 1) - result.origin();
+	if (!(band < std::sqrt(dot(extent, extent)))) {
+		std::fill(active.begin(), active.end(), 1);
+	} else {
+		// A voxel within the band of a face is in a block whose centre is
+		// within the band and half the diagonal of the block.
+		const value_type w = value_type(BlockSize) * h;
+		const value_type half = value_type(0.5) * value_type(BlockSize - 1) * h;
+		const value_type reach = band
+				+ std::sqrt(value_type(GK::GK_3D)) * half;
+		for (std::size_t f = 0; f < mesh->face_size(); ++f) {
+			const aabb<Vector> box = mesh->box(f);
+			const Vector& x0 = mesh->vertex(mesh->index(f, 0));
+			const Vector& x1 = mesh->vertex(mesh->index(f, 1));
+			const Vector& x2 = mesh->vertex(mesh->index(f, 2));
+
+			std::size_t first[GK::GK_3D];
+			std::size_t last[GK::GK_3D];
+			bool empty = false;
+			for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+				const value_type u = std::floor(
+						(box.min()[d] - band - result.origin()[d]) / w);
+				const value_type v = std::floor(
+						(box.max()[d] + band - result.origin()[d]) / w);
+				if (v < Zero || !(u < value_type(M[d]))) {
+					empty = true;
+					break;
+				}
+				first[d] = (u < Zero) ? 0 : std::size_t(u);
+				last[d] = std::min(std::size_t(v), M[d] - 1);
+			}
+			if (empty) {
+				continue;
+			}
+
+			for (std::size_t k = first[GK::Z]; k <= last[GK::Z]; ++k) {
+				for (std::size_t j = first[GK::Y]; j <= last[GK::Y]; ++j) {
+					for (std::size_t i = first[GK::X]; i <= last[GK::X]; ++i) {
+						const std::size_t c = X.block_index(i, j, k);
+						if (active[c]) {
+							continue;
+						}
+
+						Vector centre = result.position(BlockSize * i,
+								BlockSize * j, BlockSize * k);
+						for (std::size_t d = 0; d < GK::GK_3D; ++d) {
+							centre[d] += half;
+						}
+						value_type s;
+						value_type t;
+						const Vector r = alg::nearest_on_triangle(centre, x0,
+								x1, x2, s, t) - centre;
+						if (!(dot(r, r) > reach * reach)) {
+							active[c] = 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::vector<std::size_t> blocks;
+	for (std::size_t n = 0; n < active.size(); ++n) {
+		if (active[n]) {
+			blocks.push_back(n);
+		}
+	}
+	X.reserve(blocks.size());
+	for (std::size_t n = 0; n < blocks.size(); ++n) {
+		X.allocate(blocks[n]);
+	}
+
+	// Samples the allocated blocks.
+	const aabbtree<typename trimesh<Vector>::index_type, Vector> T = face_tree(
+			*mesh);
+	const impl::pseudo_normals<Vector> normals(*mesh);
+	const std::ptrdiff_t m = blocks.size();
+
+#ifdef GK_OPENMP
+#pragma omp parallel
+#endif
+	{
+		impl::trimesh_nearest_kernel<Vector> kernel(*mesh, T);
+
+#ifdef GK_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+		for (std::ptrdiff_t n = 0; n < m; ++n) {
+			const std::size_t c = blocks[n];
+			const std::size_t bi = c % M[GK::X];
+			const std::size_t bj = (c / M[GK::X]) % M[GK::Y];
+			const std::size_t bk = c / (M[GK::X] * M[GK::Y]);
+			value_type* const x = X.block(c);
+
+			for (std::size_t k = 0; k < BlockSize; ++k) {
+				for (std::size_t j = 0; j < BlockSize; ++j) {
+					for (std::size_t i = 0; i < BlockSize; ++i) {
+						const Vector v = result.position(BlockSize * bi + i,
+								BlockSize * bj + j, BlockSize * bk + k);
+						const mesh_point<Vector> p = kernel(v);
+						const value_type d = std::min(
+								std::sqrt(p.square_distance), band);
+						const Vector r = v - p.position;
+						x[i + BlockSize * (j + BlockSize * k)] =
+								(dot(r, normals(*mesh, p)) < Zero) ? -d : d;
+					}
+				}
+			}
+		}
+	}
+
+	// Sweeps the signs of the tiles along the rows of the blocks.
+	const std::size_t Center = BlockSize / 2;
+	const std::ptrdiff_t rows = M[GK::Y] * M[GK::Z];
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (std::ptrdiff_t r = 0; r < rows; ++r) {
+		const std::size_t bj = r % M[GK::Y];
+		const std::size_t bk = r / M[GK::Y];
+		const std::size_t offset = BlockSize * (Center + BlockSize * Center);
+
+		// The sign before the first allocated block is of its first voxel.
+		value_type sign = band;
+		for (std::size_t bi = 0; bi < M[GK::X]; ++bi) {
+			const std::size_t c = X.block_index(bi, bj, bk);
+			if (X.is_allocated(c)) {
+				sign = (X.block(c)[offset] < Zero) ? -band : band;
+				break;
+			}
+		}
+
+		for (std::size_t bi = 0; bi < M[GK::X]; ++bi) {
+			const std::size_t c = X.block_index(bi, bj, bk);
+			if (X.is_allocated(c)) {
+				sign = (X.block(c)[offset + BlockSize - 1] < Zero) ?
+						-band : band;
+			} else {
+				X.tile(c, sign);
+			}
+		}
+	}
+}
+
+}  // namespace gk
+
+#endif /* MESH_SDF_H_ */
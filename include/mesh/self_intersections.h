@@ -0,0 +1,306 @@
+/*
+ * self_intersections.h
+ *
+ *  Created on: 2026/10/19
+ *      Author: makitaku
+ */
+
+#ifndef MESH_SELF_INTERSECTIONS_H_
+#define MESH_SELF_INTERSECTIONS_H_
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+#include "trimesh.h"
+#include "../algorithm/aabbtree.h"
+#include "../algorithm/ray_triangle.h"
+#include "../algorithm/triangle_overlap.h"
+
+namespace gk {
+
+namespace impl {
+
+/**
+ * @brief Finds the pairs of intersecting faces of a mesh by the traversal
+ * of the hierarchy of the faces against itself.
+ *
+ * The pairs of nodes whose boxes overlap are expanded breadth-first into
+ * at least @c TaskSize tasks, which are traversed in parallel with OpenMP,
+ * each with its own stack and its own results.
+ *
+ * @date 2026/10/19
+ */
+template<typename Vector>
+class self_intersection_kernel {
+public:
+	static const std::size_t TaskSize = 1024; ///< The minimum number of the tasks to run in parallel.
+
+	typedef trimesh<Vector> mesh_type;
+	typedef typename mesh_type::index_type index_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef aabbtree<index_type, Vector> tree_type;
+	typedef std::pair<index_type, index_type> face_pair;
+
+public:
+	self_intersection_kernel(const mesh_type& a, const tree_type& X) :
+			a_(a), X_(X), tolerance_(std::numeric_limits<value_type>::min()) {
+	}
+
+	~self_intersection_kernel() {
+	}
+
+	/**
+	 * @brief Finds the pairs of faces in the ascending order.
+	 */
+	void operator()(std::vector<face_pair>& result) const {
+		result.clear();
+		if (this->X_.empty()) {
+			return;
+		}
+
+		std::vector<node_pair> tasks;
+		const node_pair root = { 0, 0 };
+		tasks.push_back(root);
+		std::vector<node_pair> next;
+		for (bool expanded = true; expanded && tasks.size() < TaskSize;) {
+			expanded = false;
+			next.clear();
+			for (std::size_t i = 0; i < tasks.size(); ++i) {
+				expanded = this->expand_(tasks[i], next) || expanded;
+			}
+			tasks.swap(next);
+		}
+
+		const std::ptrdiff_t n = tasks.size();
+		std::vector<std::vector<face_pair> > R(n);
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			this->traverse_(tasks[i], R[i]);
+		}
+
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			result.insert(result.end(), R[i].begin(), R[i].end());
+		}
+		std::sort(result.begin(), result.end());
+	}
+
+private:
+	/**
+	 * @brief Pair of nodes to traverse.
+	 */
+	struct node_pair {
+		std::size_t a;
+		std::size_t b;
+	};
+
+	const mesh_type& a_;
+	const tree_type& X_;
+	const value_type tolerance_; ///< Makes the boxes touching, as of faces on one axis plane, overlap.
+
+private:
+	self_intersection_kernel(const self_intersection_kernel&);
+	self_intersection_kernel& operator=(const self_intersection_kernel&);
+
+	/**
+	 * @brief Pushes the children of a pair @a x to @a result, or @a x
+	 * itself if it is of leaves.
+	 * @return true if @a x is expanded.
+	 */
+	bool expand_(const node_pair& x, std::vector<node_pair>& result) const {
+		typedef typename tree_type::node node;
+
+		const node& u = this->X_.node_at(x.a);
+		const node& v = this->X_.node_at(x.b);
+		if (x.a == x.b) {
+			if (u.is_leaf()) {
+				result.push_back(x);
+				return false;
+			}
+			const node_pair p[] = { { u.first, u.first },
+					{ u.first + 1, u.first + 1 }, { u.first, u.first + 1 } };
+			for (std::size_t i = 0; i < 3; ++i) {
+				if (p[i].a == p[i].b
+						|| is_intersect(this->X_.node_at(p[i].a).box,
+								this->X_.node_at(p[i].b).box, this->tolerance_)) {
+					result.push_back(p[i]);
+				}
+			}
+			return true;
+		}
+
+		if (u.is_leaf() && v.is_leaf()) {
+			result.push_back(x);
+			return false;
+		}
+
+		// Splits the internal node of the larger box.
+		const bool split_a = !u.is_leaf()
+				&& (v.is_leaf()
+						|| !(volume_(u.box) < volume_(v.box)));
+		for (std::size_t i = 0; i < 2; ++i) {
+			const node_pair p = split_a ?
+					node_pair_(u.first + i, x.b) : node_pair_(x.a, v.first + i);
+			if (is_intersect(this->X_.node_at(p.a).box,
+					this->X_.node_at(p.b).box, this->tolerance_)) {
+				result.push_back(p);
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Traverses a pair @a x to the leaves and tests their faces.
+	 */
+	void traverse_(const node_pair& x, std::vector<face_pair>& result) const {
+		typedef typename tree_type::node node;
+
+		std::vector<node_pair> stack(1, x);
+		std::vector<node_pair> next;
+		while (!stack.empty()) {
+			const node_pair y = stack.back();
+			stack.pop_back();
+
+			const node& u = this->X_.node_at(y.a);
+			const node& v = this->X_.node_at(y.b);
+			if (!u.is_leaf() || !v.is_leaf()) {
+				next.clear();
+				this->expand_(y, next);
+				stack.insert(stack.end(), next.begin(), next.end());
+				continue;
+			}
+
+			for (std::size_t i = u.first; i < u.first + u.size; ++i) {
+				const std::size_t j_first = (y.a == y.b) ? i + 1 : v.first;
+				for (std::size_t j = j_first; j < v.first + v.size; ++j) {
+					if (is_intersect(this->X_.box(i), this->X_.box(j),
+							this->tolerance_)
+							&& this->intersect_(this->X_[i], this->X_[j])) {
+						result.push_back(
+								std::make_pair(std::min(this->X_[i], this->X_[j]),
+										std::max(this->X_[i], this->X_[j])));
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Tests two faces @a f and @a g. Faces sharing an edge are not
+	 * tested; faces sharing a vertex intersect if the edge of either
+	 * opposite to the vertex crosses the other.
+	 */
+	bool intersect_(index_type f, index_type g) const {
+		const std::size_t Size = mesh_type::VertexSize;
+
+		std::size_t shared = 0;
+		std::size_t kf = 0;
+		std::size_t kg = 0;
+		for (std::size_t i = 0; i < Size; ++i) {
+			for (std::size_t j = 0; j < Size; ++j) {
+				if (this->a_.index(f, i) == this->a_.index(g, j)) {
+					++shared;
+					kf = i;
+					kg = j;
+				}
+			}
+		}
+
+		if (shared == 0) {
+			const Vector x[] = { this->vertex_(f, 0), this->vertex_(f, 1),
+					this->vertex_(f, 2) };
+			const Vector y[] = { this->vertex_(g, 0), this->vertex_(g, 1),
+					this->vertex_(g, 2) };
+			triangle_overlap<Vector> overlap;
+			return alg::intersect_2triangles(x[0], x[1], x[2], y[0], y[1], y[2],
+					overlap);
+		}
+		if (shared == 1) {
+			return this->edge_crosses_(f, kf, g) || this->edge_crosses_(g, kg, f);
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Tests whether the edge of a face @a f opposite to its @a k th
+	 * vertex crosses a face @a g.
+	 */
+	bool edge_crosses_(index_type f, std::size_t k, index_type g) const {
+		const Vector p = this->vertex_(f, (k + 1) % mesh_type::VertexSize);
+		const Vector q = this->vertex_(f, (k + 2) % mesh_type::VertexSize);
+
+		triangle_hit<value_type> hit;
+		return alg::intersect_ray_triangle(p, Vector(q - p), this->vertex_(g, 0),
+				this->vertex_(g, 1), this->vertex_(g, 2),
+				value_type(GK_FLOAT_ZERO), value_type(GK_FLOAT_ONE), hit);
+	}
+
+	const Vector& vertex_(index_type f, std::size_t k) const {
+		return this->a_.vertex(this->a_.index(f, k));
+	}
+
+	static node_pair node_pair_(std::size_t a, std::size_t b) {
+		const node_pair x = { a, b };
+		return x;
+	}
+
+	static value_type volume_(const aabb<Vector>& box) {
+		const Vector d = box.max() - box.min();
+		value_type v = d[0];
+		for (std::size_t i = 1; i < vector_traits<Vector>::Dimension; ++i) {
+			v *= d[i];
+		}
+		return v;
+	}
+};
+
+}  // namespace impl
+
+/**
+ * @brief Finds the pairs of the faces of a mesh which intersect each other.
+ *
+ * Faces sharing an edge are not reported. Faces sharing a vertex are
+ * reported if they meet elsewhere, that is if the edge of either opposite
+ * to the vertex crosses the other. The other pairs are tested by
+ * alg::intersect_2triangles(), including those touching.
+ *
+ * @param a
+ * @param X The hierarchy of the faces made by face_tree().
+ * @param result The beginning of the pairs of the indices of the faces,
+ * the smaller first, in the ascending order.
+ * @return The end of the pairs.
+ */
+template<typename Vector, typename OutputIterator>
+OutputIterator self_intersections(const trimesh<Vector>& a,
+		const aabbtree<typename trimesh<Vector>::index_type, Vector>& X,
+		OutputIterator result) {
+	typedef impl::self_intersection_kernel<Vector> kernel_type;
+
+	std::vector<typename kernel_type::face_pair> P;
+	const kernel_type kernel(a, X);
+	kernel(P);
+	return std::copy(P.begin(), P.end(), result);
+}
+
+/**
+ * @brief Finds the pairs of the faces of a mesh which intersect each other.
+ *
+ * @param a
+ * @param result The beginning of the pairs of the indices of the faces.
+ * @return The end of the pairs.
+ *
+ * @see self_intersections(const trimesh<Vector>&, const aabbtree<typename trimesh<Vector>::index_type, Vector>&, OutputIterator)
+ */
+template<typename Vector, typename OutputIterator>
+OutputIterator self_intersections(const trimesh<Vector>& a,
+		OutputIterator result) {
+	return self_intersections(a, face_tree(a), result);
+}
+
+}  // namespace gk
+
+#endif /* MESH_SELF_INTERSECTIONS_H_ */
@@ -0,0 +1,380 @@
+/*
+ * trimesh.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef MESH_TRIMESH_H_
+#define MESH_TRIMESH_H_
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "../gkvector.h"
+#include "../gkaabb.h"
+#include "../primitive/triangle.h"
+#include "../vector/point_soa.h"
+#include "../algorithm/radix_sort.h"
+#include "../algorithm/aabbtree.h"
+
+namespace gk {
+
+/**
+ * @brief Triangle mesh of indexed vertices.
+ *
+ * The vertices are stored once in an array, and a face is three 32-bit
+ * indices of its vertices in the counterclockwise order. A face is made
+ * into a triangle on demand by face().
+ *
+ * The adjacency is built by build_adjacency() and discarded when a face is
+ * added. The half-edge @c 3f+k of a face @a f runs from its vertex @a k to
+ * the next one; opposite() pairs the half-edges of an edge shared by two
+ * faces, and incident_faces() returns the faces around a vertex.
+ *
+ * @tparam Vector Type of a vector in a linear space.
+ *
+ * @date 2026/10/18
+ */
+template<typename Vector>
+class trimesh {
+public:
+	static const std::size_t Dimension = vector_traits<Vector>::Dimension;
+	static const std::size_t VertexSize = 3; ///< The number of the vertices of a face.
+
+	typedef Vector vector_type;
+	typedef typename vector_traits<Vector>::value_type value_type;
+	typedef uint32_t index_type;
+	typedef triangle<Vector> triangle_type;
+	typedef aabb<Vector> box_type;
+
+	typedef std::vector<Vector> vertex_container_type;
+	typedef std::vector<index_type> index_container_type;
+	typedef typename vertex_container_type::const_iterator const_vertex_iterator;
+	typedef typename index_container_type::const_iterator const_index_iterator;
+
+	static const index_type NoIndex = 0xffffffff; ///< The index of no half-edge or face.
+
+public:
+	trimesh() :
+			X_(), F_(), O_(), S_(), R_() {
+	}
+
+	trimesh(const trimesh& other) :
+			X_(other.X_), F_(other.F_), O_(other.O_), S_(other.S_), R_(
+					other.R_) {
+	}
+
+	/**
+	 * @brief Constructs the mesh of vertices and the indices of faces.
+	 * @param vertex_first The beginning of the vertices.
+	 * @param vertex_last The end of the vertices.
+	 * @param index_first The beginning of the indices, three for each face.
+	 * @param index_last The end of the indices.
+	 */
+	template<typename VertexInputIterator, typename IndexInputIterator>
+	trimesh(VertexInputIterator vertex_first, VertexInputIterator vertex_last,
+			IndexInputIterator index_first, IndexInputIterator index_last) :
+			X_(vertex_first, vertex_last), F_(index_first, index_last), O_(), S_(), R_() {
+	}
+
+	~trimesh() {
+	}
+
+	bool empty() const {
+		return this->F_.empty();
+	}
+
+	/**
+	 * @brief Returns the number of the vertices.
+	 */
+	std::size_t vertex_size() const {
+		return this->X_.size();
+	}
+
+	/**
+	 * @brief Returns the number of the faces.
+	 */
+	std::size_t face_size() const {
+		return this->F_.size() / VertexSize;
+	}
+
+	const_vertex_iterator vertex_begin() const {
+		return this->X_.begin();
+	}
+
+	const_vertex_iterator vertex_end() const {
+		return this->X_.end();
+	}
+
+	/**
+	 * @brief Returns the beginning of the indices of the vertices of the
+	 * faces, three for each face.
+	 */
+	const_index_iterator index_begin() const {
+		return this->F_.begin();
+	}
+
+	const_index_iterator index_end() const {
+		return this->F_.end();
+	}
+
+	const vector_type& vertex(std::size_t n) const {
+		return this->X_[n];
+	}
+
+	/**
+	 * @brief Moves the @a n th vertex to @a v. The adjacency is kept.
+	 */
+	void vertex(std::size_t n, const vector_type& v) {
+		this->X_[n] = v;
+	}
+
+	/**
+	 * @brief Returns the index of the @a k th vertex of a face @a f.
+	 */
+	index_type index(std::size_t f, std::size_t k) const {
+		return this->F_[VertexSize * f + k];
+	}
+
+	/**
+	 * @brief Makes the triangle of a face @a f.
+	 */
+	triangle_type face(std::size_t f) const {
+		const index_type* const x = &this->F_[VertexSize * f];
+		return triangle_type(this->X_[x[0]], this->X_[x[1]], this->X_[x[2]]);
+	}
+
+	/**
+	 * @brief Computes the box enclosing a face @a f.
+	 */
+	box_type box(std::size_t f) const {
+		const index_type* const x = &this->F_[VertexSize * f];
+		const vector_type v[VertexSize] = { this->X_[x[0]], this->X_[x[1]],
+				this->X_[x[2]] };
+		return box_type(v, v + VertexSize);
+	}
+
+	/**
+	 * @brief Computes the boxes of all the faces, which are given to an
+	 * aabbtree of the indices of the faces.
+	 * @param result The beginning of the boxes.
+	 * @return The end of the boxes.
+	 */
+	template<typename OutputIterator>
+	OutputIterator boxes(OutputIterator result) const {
+		const std::size_t n = this->face_size();
+		for (std::size_t f = 0; f < n; ++f) {
+			*result = this->box(f);
+			++result;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Copies the vertices to the lanes of @a X.
+	 */
+	template<typename T>
+	void vertices(point_soa<T, Dimension>& X) const {
+		X.assign(this->X_.begin(), this->X_.end());
+	}
+
+	void reserve(std::size_t vertex_size, std::size_t face_size) {
+		this->X_.reserve(vertex_size);
+		this->F_.reserve(VertexSize * face_size);
+	}
+
+	/**
+	 * @brief Appends a vertex.
+	 * @return The index of the vertex.
+	 */
+	index_type add_vertex(const vector_type& v) {
+		this->X_.push_back(v);
+		return index_type(this->X_.size() - 1);
+	}
+
+	/**
+	 * @brief Appends a face of the vertices @a a, @a b and @a c, which
+	 * discards the adjacency.
+	 * @return The index of the face.
+	 */
+	index_type add_face(index_type a, index_type b, index_type c) {
+		this->F_.push_back(a);
+		this->F_.push_back(b);
+		this->F_.push_back(c);
+		this->clear_adjacency();
+		return index_type(this->face_size() - 1);
+	}
+
+	bool has_adjacency() const {
+		return !this->O_.empty() || this->F_.empty();
+	}
+
+	/**
+	 * @brief Builds the opposite half-edges and the faces around the
+	 * vertices in O(n).
+	 *
+	 * The half-edges are sorted on the keys of their undirected edges by
+	 * radix_sort(), so that those of an edge are adjacent. An edge of one
+	 * face is on the boundary, and an edge shared by more than two faces is
+	 * not manifold; neither has opposite half-edges.
+	 */
+	void build_adjacency() {
+		const std::ptrdiff_t m = this->F_.size();
+		const uint64_t n = this->X_.size();
+
+		std::size_t bits = 0;
+		while (bits < 64 && ((n * n - 1) >> bits) != 0) {
+			++bits;
+		}
+
+		std::vector<uint64_t> K(m);
+		std::vector<index_type> H(m);
+
+#ifdef GK_OPENMP
+#pragma omp parallel for schedule(static) if (m >= radix_sort_kernel_type::ParallelSize)
+#endif
+		for (std::ptrdiff_t h = 0; h < m; ++h) {
+			const uint64_t a = this->F_[h];
+			const uint64_t b = this->F_[next_(h)];
+			K[h] = (a < b) ? a * n + b : b * n + a;
+			H[h] = index_type(h);
+		}
+
+		radix_sort(K, H, bits);
+
+		this->O_.assign(m, index_type(NoIndex));
+		for (std::ptrdiff_t i = 0; i < m;) {
+			std::ptrdiff_t j = i + 1;
+			while (j < m && K[j] == K[i]) {
+				++j;
+			}
+			if (j - i == 2) {
+				this->O_[H[i]] = H[i + 1];
+				this->O_[H[i + 1]] = H[i];
+			}
+			i = j;
+		}
+
+		// The faces around the vertices by the counting sort.
+		this->S_.assign(n + 1, 0);
+		for (std::ptrdiff_t h = 0; h < m; ++h) {
+			++this->S_[this->F_[h] + 1];
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			this->S_[i + 1] += this->S_[i];
+		}
+		this->R_.resize(m);
+		std::vector<index_type> offset(this->S_.begin(), this->S_.end() - 1);
+		for (std::ptrdiff_t h = 0; h < m; ++h) {
+			this->R_[offset[this->F_[h]]++] = index_type(h / VertexSize);
+		}
+	}
+
+	void clear_adjacency() {
+		this->O_.clear();
+		this->S_.clear();
+		this->R_.clear();
+	}
+
+	/**
+	 * @brief Returns the half-edge opposite to a half-edge @a h, or NoIndex
+	 * if the edge is on the boundary or not manifold. Requires the
+	 * adjacency.
+	 */
+	index_type opposite(std::size_t h) const {
+		return this->O_[h];
+	}
+
+	/**
+	 * @brief Returns the face across the edge from the @a k th vertex of a
+	 * face @a f, or NoIndex. Requires the adjacency.
+	 */
+	index_type neighbor(std::size_t f, std::size_t k) const {
+		const index_type h = this->O_[VertexSize * f + k];
+		return (h == NoIndex) ? index_type(NoIndex) : index_type(h / VertexSize);
+	}
+
+	/**
+	 * @brief Returns the range of the faces around a vertex @a v in the
+	 * ascending order. Requires the adjacency.
+	 */
+	std::pair<const_index_iterator, const_index_iterator> incident_faces(
+			std::size_t v) const {
+		return std::make_pair(this->R_.begin() + this->S_[v],
+				this->R_.begin() + this->S_[v + 1]);
+	}
+
+	void swap(trimesh& other) {
+		this->X_.swap(other.X_);
+		this->F_.swap(other.F_);
+		this->O_.swap(other.O_);
+		this->S_.swap(other.S_);
+		this->R_.swap(other.R_);
+	}
+
+	trimesh& operator=(const trimesh& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->X_ = rhs.X_;
+		this->F_ = rhs.F_;
+		this->O_ = rhs.O_;
+		this->S_ = rhs.S_;
+		this->R_ = rhs.R_;
+		return *this;
+	}
+
+private:
+	typedef impl::radix_sort_kernel radix_sort_kernel_type;
+
+	vertex_container_type X_; ///< The vertices.
+	index_container_type F_; ///< The indices of the vertices of the faces.
+	index_container_type O_; ///< The opposite half-edges.
+	std::vector<std::size_t> S_; ///< The offsets of the faces around the vertices in @a R_.
+	index_container_type R_; ///< The faces around the vertices.
+
+private:
+	/**
+	 * @brief Returns the next half-edge of @a h in its face.
+	 */
+	static std::ptrdiff_t next_(std::ptrdiff_t h) {
+		return (h % VertexSize == VertexSize - 1) ? h - (VertexSize - 1) : h + 1;
+	}
+};
+
+/**
+ * @brief Computes the box enclosing the vertices of a mesh @a a, which is
+ * not empty.
+ */
+template<typename Vector>
+aabb<Vector> boundary(const trimesh<Vector>& a) {
+	return aabb<Vector>(a.vertex_begin(), a.vertex_end());
+}
+
+/**
+ * @brief Builds the hierarchy of the boxes of the faces of a mesh @a a,
+ * whose elements are the indices of the faces.
+ */
+template<typename Vector>
+aabbtree<typename trimesh<Vector>::index_type, Vector> face_tree(
+		const trimesh<Vector>& a) {
+	typedef typename trimesh<Vector>::index_type index_type;
+
+	std::vector<index_type> F(a.face_size());
+	for (std::size_t f = 0; f < F.size(); ++f) {
+		F[f] = index_type(f);
+	}
+	std::vector<aabb<Vector> > B;
+	B.reserve(F.size());
+	a.boxes(std::back_inserter(B));
+
+	return aabbtree<index_type, Vector>(F.begin(), F.end(), B.begin());
+}
+
+} // namespace gk
+
+#endif /* MESH_TRIMESH_H_ */
@@ -130,7 +130,7 @@ std::pair<typename vector_traits<Vector>::value_type,
 	const direction u = a.direction();
 	const direction n = b.normal();
 
-	const dot<direction, direction, gkfloat> dot_d;
+	const dot<direction, direction, float_type> dot_d;
 	if (dot_d(u, n) == GK_FLOAT_ZERO) {
 		// The line and the plane are parallel.
 
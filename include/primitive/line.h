@@ -13,6 +13,7 @@
 #include "../gkaabb.h"
 
 #include <vector>
+#include <algorithm>
 
 namespace gk {
 
@@ -64,7 +65,7 @@ public:
 	 * @param other An other object.
 	 */
 	line(const line& other) :
-			ref_(other.ref_), direction_(other) {
+			ref_(other.ref_), direction_(other.direction_) {
 
 	}
 
@@ -161,28 +162,32 @@ public:
 	typedef T value_type;
 	typedef typename vector_type<T, Dimension>::type vector_type;
 
+	typedef direction<Dimension> direction_type;
+
 public:
 	segment() :
-			edge_() {
+			edge_(), direction_(), length_(GK_FLOAT_ZERO) {
 	}
 
 	segment(const segment& other) :
-			edge_() {
+			edge_(), direction_(other.direction_), length_(other.length_) {
 		this->edge_[GK::StartEdge] = other.edge_[GK::StartEdge];
 		this->edge_[GK::EndEdge] = other.edge_[GK::EndEdge];
 	}
 
 	segment(const vector_type& start, const vector_type& end) :
-			edge_() {
+			edge_(), direction_(), length_(GK_FLOAT_ZERO) {
 		this->edge_[GK::StartEdge] = start;
 		this->edge_[GK::EndEdge] = end;
+		this->update_();
 	}
 
 	template<typename Vector>
 	segment(const Vector& start, const Vector& end) :
-			edge_() {
+			edge_(), direction_(), length_(GK_FLOAT_ZERO) {
 		assign(start, this->edge_[GK::StartEdge]);
 		assign(end, this->edge_[GK::EndEdge]);
+		this->update_();
 	}
 
 	~segment() {
@@ -190,6 +195,7 @@ public:
 
 	void inverse() {
 		std::swap(this->edge_[GK::StartEdge], this->edge_[GK::EndEdge]);
+		this->update_();
 	}
 
 	const vector_type& start() const {
@@ -198,6 +204,7 @@ public:
 
 	void start(const vector_type& start) {
 		this->edge_[GK::StartEdge] = start;
+		this->update_();
 	}
 
 	const vector_type& end() const {
@@ -206,14 +213,34 @@ public:
 
 	void end(const vector_type& end) {
 		this->edge_[GK::EndEdge] = end;
+		this->update_();
+	}
+
+	/**
+	 * @brief Returns the unit direction from the start to the end, which is
+	 * computed when an edge is set.
+	 */
+	const direction_type& dir() const {
+		return this->direction_;
+	}
+
+	/**
+	 * @brief Returns the length, which is computed when an edge is set.
+	 */
+	const value_type& length() const {
+		return this->length_;
 	}
 
 	const vector_type& operator[](std::size_t index) const {
 		return this->edge_[index];
 	}
 
-	vector_type& operator[](std::size_t index) {
-		return this->edge_[index];
+	/**
+	 * @brief Sets the edge of an @a index to @a v.
+	 */
+	void edge(std::size_t index, const vector_type& v) {
+		this->edge_[index] = v;
+		this->update_();
 	}
 
 	template<typename Parameter>
@@ -230,28 +257,42 @@ public:
 
 		this->edge_[GK::StartEdge] = rhs.edge_[GK::StartEdge];
 		this->edge_[GK::EndEdge] = rhs.edge_[GK::EndEdge];
+		this->direction_ = rhs.direction_;
+		this->length_ = rhs.length_;
 
 		return *this;
 	}
 
 private:
 	vector_type edge_[GK::EdgeSize];
+	direction_type direction_; ///< The cache of the direction.
+	value_type length_; ///< The cache of the length.
+
+private:
+	/**
+	 * @brief Computes the direction and the length from the edges.
+	 */
+	void update_() {
+		const vector_type v = this->edge_[GK::EndEdge]
+				- this->edge_[GK::StartEdge];
+		this->length_ = norm(v);
+		this->direction_ = direction_type(v);
+	}
 };
 
 template<typename T, std::size_t Dimension>
 direction<Dimension> direction_of(const line<T, Dimension>& l) {
-	return l.direction();
+	return l.dir();
 }
 
 template<typename T, std::size_t Dimension>
 direction<Dimension> direction_of(const segment<T, Dimension>& l) {
-	return direction_of(l[GK::StartEdge], l[GK::EndEdge]);
+	return l.dir();
 }
 
 template<typename T, std::size_t Dimension>
 T length(const segment<T, Dimension>& l) {
-	const typename segment<T, Dimension>::vector_type v = l.start() - l.end();
-	return norm(v);
+	return l.length();
 }
 
 template<typename T, std::size_t Dimension>
@@ -265,6 +306,19 @@ aabb<typename segment<T, Dimension>::vector_type> boundary(
 	return aabb<typename segment<T, Dimension>::vector_type>(x.start(), x.end());
 }
 
+/**
+ * @brief Polyline parameterized by its arc length, normalized to [0, 1].
+ *
+ * The cumulative lengths of the vertices are cached, and the modifiers
+ * update them at once: setting a vertex recomputes the lengths from it and
+ * appending a vertex adds one length. The vertices are only modified
+ * through vertex() and push_back(). The const members only read the cache,
+ * so a polyline can be evaluated from several threads.
+ *
+ * @tparam Vector Type of a vector.
+ *
+ * @date 2026/10/19
+ */
 template<typename Vector>
 class polyline/*: public curve<curve_tag, Vector>*/{
 public:
@@ -273,41 +327,24 @@ public:
 	typedef typename vector_traits<Vector>::value_type value_type;
 //	typedef Parameter parameter;
 
-	typedef typename container_type::iterator iterator;
 	typedef typename container_type::const_iterator const_iterator;
-	typedef typename container_type::reverse_iterator reverse_iterator;
 	typedef typename container_type::const_reverse_iterator const_reverse_iterator;
 
-private:
-	template<typename InputIterator, typename OutputIterator>
-	static OutputIterator lengths(InputIterator first, InputIterator last,
-			OutputIterator result) {
-
-		*result = vector_traits<Vector>::value_type(GK_FLOAT_ZERO);
-		++result;
-		while (first != last) {
-			*result = vector_traits<Vector>::norm(*first++ - *first);
-			++result;
-		}
-
-		return result;
-	}
-
 public:
 	polyline() :
-			X_() {
+			X_(), L_() {
 
 	}
 
 	polyline(const polyline& other) :
-			X_(other.X_) {
+			X_(other.X_), L_(other.L_) {
 
 	}
 
 	template<typename InputIterator>
 	polyline(InputIterator first, InputIterator last) :
-			X_(first, last) {
-
+			X_(first, last), L_() {
+		this->update_(0);
 	}
 
 	~polyline() {
@@ -318,11 +355,14 @@ public:
 		return this->X_.empty();
 	}
 
-	const_iterator begin() const {
-		return this->X_.begin();
+	/**
+	 * @brief Returns the number of the vertices.
+	 */
+	std::size_t size() const {
+		return this->X_.size();
 	}
 
-	iterator begin() {
+	const_iterator begin() const {
 		return this->X_.begin();
 	}
 
@@ -330,54 +370,152 @@ public:
 		return this->X_.end();
 	}
 
-	iterator end() {
-		return this->X_.end();
-	}
-
 	const_reverse_iterator rbegin() const {
 		return this->X_.rbegin();
 	}
 
-	reverse_iterator rbegin() {
-		return this->X_.rbegin();
-	}
-
 	const_reverse_iterator rend() const {
 		return this->X_.rend();
 	}
 
-	reverse_iterator rend() {
-		return this->X_.rend();
+	/**
+	 * @brief Sets the vertex of an @a index to @a v.
+	 */
+	void vertex(std::size_t index, const vector_type& v) {
+		this->X_[index] = v;
+		this->update_(index);
 	}
 
+	/**
+	 * @brief Appends a vertex @a v, keeping the cached lengths.
+	 */
+	void push_back(const vector_type& v) {
+		this->X_.push_back(v);
+		this->update_(this->X_.size() - 1);
+	}
+
+	/**
+	 * @brief Returns the length of the polyline.
+	 */
+	value_type length() const {
+		return this->L_.empty() ? value_type(GK_FLOAT_ZERO) : this->L_.back();
+	}
+
+	/**
+	 * @brief Subdivides this at a parameter @a t in [0, 1].
+	 *
+	 * @param t Parameter to subdivide.
+	 * @param select GK::Upper to keep the lower part in this, GK::Lower to
+	 * keep the upper part.
+	 *
+	 * @return The other part, or an empty polyline if @a t is out of
+	 * [0, 1]. The part before 0 or after 1 is empty.
+	 */
 	template<typename Parameter>
 	polyline subdivide(const Parameter& t, gkselection select = GK::Upper) {
+		if (t < Parameter(GK_FLOAT_ZERO) || t > Parameter(GK_FLOAT_ONE)
+				|| this->X_.size() < 2) {
+			return polyline();
+		}
 
+		const value_type p = value_type(t) * this->L_.back();
+		polyline lower;
+		polyline upper;
+		if (!(p > value_type(GK_FLOAT_ZERO))) {
+			upper = *this;
+		} else if (!(p < this->L_.back())) {
+			lower = *this;
+		} else {
+			const std::size_t n = this->find_(p);
+			const vector_type x = this->position_(n, p);
+
+			// The vertices from the first to n, and from n + 1 to the last.
+			const_iterator middle = this->X_.begin() + (n + 1);
+			lower.X_.assign(this->begin(), middle);
+			upper.X_.assign(middle, this->end());
+			if (p > this->L_[n]) {
+				lower.X_.push_back(x);
+			}
+			if (p < this->L_[n + 1] || !(p > this->L_[n])) {
+				upper.X_.insert(upper.X_.begin(), x);
+			}
+			lower.update_(0);
+			upper.update_(0);
+		}
+
+		if (select == GK::Upper) {
+			this->swap(lower);
+			return upper;
+		} else {
+			this->swap(upper);
+			return lower;
+		}
 	}
 
-	const vector_type& operator[](size_t index) const {
-		return this->X_[index];
+	void swap(polyline& other) {
+		this->X_.swap(other.X_);
+		this->L_.swap(other.L_);
 	}
 
-	vector_type& operator[](size_t index) {
+	const vector_type& operator[](size_t index) const {
 		return this->X_[index];
 	}
 
+	/**
+	 * @brief Evaluates the position at a parameter @a t in [0, 1], the
+	 * ratio of the arc length from the start to the length, in
+	 * @f$O(\log n)@f$.
+	 */
 	template<typename Parameter>
 	vector_type operator()(const Parameter& t) const {
-		std::vector<value_type> L;
-		L.reserve(this->X_.size());
+		if (this->X_.size() < 2) {
+			return this->X_.front();
+		}
 
-		lengths(this->X_.begin(), this->X_.end(), std::inserter(L, L.begin()));
+		const value_type p = value_type(t) * this->L_.back();
+		return this->position_(this->find_(p), p);
+	}
 
-		const value_type p = t * L.back();
-		typename std::vector<value_type>::iterator bound = std::upper_bound(
-				L.begin(), L.end(), p);
+	/**
+	 * @brief Evaluates the positions at parameters in [first, last).
+	 *
+	 * The segments are walked forward from the last one found, so that
+	 * non-decreasing parameters cost @f$O(n + m)@f$ for @a m parameters;
+	 * a parameter smaller than the previous one is searched again.
+	 *
+	 * @param first The beginning of the parameters, preferably in
+	 * non-decreasing order.
+	 * @param last The end of the parameters.
+	 * @param result The beginning of the positions.
+	 * @return The end of the positions.
+	 */
+	template<typename InputIterator, typename OutputIterator>
+	OutputIterator operator()(InputIterator first, InputIterator last,
+			OutputIterator result) const {
+		if (this->X_.size() < 2) {
+			for (; first != last; ++first) {
+				*result = this->X_.front();
+				++result;
+			}
+			return result;
+		}
 
-		const size_t n = std::distance(L.begin(), bound);
-		const Parameter u = (*bound - p) / L.back();
+		const std::size_t m = this->X_.size() - 2;
+		std::size_t n = 0;
+		for (; first != last; ++first) {
+			const value_type p = value_type(*first) * this->L_.back();
+			if (p < this->L_[n]) {
+				n = this->find_(p);
+			}
+			while (n < m && !(p < this->L_[n + 1])) {
+				++n;
+			}
+
+			*result = this->position_(n, p);
+			++result;
+		}
 
-		return (Parameter(GK_FLOAT_ONE) - u) * this->X_[n - 1] + u * this->X_[n];
+		return result;
 	}
 
 	polyline& operator=(const polyline& rhs) {
@@ -386,11 +524,58 @@ public:
 		}
 
 		this->X_ = rhs.X_;
+		this->L_ = rhs.L_;
 		return *this;
 	}
 
 private:
 	container_type X_;
+	std::vector<value_type> L_; ///< The cumulative lengths of the vertices.
+
+private:
+	/**
+	 * @brief Recomputes the cumulative lengths from a vertex @a i.
+	 */
+	void update_(std::size_t i) {
+		this->L_.resize(this->X_.size());
+		if (this->X_.empty()) {
+			return;
+		}
+
+		if (i == 0) {
+			this->L_[0] = value_type(GK_FLOAT_ZERO);
+			++i;
+		}
+		for (; i < this->X_.size(); ++i) {
+			const vector_type v = this->X_[i] - this->X_[i - 1];
+			this->L_[i] = this->L_[i - 1] + norm(v);
+		}
+	}
+
+	/**
+	 * @brief Returns the index of the segment containing an arc length
+	 * @a p, clamped to the segments.
+	 */
+	std::size_t find_(const value_type& p) const {
+		const std::size_t n = std::upper_bound(this->L_.begin(),
+				this->L_.end(), p) - this->L_.begin();
+		return std::min(std::max(n, std::size_t(1)), this->X_.size() - 1) - 1;
+	}
+
+	/**
+	 * @brief Returns the position at an arc length @a p on a segment @a n.
+	 */
+	vector_type position_(std::size_t n, const value_type& p) const {
+		const value_type w = this->L_[n + 1] - this->L_[n];
+		if (!(w > value_type(GK_FLOAT_ZERO))) {
+			return this->X_[n];
+		}
+
+		const value_type u = std::min(
+				std::max((p - this->L_[n]) / w, value_type(GK_FLOAT_ZERO)),
+				value_type(GK_FLOAT_ONE));
+		return this->X_[n] + u * (this->X_[n + 1] - this->X_[n]);
+	}
 };
 
 }
@@ -10,6 +10,8 @@
 
 #include "../gkvector.h"
 
+#include <cmath>
+
 namespace gk {
 
 struct triangle_tag: public plane_tag {
@@ -44,6 +46,14 @@ public:
 		std::copy(other.x_, other.x_ + ElementSize, this->x_);
 	}
 
+	triangle(const vector_type& first, const vector_type& second,
+			const vector_type& third) :
+			x_() {
+		this->x_[First] = first;
+		this->x_[Second] = second;
+		this->x_[Third] = third;
+	}
+
 	~triangle() {
 	}
 
@@ -135,10 +145,15 @@ namespace impl {
 template<typename Vector, typename AreaValue>
 AreaValue area_of_triangle(const Vector& first, const Vector& second,
 		const Vector& third, dimension_tag<GK::GK_2D>) {
-
+	const AreaValue u[] = { AreaValue(second[GK::X] - first[GK::X]), AreaValue(
+			second[GK::Y] - first[GK::Y]) };
+	const AreaValue v[] = { AreaValue(third[GK::X] - first[GK::X]), AreaValue(
+			third[GK::Y] - first[GK::Y]) };
+	return AreaValue(0.5) * std::abs(u[GK::X] * v[GK::Y] - u[GK::Y] * v[GK::X]);
 }
 
 /**
+ * @brief Calculates the area of the triangle made by three points in 3D.
  *
  * @param first
  * @param second
@@ -149,7 +164,8 @@ AreaValue area_of_triangle(const Vector& first, const Vector& second,
 template<typename Vector, typename AreaValue>
 AreaValue area_of_triangle(const Vector& first, const Vector& second,
 		const Vector& third, dimension_tag<GK::GK_3D>) {
-
+	const Vector w = cross<Vector>()(second - first, third - first);
+	return AreaValue(0.5) * AreaValue(std::sqrt(dot(w, w)));
 }
 
 }  // namespace inner
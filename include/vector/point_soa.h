@@ -0,0 +1,236 @@
+/*
+ * point_soa.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef VECTOR_POINT_SOA_H_
+#define VECTOR_POINT_SOA_H_
+
+#include "../gkvector.h"
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace gk {
+
+/**
+ * @brief Container of positions as a structure of arrays; one array of
+ * the components, a lane, for each axis.
+ *
+ * Each lane begins at a boundary of Alignment bytes and is padded with
+ * zeros to a multiple of Padding components, so that a kernel can run over
+ * whole SIMD registers of a lane without a remainder loop.
+ *
+ * @tparam T Type of a component.
+ * @tparam DimensionSize Dimension of the space.
+ *
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t DimensionSize>
+class point_soa {
+public:
+	static const std::size_t Dimension = DimensionSize;
+	static const std::size_t Alignment = 64; ///< The alignment of a lane in bytes.
+	static const std::size_t Padding = Alignment / sizeof(T); ///< The lanes are padded to a multiple of this.
+
+	typedef T value_type;
+	typedef typename gk::vector_type<T, DimensionSize>::type vector_type;
+
+public:
+	point_soa() :
+			B_(), X_(0), n_(0), stride_(0) {
+	}
+
+	point_soa(const point_soa& other) :
+			B_(), X_(0), n_(0), stride_(0) {
+		this->resize(other.n_);
+		this->copy_lanes_(other);
+	}
+
+	/**
+	 * @brief Constructs @a n positions at the origin.
+	 */
+	explicit point_soa(std::size_t n) :
+			B_(), X_(0), n_(0), stride_(0) {
+		this->resize(n);
+	}
+
+	/**
+	 * @brief Constructs from the positions in [first, last).
+	 */
+	template<typename ForwardIterator>
+	point_soa(ForwardIterator first, ForwardIterator last) :
+			B_(), X_(0), n_(0), stride_(0) {
+		this->assign(first, last);
+	}
+
+	~point_soa() {
+	}
+
+	bool empty() const {
+		return this->n_ == 0;
+	}
+
+	/**
+	 * @brief Returns the number of the positions.
+	 */
+	std::size_t size() const {
+		return this->n_;
+	}
+
+	/**
+	 * @brief Returns the number of the components in a lane, including the
+	 * padding.
+	 */
+	std::size_t stride() const {
+		return this->stride_;
+	}
+
+	/**
+	 * @brief Returns the lane of an axis @a d.
+	 */
+	const T* lane(std::size_t d) const {
+		return this->X_ + d * this->stride_;
+	}
+
+	T* lane(std::size_t d) {
+		return this->X_ + d * this->stride_;
+	}
+
+	/**
+	 * @brief Resizes to @a n positions; the positions added are at the
+	 * origin.
+	 */
+	void resize(std::size_t n) {
+		const std::size_t stride = (n + Padding - 1) / Padding * Padding;
+		if (stride > this->stride_) {
+			point_soa other;
+			other.allocate_(stride);
+			other.n_ = n;
+			for (std::size_t d = 0; d < Dimension; ++d) {
+				std::copy(this->lane(d), this->lane(d) + this->n_,
+						other.lane(d));
+			}
+			this->swap(other);
+			return;
+		}
+
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			std::fill(this->lane(d) + std::min(n, this->n_),
+					this->lane(d) + this->stride_, T(GK_FLOAT_ZERO));
+		}
+		this->n_ = n;
+	}
+
+	/**
+	 * @brief Replaces the positions by those in [first, last).
+	 */
+	template<typename ForwardIterator>
+	void assign(ForwardIterator first, ForwardIterator last) {
+		this->resize(0);
+		this->resize(std::distance(first, last));
+		for (std::size_t i = 0; first != last; ++first, ++i) {
+			this->set(i, *first);
+		}
+	}
+
+	void push_back(const vector_type& v) {
+		const std::size_t n = this->n_;
+		if (n == this->stride_) {
+			point_soa other;
+			other.allocate_(std::max(2 * this->stride_, Padding));
+			other.n_ = n;
+			for (std::size_t d = 0; d < Dimension; ++d) {
+				std::copy(this->lane(d), this->lane(d) + n, other.lane(d));
+			}
+			this->swap(other);
+		}
+
+		this->set(n, v);
+		++this->n_;
+	}
+
+	/**
+	 * @brief Sets the @a n th position to @a v.
+	 */
+	template<typename Vector>
+	void set(std::size_t n, const Vector& v) {
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			this->lane(d)[n] = v[d];
+		}
+	}
+
+	/**
+	 * @brief Copies the positions to @a result as vectors.
+	 * @return The end of the vectors.
+	 */
+	template<typename OutputIterator>
+	OutputIterator copy(OutputIterator result) const {
+		for (std::size_t i = 0; i < this->n_; ++i) {
+			*result = this->operator[](i);
+			++result;
+		}
+		return result;
+	}
+
+	void swap(point_soa& other) {
+		this->B_.swap(other.B_);
+		std::swap(this->X_, other.X_);
+		std::swap(this->n_, other.n_);
+		std::swap(this->stride_, other.stride_);
+	}
+
+	/**
+	 * @brief Gathers the @a n th position.
+	 */
+	vector_type operator[](std::size_t n) const {
+		vector_type v;
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			v[d] = this->lane(d)[n];
+		}
+		return v;
+	}
+
+	point_soa& operator=(const point_soa& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		this->resize(rhs.n_);
+		this->copy_lanes_(rhs);
+		return *this;
+	}
+
+private:
+	std::vector<T> B_; ///< The buffer holding the aligned lanes.
+	T* X_; ///< The beginning of the first lane in @a B_.
+	std::size_t n_;
+	std::size_t stride_;
+
+private:
+	/**
+	 * @brief Allocates zero lanes of @a stride components in this, which
+	 * is empty.
+	 */
+	void allocate_(std::size_t stride) {
+		this->B_.assign(stride * Dimension + Padding, T(GK_FLOAT_ZERO));
+
+		const std::size_t address = reinterpret_cast<std::size_t>(&this->B_[0]);
+		const std::size_t offset = (Alignment - address % Alignment) % Alignment;
+		this->X_ = &this->B_[0] + offset / sizeof(T);
+		this->stride_ = stride;
+	}
+
+	void copy_lanes_(const point_soa& other) {
+		for (std::size_t d = 0; d < Dimension; ++d) {
+			std::copy(other.lane(d), other.lane(d) + other.n_, this->lane(d));
+		}
+	}
+};
+
+} // namespace gk
+
+#endif /* VECTOR_POINT_SOA_H_ */
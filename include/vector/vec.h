@@ -0,0 +1,593 @@
+/*
+ * vec.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: makitaku
+ */
+
+#ifndef VECTOR_VEC_H_
+#define VECTOR_VEC_H_
+
+#include "../gkdef.h"
+
+#include <cmath>
+#include <ostream>
+#include <iterator>
+#include <algorithm>
+
+#if defined(GK_AVX)
+#	include <immintrin.h>
+#elif defined(GK_SSE2)
+#	include <emmintrin.h>
+#endif
+
+namespace gk {
+
+template<typename Vector>
+struct vector_traits;
+
+template<typename Vector1, typename Vector2, typename Result>
+struct cross;
+
+namespace impl {
+
+/**
+ * @brief Number of the stored components of a vector of @a N dimensions;
+ * a 3D vector is padded to 4 components to fill a SIMD register.
+ */
+template<std::size_t N>
+struct vec_storage {
+	static const std::size_t Size = N;
+};
+
+template<>
+struct vec_storage<GK::GK_3D> {
+	static const std::size_t Size = 4;
+};
+
+/**
+ * @brief Component-wise operations over the stored components of vectors,
+ * whose padding is zero.
+ *
+ * @tparam T Type of a component.
+ * @tparam Size The number of the stored components.
+ *
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t Size>
+struct vec_kernel {
+	static void add(const T* a, const T* b, T* r) {
+		for (std::size_t i = 0; i < Size; ++i) {
+			r[i] = a[i] + b[i];
+		}
+	}
+
+	static void subtract(const T* a, const T* b, T* r) {
+		for (std::size_t i = 0; i < Size; ++i) {
+			r[i] = a[i] - b[i];
+		}
+	}
+
+	static void multiply(const T* a, T s, T* r) {
+		for (std::size_t i = 0; i < Size; ++i) {
+			r[i] = a[i] * s;
+		}
+	}
+
+	static T dot(const T* a, const T* b) {
+		T r = T(GK_FLOAT_ZERO);
+		for (std::size_t i = 0; i < Size; ++i) {
+			r += a[i] * b[i];
+		}
+		return r;
+	}
+
+	static void min(const T* a, const T* b, T* r) {
+		for (std::size_t i = 0; i < Size; ++i) {
+			r[i] = std::min(a[i], b[i]);
+		}
+	}
+
+	static void max(const T* a, const T* b, T* r) {
+		for (std::size_t i = 0; i < Size; ++i) {
+			r[i] = std::max(a[i], b[i]);
+		}
+	}
+
+	static void cross(const T* a, const T* b, T* r) {
+		const T x = a[GK::Y] * b[GK::Z] - a[GK::Z] * b[GK::Y];
+		const T y = a[GK::Z] * b[GK::X] - a[GK::X] * b[GK::Z];
+		const T z = a[GK::X] * b[GK::Y] - a[GK::Y] * b[GK::X];
+		r[GK::X] = x;
+		r[GK::Y] = y;
+		r[GK::Z] = z;
+	}
+};
+
+#if defined(GK_SSE2)
+
+/**
+ * @brief SSE operations over 4 floats.
+ */
+template<>
+struct vec_kernel<float, 4> {
+	static void add(const float* a, const float* b, float* r) {
+		_mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void subtract(const float* a, const float* b, float* r) {
+		_mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void multiply(const float* a, float s, float* r) {
+		_mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+	}
+
+	static float dot(const float* a, const float* b) {
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+		x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+		x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(x);
+	}
+
+	static void min(const float* a, const float* b, float* r) {
+		_mm_storeu_ps(r, _mm_min_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void max(const float* a, const float* b, float* r) {
+		_mm_storeu_ps(r, _mm_max_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	/**
+	 * @brief Computes @f$\mathbf{a}_{yzx}\mathbf{b}_{zxy} -
+	 * \mathbf{a}_{zxy}\mathbf{b}_{yzx}@f$, which keeps the padding zero.
+	 */
+	static void cross(const float* a, const float* b, float* r) {
+		const __m128 u = _mm_loadu_ps(a);
+		const __m128 v = _mm_loadu_ps(b);
+		const __m128 u1 = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 v1 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 u2 = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 v2 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+		_mm_storeu_ps(r, _mm_sub_ps(_mm_mul_ps(u1, v1), _mm_mul_ps(u2, v2)));
+	}
+};
+
+/**
+ * @brief SSE2 operations over 2 doubles.
+ */
+template<>
+struct vec_kernel<double, 2> {
+	static void add(const double* a, const double* b, double* r) {
+		_mm_storeu_pd(r, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+	}
+
+	static void subtract(const double* a, const double* b, double* r) {
+		_mm_storeu_pd(r, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+	}
+
+	static void multiply(const double* a, double s, double* r) {
+		_mm_storeu_pd(r, _mm_mul_pd(_mm_loadu_pd(a), _mm_set1_pd(s)));
+	}
+
+	static double dot(const double* a, const double* b) {
+		const __m128d x = _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b));
+		return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+	}
+
+	static void min(const double* a, const double* b, double* r) {
+		_mm_storeu_pd(r, _mm_min_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+	}
+
+	static void max(const double* a, const double* b, double* r) {
+		_mm_storeu_pd(r, _mm_max_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+	}
+};
+
+/**
+ * @brief Operations over 4 doubles, by AVX or by pairs of SSE2 registers.
+ *
+ * The cross product stays scalar. Rotating the components (x, y, z) to
+ * (y, z, x) crosses the 128 bit lanes, which takes vperm2f128 and a
+ * shuffle for each operand without AVX2, and those permutations cost more
+ * than the six scalar products of a single 3D cross product.
+ */
+template<>
+struct vec_kernel<double, 4> {
+#if defined(GK_AVX)
+	static void add(const double* a, const double* b, double* r) {
+		_mm256_storeu_pd(r, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+	}
+
+	static void subtract(const double* a, const double* b, double* r) {
+		_mm256_storeu_pd(r, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+	}
+
+	static void multiply(const double* a, double s, double* r) {
+		_mm256_storeu_pd(r, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+	}
+
+	static double dot(const double* a, const double* b) {
+		const __m256d x = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+		const __m128d y = _mm_add_pd(_mm256_castpd256_pd128(x),
+				_mm256_extractf128_pd(x, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(y, _mm_unpackhi_pd(y, y)));
+	}
+
+	static void min(const double* a, const double* b, double* r) {
+		_mm256_storeu_pd(r, _mm256_min_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+	}
+
+	static void max(const double* a, const double* b, double* r) {
+		_mm256_storeu_pd(r, _mm256_max_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+	}
+#else
+	typedef vec_kernel<double, 2> half_type;
+
+	static void add(const double* a, const double* b, double* r) {
+		half_type::add(a, b, r);
+		half_type::add(a + 2, b + 2, r + 2);
+	}
+
+	static void subtract(const double* a, const double* b, double* r) {
+		half_type::subtract(a, b, r);
+		half_type::subtract(a + 2, b + 2, r + 2);
+	}
+
+	static void multiply(const double* a, double s, double* r) {
+		half_type::multiply(a, s, r);
+		half_type::multiply(a + 2, s, r + 2);
+	}
+
+	static double dot(const double* a, const double* b) {
+		const __m128d x = _mm_add_pd(
+				_mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)),
+				_mm_mul_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+		return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+	}
+
+	static void min(const double* a, const double* b, double* r) {
+		half_type::min(a, b, r);
+		half_type::min(a + 2, b + 2, r + 2);
+	}
+
+	static void max(const double* a, const double* b, double* r) {
+		half_type::max(a, b, r);
+		half_type::max(a + 2, b + 2, r + 2);
+	}
+#endif
+
+	static void cross(const double* a, const double* b, double* r) {
+		vec_kernel<double, 3>::cross(a, b, r);
+	}
+};
+
+#endif
+
+} // namespace impl
+
+/**
+ * @brief Fixed-size vector in a linear space, which does not depend on
+ * Eigen.
+ *
+ * The components are padded to the width of a SIMD register, with zeros,
+ * so that the operations run on SSE or AVX registers when GK_SSE2 or
+ * GK_AVX is defined by gkconfig.h. The storage is not over-aligned, so
+ * that the vectors can be held in standard containers.
+ *
+ * @tparam T Type of a component.
+ * @tparam N Dimension of the space.
+ *
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t N>
+class vec {
+public:
+	typedef T value_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+	typedef std::reverse_iterator<iterator> reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	static const std::size_t Dimension = N;
+	static const std::size_t Size = impl::vec_storage<N>::Size; ///< The number of the stored components.
+
+	typedef impl::vec_kernel<T, Size> kernel_type;
+
+public:
+	/**
+	 * @brief Constructs a zero vector.
+	 */
+	vec() :
+			x_() {
+		std::fill(this->x_, this->x_ + Size, T(GK_FLOAT_ZERO));
+	}
+
+	vec(const vec& other) :
+			x_() {
+		std::copy(other.x_, other.x_ + Size, this->x_);
+	}
+
+	vec(const T& x, const T& y) :
+			x_() {
+		std::fill(this->x_, this->x_ + Size, T(GK_FLOAT_ZERO));
+		this->x_[GK::X] = x;
+		this->x_[GK::Y] = y;
+	}
+
+	vec(const T& x, const T& y, const T& z) :
+			x_() {
+		std::fill(this->x_, this->x_ + Size, T(GK_FLOAT_ZERO));
+		this->x_[GK::X] = x;
+		this->x_[GK::Y] = y;
+		this->x_[GK::Z] = z;
+	}
+
+	/**
+	 * @brief Constructs from a vector of an other type, or an array of the
+	 * components.
+	 */
+	template<typename Vector>
+	explicit vec(const Vector& v) :
+			x_() {
+		std::fill(this->x_, this->x_ + Size, T(GK_FLOAT_ZERO));
+		for (std::size_t i = 0; i < N; ++i) {
+			this->x_[i] = v[i];
+		}
+	}
+
+	~vec() {
+	}
+
+	const_iterator begin() const {
+		return this->x_;
+	}
+
+	iterator begin() {
+		return this->x_;
+	}
+
+	const_iterator end() const {
+		return this->x_ + N;
+	}
+
+	iterator end() {
+		return this->x_ + N;
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(this->end());
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(this->end());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(this->begin());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(this->begin());
+	}
+
+	/**
+	 * @brief Returns the stored components, including the padding.
+	 */
+	const T* data() const {
+		return this->x_;
+	}
+
+	T* data() {
+		return this->x_;
+	}
+
+	const T& operator[](std::size_t n) const {
+		return this->x_[n];
+	}
+
+	T& operator[](std::size_t n) {
+		return this->x_[n];
+	}
+
+	vec& operator=(const vec& rhs) {
+		if (&rhs == this) {
+			return *this;
+		}
+
+		std::copy(rhs.x_, rhs.x_ + Size, this->x_);
+		return *this;
+	}
+
+	vec& operator+=(const vec& rhs) {
+		kernel_type::add(this->x_, rhs.x_, this->x_);
+		return *this;
+	}
+
+	vec& operator-=(const vec& rhs) {
+		kernel_type::subtract(this->x_, rhs.x_, this->x_);
+		return *this;
+	}
+
+	vec& operator*=(const T& rhs) {
+		kernel_type::multiply(this->x_, rhs, this->x_);
+		return *this;
+	}
+
+	vec& operator/=(const T& rhs) {
+		kernel_type::multiply(this->x_, T(GK_FLOAT_ONE) / rhs, this->x_);
+		return *this;
+	}
+
+private:
+	T x_[Size];
+};
+
+/**
+ * @brief Traits of a built-in vector.
+ * @date 2026/10/18
+ */
+template<typename T, std::size_t N>
+struct vector_traits<vec<T, N> > {
+	typedef T value_type; ///< Type of elements in a vector.
+
+	static const std::size_t Dimension = N; ///< A dimension size of a vector space.
+	static const bool IsHomogeneous = false;
+
+	typedef typename vec<T, N>::iterator iterator;
+	typedef typename vec<T, N>::const_iterator const_iterator;
+	typedef typename vec<T, N>::reverse_iterator reverse_iterator;
+	typedef typename vec<T, N>::const_reverse_iterator const_reverse_iterator;
+
+	static const_iterator begin(const vec<T, N>& v) {
+		return v.begin();
+	}
+
+	static iterator begin(vec<T, N>& v) {
+		return v.begin();
+	}
+
+	static const_iterator end(const vec<T, N>& v) {
+		return v.end();
+	}
+
+	static iterator end(vec<T, N>& v) {
+		return v.end();
+	}
+
+	static const_reverse_iterator rbegin(const vec<T, N>& v) {
+		return v.rbegin();
+	}
+
+	static reverse_iterator rbegin(vec<T, N>& v) {
+		return v.rbegin();
+	}
+
+	static const_reverse_iterator rend(const vec<T, N>& v) {
+		return v.rend();
+	}
+
+	static reverse_iterator rend(vec<T, N>& v) {
+		return v.rend();
+	}
+};
+
+template<typename T, std::size_t N>
+vec<T, N> operator+(const vec<T, N>& u, const vec<T, N>& v) {
+	vec<T, N> r = u;
+	r += v;
+	return r;
+}
+
+template<typename T, std::size_t N>
+vec<T, N> operator-(const vec<T, N>& u, const vec<T, N>& v) {
+	vec<T, N> r = u;
+	r -= v;
+	return r;
+}
+
+template<typename T, std::size_t N>
+vec<T, N> operator-(const vec<T, N>& v) {
+	vec<T, N> r;
+	r -= v;
+	return r;
+}
+
+template<typename T, std::size_t N>
+vec<T, N> operator*(const vec<T, N>& v, const T& s) {
+	vec<T, N> r = v;
+	r *= s;
+	return r;
+}
+
+template<typename T, std::size_t N>
+vec<T, N> operator*(const T& s, const vec<T, N>& v) {
+	return v * s;
+}
+
+template<typename T, std::size_t N>
+vec<T, N> operator/(const vec<T, N>& v, const T& s) {
+	vec<T, N> r = v;
+	r /= s;
+	return r;
+}
+
+template<typename T, std::size_t N>
+bool operator==(const vec<T, N>& u, const vec<T, N>& v) {
+	return std::equal(u.begin(), u.end(), v.begin());
+}
+
+template<typename T, std::size_t N>
+bool operator!=(const vec<T, N>& u, const vec<T, N>& v) {
+	return !(u == v);
+}
+
+template<typename T, std::size_t N>
+T dot(const vec<T, N>& u, const vec<T, N>& v) {
+	return vec<T, N>::kernel_type::dot(u.data(), v.data());
+}
+
+/**
+ * @brief Computes the component-wise minimum of @a u and @a v.
+ */
+template<typename T, std::size_t N>
+vec<T, N> min(const vec<T, N>& u, const vec<T, N>& v) {
+	vec<T, N> r;
+	vec<T, N>::kernel_type::min(u.data(), v.data(), r.data());
+	return r;
+}
+
+/**
+ * @brief Computes the component-wise maximum of @a u and @a v.
+ */
+template<typename T, std::size_t N>
+vec<T, N> max(const vec<T, N>& u, const vec<T, N>& v) {
+	vec<T, N> r;
+	vec<T, N>::kernel_type::max(u.data(), v.data(), r.data());
+	return r;
+}
+
+/**
+ * @brief Computes the unit vector of @a v, which keeps the type of @a v
+ * unlike normalize().
+ */
+template<typename T, std::size_t N>
+vec<T, N> normalized(const vec<T, N>& v) {
+	vec<T, N> r;
+	vec<T, N>::kernel_type::multiply(v.data(),
+			T(GK_FLOAT_ONE) / std::sqrt(dot(v, v)), r.data());
+	return r;
+}
+
+/**
+ * @brief Cross product of 3D built-in vectors.
+ */
+template<typename T>
+struct cross<vec<T, GK::GK_3D>, vec<T, GK::GK_3D>, vec<T, GK::GK_3D> > {
+	typedef vec<T, GK::GK_3D> first_argument_type;
+	typedef vec<T, GK::GK_3D> second_argument_type;
+	typedef vec<T, GK::GK_3D> result_type;
+
+	result_type operator()(const first_argument_type& u,
+			const second_argument_type& v) const {
+		result_type r;
+		result_type::kernel_type::cross(u.data(), v.data(), r.data());
+		return r;
+	}
+};
+
+template<typename CharT, typename Traits, typename T, std::size_t N>
+std::basic_ostream<CharT, Traits>& operator<<(
+		std::basic_ostream<CharT, Traits>& os, const vec<T, N>& v) {
+	const std::streamsize n = os.width();
+	for (typename vec<T, N>::const_iterator p = v.begin(); p != v.end(); ++p) {
+		os.width(n);
+		os << *p;
+	}
+
+	return os;
+}
+
+} // namespace gk
+
+#endif /* VECTOR_VEC_H_ */